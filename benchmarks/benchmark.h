@@ -0,0 +1,44 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstdio>
+
+namespace benchmark
+{
+
+// Runs func repeat times and returns the fastest run in seconds.
+template <class Func>
+double best_of(int repeat, Func func)
+{
+	double best = 0;
+
+	for (int i = 0; i < repeat; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		func();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (i == 0 || elapsed.count() < best)
+			best = elapsed.count();
+	}
+
+	return best;
+}
+
+// Keeps the compiler from optimizing away the computation of value.
+template <class T>
+void keep(const T& value)
+{
+	asm volatile("" : : "r"(&value) : "memory");
+}
+
+inline void report(const char* name, double seconds, double operations)
+{
+	std::printf("%-44s %10.3f ms %10.2f ns/op\n", name, seconds * 1e3,
+				seconds * 1e9 / operations);
+}
+
+} // namespace benchmark
+
+#endif // BENCHMARK_H
@@ -0,0 +1,59 @@
+#include "../src/forward_list.h"
+#include "../src/list.h"
+#include "benchmark.h"
+
+#include <forward_list>
+#include <list>
+
+namespace
+{
+
+constexpr int NUM_OF_NODES = 10000000;
+
+template <class List>
+void fill_back(List& list)
+{
+	for (int i = 0; i < NUM_OF_NODES; ++i)
+		list.push_back(i);
+}
+
+template <class List>
+void fill_front(List& list)
+{
+	for (int i = 0; i < NUM_OF_NODES; ++i)
+		list.push_front(i);
+}
+
+// Times destroying a list of NUM_OF_NODES elements, built by fill.
+template <class List, class Fill>
+void destroy(const char* name, Fill fill)
+{
+	double total = 0;
+
+	for (int round = 0; round < 3; ++round)
+	{
+		auto* list = new List();
+		fill(*list);
+
+		total += benchmark::best_of(1, [list] { delete list; });
+	}
+
+	benchmark::report(name, total / 3, NUM_OF_NODES);
+}
+
+} // namespace
+
+int main()
+{
+	destroy<simple::list<int>>("simple::list destroy", fill_back<simple::list<int>>);
+	destroy<std::list<int>>("std::list destroy", fill_back<std::list<int>>);
+	destroy<simple::forward_list<int>>("simple::forward_list destroy",
+									   fill_front<simple::forward_list<int>>);
+	destroy<std::forward_list<int>>("std::forward_list destroy",
+									fill_front<std::forward_list<int>>);
+
+	simple::list<int> list;
+	fill_back(list);
+	benchmark::report("simple::list clear", benchmark::best_of(1, [&list] { list.clear(); }),
+					  NUM_OF_NODES);
+}
@@ -0,0 +1,91 @@
+#include "../src/forward_list.h"
+#include "../src/lockfree_stack.h"
+#include "../src/vector.h"
+#include "benchmark.h"
+
+#include <mutex>
+#include <thread>
+
+namespace
+{
+
+constexpr int OPERATIONS_PER_THREAD = 2000000;
+
+// The alternative to the lock-free stack: a forward_list behind a mutex.
+class locked_stack
+{
+public:
+	void push(int item)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_list.push_front(item);
+	}
+
+	bool pop(int& item)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_list.empty())
+			return false;
+
+		item = m_list.front();
+		m_list.pop_front();
+		return true;
+	}
+
+private:
+	std::mutex m_mutex;
+	simple::forward_list<int> m_list;
+};
+
+// Every thread pushes and pops in turn, so the stack stays small and all
+// threads contend for its top.
+template <class Stack>
+double run(int num_of_threads)
+{
+	Stack stack;
+
+	return benchmark::best_of(3, [&stack, num_of_threads] {
+		simple::vector<std::thread> threads;
+
+		for (int t = 0; t < num_of_threads; ++t)
+		{
+			threads.push_back(std::thread([&stack] {
+				int sum = 0;
+
+				for (int i = 0; i < OPERATIONS_PER_THREAD / 2; ++i)
+				{
+					int item = 0;
+					stack.push(i);
+
+					if (stack.pop(item))
+						sum += item;
+				}
+
+				benchmark::keep(sum);
+			}));
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+	});
+}
+
+} // namespace
+
+int main()
+{
+	unsigned max_threads = std::thread::hardware_concurrency();
+
+	for (unsigned num_of_threads = 1; num_of_threads <= 2 * max_threads; num_of_threads *= 2)
+	{
+		auto threads = static_cast<int>(num_of_threads);
+		double operations = double(OPERATIONS_PER_THREAD) * threads;
+
+		std::printf("%d threads\n", threads);
+		benchmark::report("  lockfree_stack push+pop", run<simple::lockfree_stack<int>>(threads),
+						  operations);
+		benchmark::report("  mutex + forward_list push+pop", run<locked_stack>(threads),
+						  operations);
+	}
+}
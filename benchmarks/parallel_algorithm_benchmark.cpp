@@ -0,0 +1,121 @@
+#include "../src/parallel_algorithm.h"
+#include "../src/thread_pool.h"
+#include "../src/vector.h"
+#include "benchmark.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+
+namespace
+{
+
+constexpr simple::size_type COUNT = simple::size_type(1) << 23;
+
+simple::vector<std::uint32_t> random_values()
+{
+	std::mt19937 engine(7);
+	simple::vector<std::uint32_t> values;
+	values.reserve(COUNT);
+
+	for (simple::size_type i = 0; i < COUNT; ++i)
+		values.push_back(engine());
+
+	return values;
+}
+
+// Times every algorithm with policy. The input is restored outside of the
+// timed region where the algorithm changes it in place.
+void run(const char* name, const simple::parallel_policy& policy, double* seconds)
+{
+	const simple::vector<std::uint32_t> input = random_values();
+	simple::vector<std::uint32_t> values = input;
+	simple::vector<std::uint64_t> output(COUNT);
+
+	seconds[0] = benchmark::best_of(3, [&] {
+		simple::for_each(policy, values.begin(), values.end(),
+						 [](std::uint32_t& value) { value = value * 1664525u + 1013904223u; });
+	});
+
+	seconds[1] = benchmark::best_of(3, [&] {
+		simple::transform(policy, input.begin(), input.end(), output.begin(),
+						  [](std::uint32_t value) { return std::uint64_t(value) * value; });
+	});
+
+	seconds[2] = benchmark::best_of(3, [&] {
+		benchmark::keep(simple::reduce(policy, input.begin(), input.end(), std::uint64_t(0)));
+	});
+
+	seconds[3] = benchmark::best_of(3, [&] {
+		simple::inclusive_scan(policy, input.begin(), input.end(), output.begin());
+	});
+
+	double sort_best = 0;
+	double partition_best = 0;
+
+	for (int i = 0; i < 3; ++i)
+	{
+		values = input;
+		double sort = benchmark::best_of(1, [&] {
+			simple::sort(policy, values.begin(), values.end());
+		});
+
+		values = input;
+		double partition = benchmark::best_of(1, [&] {
+			simple::partition(policy, values.begin(), values.end(),
+							  [](std::uint32_t value) { return value % 2 == 0; });
+		});
+
+		if (i == 0 || sort < sort_best)
+			sort_best = sort;
+
+		if (i == 0 || partition < partition_best)
+			partition_best = partition;
+	}
+
+	seconds[4] = sort_best;
+	seconds[5] = partition_best;
+
+	std::printf("%-22s", name);
+
+	for (int i = 0; i < 6; ++i)
+		std::printf(" %9.2f", seconds[i] * 1e3);
+
+	std::printf("\n");
+}
+
+} // namespace
+
+int main()
+{
+	simple::size_type cores = simple::thread_pool::default_thread_count();
+	std::printf("%zu elements, hardware threads: %zu, times in ms\n", COUNT, cores);
+	std::printf("%-22s %9s %9s %9s %9s %9s %9s\n", "", "for_each", "transform", "reduce",
+				"scan", "sort", "partition");
+
+	double serial[6];
+	double parallel[6];
+
+	{
+		simple::thread_pool pool(1);
+		run("serial", simple::parallel_policy(pool, std::numeric_limits<simple::size_type>::max()),
+			serial);
+	}
+
+	for (simple::size_type threads = 1; threads <= cores * 2; threads *= 2)
+	{
+		simple::thread_pool pool(threads);
+
+		char name[32];
+		std::snprintf(name, sizeof(name), "%zu threads", threads);
+		run(name, simple::parallel_policy(pool), parallel);
+
+		std::printf("%-22s", "  speedup");
+
+		for (int i = 0; i < 6; ++i)
+			std::printf(" %8.2fx", serial[i] / parallel[i]);
+
+		std::printf("\n");
+	}
+}
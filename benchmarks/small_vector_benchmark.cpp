@@ -0,0 +1,71 @@
+#include "../src/block_storage.h"
+#include "../src/small_vector.h"
+#include "../src/vector.h"
+#include "benchmark.h"
+
+#include <cstdio>
+
+namespace
+{
+
+constexpr int VECTORS = 1000000;
+
+// heap_storage that counts the calls to allocate and reallocate.
+struct counting_storage : simple::heap_storage<>
+{
+	[[nodiscard]] static void* allocate(simple::size_type bytes, simple::size_type alignment)
+	{
+		++allocations;
+		return simple::heap_storage<>::allocate(bytes, alignment);
+	}
+
+	[[nodiscard]] static void* reallocate(void* block, simple::size_type old_bytes,
+										  simple::size_type new_bytes,
+										  simple::size_type alignment) noexcept
+	{
+		++allocations;
+		return simple::heap_storage<>::reallocate(block, old_bytes, new_bytes, alignment);
+	}
+
+	static inline long allocations = 0;
+};
+
+using small = simple::small_vector<int, 8, simple::default_growth, counting_storage>;
+using heap = simple::vector<int, simple::default_growth, counting_storage>;
+
+// Builds VECTORS vectors of size elements each with push_back, the typical
+// use of a short-lived list of results.
+template <class Vector>
+void run(const char* name, int size)
+{
+	counting_storage::allocations = 0;
+
+	double seconds = benchmark::best_of(5, [size] {
+		for (int v = 0; v < VECTORS; ++v)
+		{
+			Vector vec;
+
+			for (int i = 0; i < size; ++i)
+				vec.push_back(i);
+
+			benchmark::keep(vec);
+		}
+	});
+
+	char label[64];
+	std::snprintf(label, sizeof(label), "%s, %d elements", name, size);
+	benchmark::report(label, seconds, VECTORS);
+	std::printf("%-44s %10.2f allocations/vector\n", "",
+				static_cast<double>(counting_storage::allocations) / (5.0 * VECTORS));
+}
+
+} // namespace
+
+int main()
+{
+	for (int size : {1, 4, 8, 16})
+	{
+		run<small>("small_vector<int, 8>", size);
+		run<heap>("vector<int>", size);
+	}
+}
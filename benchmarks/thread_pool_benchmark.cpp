@@ -0,0 +1,79 @@
+#include "../src/thread_pool.h"
+#include "benchmark.h"
+
+#include <cstdio>
+
+namespace
+{
+
+constexpr int FIBONACCI_N = 34;
+constexpr int SERIAL_CUTOFF = 20;
+
+// Deliberately exponential, so that the leaves carry the work.
+long long serial_fibonacci(int n)
+{
+	return n < 2 ? n : serial_fibonacci(n - 1) + serial_fibonacci(n - 2);
+}
+
+// Forks one task per call above the cutoff, about 1600 tasks for n = 34.
+long long fork_join_fibonacci(simple::thread_pool& pool, int n)
+{
+	if (n < SERIAL_CUTOFF)
+		return serial_fibonacci(n);
+
+	auto left = pool.submit([&pool, n] { return fork_join_fibonacci(pool, n - 1); });
+	long long right = fork_join_fibonacci(pool, n - 2);
+
+	return left.get() + right;
+}
+
+// parallel_for over a range whose indices each do a little arithmetic.
+double run_parallel_for(simple::thread_pool& pool)
+{
+	constexpr simple::size_type COUNT = 1 << 22;
+
+	return benchmark::best_of(5, [&pool] {
+		pool.parallel_for(0, COUNT, 4096, [](simple::size_type i) {
+			unsigned value = static_cast<unsigned>(i);
+
+			for (int round = 0; round < 16; ++round)
+				value = value * 1664525u + 1013904223u;
+
+			benchmark::keep(value);
+		});
+	});
+}
+
+} // namespace
+
+int main()
+{
+	simple::size_type cores = simple::thread_pool::default_thread_count();
+	std::printf("hardware threads: %zu\n", cores);
+
+	double fibonacci_base = 0;
+	double parallel_for_base = 0;
+
+	for (simple::size_type threads = 1; threads <= cores * 2; threads *= 2)
+	{
+		simple::thread_pool pool(threads);
+
+		double fibonacci = benchmark::best_of(5, [&pool] {
+			auto root = pool.submit([&pool] { return fork_join_fibonacci(pool, FIBONACCI_N); });
+			benchmark::keep(root.get());
+		});
+
+		double parallel_for = run_parallel_for(pool);
+
+		if (threads == 1)
+		{
+			fibonacci_base = fibonacci;
+			parallel_for_base = parallel_for;
+		}
+
+		std::printf("%2zu threads: fork-join fibonacci %8.3f ms (%.2fx), "
+					"parallel_for %8.3f ms (%.2fx)\n",
+					threads, fibonacci * 1e3, fibonacci_base / fibonacci, parallel_for * 1e3,
+					parallel_for_base / parallel_for);
+	}
+}
@@ -0,0 +1,207 @@
+#ifndef BLOCK_STORAGE_H
+#define BLOCK_STORAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace simple
+{
+
+using size_type = std::size_t;
+
+// A block storage policy hands out the raw blocks a vector keeps its
+// elements in. Every call receives the size of the block in bytes and its
+// alignment, which is the larger of the policy's Alignment and the element
+// alignment:
+//   allocate(bytes, alignment) throws std::bad_alloc on failure.
+//   reallocate(block, old_bytes, new_bytes, alignment) resizes the block,
+//     possibly moving its bytes, or returns nullptr and leaves the block
+//     untouched when it cannot.
+//   deallocate(block, bytes, alignment) accepts the null block.
+
+// Blocks from malloc, so that they can be grown with realloc, or from the
+// aligned operator new when the alignment exceeds what malloc guarantees.
+template <size_type Alignment = alignof(std::max_align_t)>
+struct heap_storage
+{
+	static_assert((Alignment & (Alignment - 1)) == 0, "The alignment must be a power of two");
+
+	constexpr static size_type alignment = Alignment;
+
+	[[nodiscard]] static void* allocate(size_type bytes, size_type block_alignment)
+	{
+		if (block_alignment > alignof(std::max_align_t))
+			return ::operator new(bytes, std::align_val_t(block_alignment));
+
+		void* block = std::malloc(bytes);
+		if (!block && bytes)
+			throw std::bad_alloc();
+
+		return block;
+	}
+
+	[[nodiscard]] static void* reallocate(void* block, size_type /*old_bytes*/, size_type new_bytes,
+										  size_type block_alignment) noexcept
+	{
+		// realloc only keeps the alignment malloc guarantees.
+		if (block_alignment > alignof(std::max_align_t) || new_bytes == 0)
+			return nullptr;
+
+		return std::realloc(block, new_bytes);
+	}
+
+	static void deallocate(void* block, size_type /*bytes*/, size_type block_alignment) noexcept
+	{
+		if (block_alignment > alignof(std::max_align_t))
+			::operator delete(block, std::align_val_t(block_alignment));
+
+		else
+			std::free(block);
+	}
+};
+
+// Blocks of at least ThresholdBytes are mapped directly and backed by huge
+// pages, which cuts TLB misses on large buffers. Explicit huge pages
+// (MAP_HUGETLB) are tried first; when none are reserved, the block is mapped
+// with normal pages aligned to the huge page size and marked for transparent
+// huge pages (MADV_HUGEPAGE). Smaller blocks, and all blocks on platforms
+// without mmap, come from heap_storage.
+template <size_type Alignment = alignof(std::max_align_t),
+		  size_type ThresholdBytes = size_type(2) << 20>
+struct huge_page_storage
+{
+	constexpr static size_type alignment = Alignment;
+	constexpr static size_type HUGE_PAGE_SIZE = size_type(2) << 20;
+
+	static_assert(Alignment <= 4096, "Mapped blocks are only aligned to the page size");
+	static_assert(ThresholdBytes > 0, "The threshold must not be zero");
+
+	// True when a block of the given size is mapped rather than taken from
+	// the heap.
+	[[nodiscard]] constexpr static bool is_mapped(size_type bytes) noexcept
+	{
+#if defined(__linux__)
+		return bytes >= ThresholdBytes;
+#else
+		return false;
+#endif
+	}
+
+	[[nodiscard]] static void* allocate(size_type bytes, size_type block_alignment)
+	{
+		if (!is_mapped(bytes))
+			return heap_storage<Alignment>::allocate(bytes, block_alignment);
+
+		void* block = map(mapped_size(bytes));
+		if (!block)
+			throw std::bad_alloc();
+
+		return block;
+	}
+
+	[[nodiscard]] static void* reallocate(void* block, size_type old_bytes, size_type new_bytes,
+										  size_type block_alignment) noexcept
+	{
+		if (!is_mapped(old_bytes) && !is_mapped(new_bytes))
+			return heap_storage<Alignment>::reallocate(block, old_bytes, new_bytes,
+													   block_alignment);
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+		// Between two mappings the kernel moves the pages instead of copying.
+		if (is_mapped(old_bytes) && is_mapped(new_bytes))
+		{
+			void* new_block =
+				mremap(block, mapped_size(old_bytes), mapped_size(new_bytes), MREMAP_MAYMOVE);
+
+			if (new_block == MAP_FAILED)
+				return nullptr;
+
+			advise_huge_pages(new_block, mapped_size(new_bytes));
+			return new_block;
+		}
+#endif
+
+		return nullptr;
+	}
+
+	static void deallocate(void* block, size_type bytes, size_type block_alignment) noexcept
+	{
+		if (!is_mapped(bytes))
+		{
+			heap_storage<Alignment>::deallocate(block, bytes, block_alignment);
+			return;
+		}
+
+#if defined(__linux__)
+		munmap(block, mapped_size(bytes));
+#endif
+	}
+
+private:
+	[[nodiscard]] constexpr static size_type mapped_size(size_type bytes) noexcept
+	{
+		return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+	}
+
+	[[nodiscard]] static void* map(size_type size) noexcept
+	{
+#if defined(__linux__)
+		constexpr int PROTECTION = PROT_READ | PROT_WRITE;
+		constexpr int FLAGS = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#if defined(MAP_HUGETLB)
+		void* huge_block = mmap(nullptr, size, PROTECTION, FLAGS | MAP_HUGETLB, -1, 0);
+		if (huge_block != MAP_FAILED)
+			return huge_block;
+#endif
+
+		// Over-map by one huge page and trim both ends, so that the block
+		// starts on a huge page boundary where transparent huge pages can
+		// back it.
+		void* region = mmap(nullptr, size + HUGE_PAGE_SIZE, PROTECTION, FLAGS, -1, 0);
+		if (region == MAP_FAILED)
+			return nullptr;
+
+		auto address = reinterpret_cast<std::uintptr_t>(region);
+		std::uintptr_t aligned = (address + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+		std::uintptr_t head = aligned - address;
+
+		if (head)
+			munmap(region, head);
+
+		if (HUGE_PAGE_SIZE - head)
+			munmap(reinterpret_cast<void*>(aligned + size), HUGE_PAGE_SIZE - head);
+
+		void* block = reinterpret_cast<void*>(aligned);
+		advise_huge_pages(block, size);
+
+		return block;
+#else
+		static_cast<void>(size);
+		return nullptr;
+#endif
+	}
+
+	static void advise_huge_pages(void* block, size_type size) noexcept
+	{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+		// Only a hint, the kernel may have transparent huge pages disabled.
+		madvise(block, size, MADV_HUGEPAGE);
+#else
+		static_cast<void>(block);
+		static_cast<void>(size);
+#endif
+	}
+};
+
+using default_storage = heap_storage<>;
+
+} // namespace simple
+
+#endif // BLOCK_STORAGE_H
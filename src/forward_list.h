@@ -2,9 +2,12 @@
 #define FORWARD_LIST_H
 
 #include <cstddef>
+#include <functional>
 #include <iterator>
 #include <utility>
 
+#include "node_pool.h"
+#include "traits.h"
 #include "unique_ptr.h"
 
 namespace simple
@@ -13,15 +16,42 @@ namespace simple
 using size_type = std::size_t;
 
 template <class T>
-struct forward_list_node
+struct forward_list_node;
+
+// The list keeps a bare base as the node before its first element, so that
+// before_begin() and the *_after operations work the same at the front.
+template <class T>
+struct forward_list_node_base
+{
+	forward_list_node_base() = default;
+
+	explicit forward_list_node_base(unique_ptr<forward_list_node<T>>&& next) :
+		m_next(std::move(next))
+	{
+	}
+
+	unique_ptr<forward_list_node<T>> m_next;
+};
+
+template <class T>
+struct forward_list_node : forward_list_node_base<T>
 {
 	template <typename... Args>
 	explicit forward_list_node(unique_ptr<forward_list_node>&& next, Args&&... value) :
-		m_next(std::move(next)), m_value(std::forward<Args>(value)...)
+		forward_list_node_base<T>(std::move(next)), m_value(std::forward<Args>(value)...)
+	{
+	}
+
+	static void* operator new(std::size_t /*size*/)
 	{
+		return node_pool<forward_list_node>::instance().allocate();
+	}
+
+	static void operator delete(void* ptr) noexcept
+	{
+		node_pool<forward_list_node>::instance().deallocate(ptr);
 	}
 
-	unique_ptr<forward_list_node> m_next;
 	T m_value;
 };
 
@@ -36,12 +66,23 @@ public:
 	using difference_type = std::ptrdiff_t;
 
 	using node = forward_list_node<T>;
-	using node_pointer = node*;
+	using node_base = forward_list_node_base<T>;
+	using node_pointer = node_base*;
+
+	friend class forward_list_iterator<T, true>;
+
+	template <typename U>
+	friend class forward_list;
 
 	forward_list_iterator() = default;
 
 	explicit forward_list_iterator(node_pointer ptr) : m_ptr(ptr) {}
 
+	template <bool Const_ = Const, class = std::enable_if_t<Const_>>
+	forward_list_iterator(const forward_list_iterator<T, false>& rhs) : m_ptr(rhs.m_ptr)
+	{
+	}
+
 	forward_list_iterator& operator++()
 	{
 		if (m_ptr != nullptr)
@@ -53,21 +94,32 @@ public:
 	forward_list_iterator operator++(int)
 	{
 		forward_list_iterator it(*this);
-		if (m_ptr != nullptr)
-			m_ptr = m_ptr->m_next;
+		++*this;
 		return it;
 	}
 
 	template <bool Const_ = Const>
 	std::enable_if_t<Const_, reference> operator*() const
 	{
-		return m_ptr->m_value;
+		return static_cast<node*>(m_ptr)->m_value;
 	}
 
 	template <bool Const_ = Const>
 	std::enable_if_t<!Const_, reference> operator*()
 	{
-		return m_ptr->m_value;
+		return static_cast<node*>(m_ptr)->m_value;
+	}
+
+	template <bool Const_ = Const>
+	std::enable_if_t<Const_, pointer> operator->() const
+	{
+		return &static_cast<node*>(m_ptr)->m_value;
+	}
+
+	template <bool Const_ = Const>
+	std::enable_if_t<!Const_, pointer> operator->()
+	{
+		return &static_cast<node*>(m_ptr)->m_value;
 	}
 
 	bool operator==(const forward_list_iterator& other) const { return m_ptr == other.m_ptr; }
@@ -85,13 +137,18 @@ class forward_list
 	using reference = value_type&;
 	using const_reference = const value_type&;
 	using node = forward_list_node<T>;
+	using node_base = forward_list_node_base<T>;
 	using iterator = forward_list_iterator<T>;
 	using const_iterator = forward_list_iterator<T, true>;
 
 public:
 	forward_list() = default;
 
-	forward_list(forward_list&& other) noexcept : m_head(std::move(other.m_head)) {}
+	forward_list(forward_list&& other) noexcept :
+		m_before_head(std::move(other.m_before_head.m_next)),
+		m_size(std::exchange(other.m_size, 0))
+	{
+	}
 
 	forward_list(const forward_list& other) = delete;
 
@@ -99,13 +156,31 @@ public:
 
 	forward_list& operator=(forward_list&& other) noexcept
 	{
-		m_head = std::move(other.m_head);
+		clear();
+		m_before_head.m_next = std::move(other.m_before_head.m_next);
+		m_size = std::exchange(other.m_size, 0);
 		return *this;
 	}
 
 	forward_list& operator=(const forward_list& other) = delete;
 
-	void clear() noexcept { m_head = nullptr; }
+	// Unlink the nodes one at a time, freeing them through the unique_ptr
+	// chain would recurse once per node.
+	void clear() noexcept
+	{
+		while (head())
+			head() = std::move(head()->m_next);
+
+		m_size = 0;
+	}
+
+	void swap(forward_list& other) noexcept
+	{
+		m_before_head.m_next.swap(other.m_before_head.m_next);
+		std::swap(m_size, other.m_size);
+	}
+
+	friend void swap(forward_list& a, forward_list& b) noexcept { a.swap(b); }
 
 	void push_front(const_reference item) { emplace_front(item); }
 	void push_front(T&& item) { emplace_front(std::move(item)); }
@@ -113,24 +188,260 @@ public:
 	template <typename... Args>
 	reference emplace_front(Args&&... args)
 	{
-		m_head = make_unique<node>(std::move(m_head), std::forward<Args>(args)...);
+		return *emplace_after(cbefore_begin(), std::forward<Args>(args)...);
+	}
+
+	void pop_front() { erase_after(cbefore_begin()); }
+
+	iterator insert_after(const_iterator pos, const T& value) { return emplace_after(pos, value); }
+
+	iterator insert_after(const_iterator pos, T&& value)
+	{
+		return emplace_after(pos, std::move(value));
+	}
+
+	template <class... Args>
+	iterator emplace_after(const_iterator pos, Args&&... args)
+	{
+		node_base* prev = pos.m_ptr;
+		prev->m_next = make_unique<node>(std::move(prev->m_next), std::forward<Args>(args)...);
+
+		++m_size;
+
+		return iterator(prev->m_next.get());
+	}
+
+	iterator erase_after(const_iterator pos)
+	{
+		node_base* prev = pos.m_ptr;
+		prev->m_next = std::move(prev->m_next->m_next);
+
+		--m_size;
+
+		return iterator(prev->m_next.get());
+	}
+
+	iterator erase_after(const_iterator first, const_iterator last)
+	{
+		node_base* prev = first.m_ptr;
+
+		while (prev->m_next.get() != last.m_ptr)
+		{
+			prev->m_next = std::move(prev->m_next->m_next);
+			--m_size;
+		}
+
+		return iterator(last.m_ptr);
+	}
+
+	// The splice, merge, sort and reverse operations below only relink
+	// nodes, they never allocate, copy or move elements.
+
+	void splice_after(const_iterator pos, forward_list& other)
+	{
+		if (&other == this || other.empty())
+			return;
+
+		node_base* last = &other.m_before_head;
+		while (last->m_next)
+			last = last->m_next.get();
+
+		transfer_after(pos.m_ptr, &other.m_before_head, last);
+
+		m_size += std::exchange(other.m_size, 0);
+	}
+
+	void splice_after(const_iterator pos, forward_list&& other) { splice_after(pos, other); }
+
+	// Moves the element following it.
+	void splice_after(const_iterator pos, forward_list& other, const_iterator it)
+	{
+		node_base* item = it.m_ptr->m_next.get();
+
+		if (pos.m_ptr == it.m_ptr || pos.m_ptr == item)
+			return;
+
+		transfer_after(pos.m_ptr, it.m_ptr, item);
+
+		--other.m_size;
+		++m_size;
+	}
+
+	void splice_after(const_iterator pos, forward_list&& other, const_iterator it)
+	{
+		splice_after(pos, other, it);
+	}
+
+	// Moves the elements in (first, last).
+	void splice_after(const_iterator pos, forward_list& other, const_iterator first,
+					  const_iterator last)
+	{
+		if (first.m_ptr->m_next.get() == last.m_ptr)
+			return;
+
+		size_type count = 1;
+		node_base* last_item = first.m_ptr->m_next.get();
+
+		while (last_item->m_next.get() != last.m_ptr)
+		{
+			last_item = last_item->m_next.get();
+			++count;
+		}
+
+		transfer_after(pos.m_ptr, first.m_ptr, last_item);
+
+		other.m_size -= count;
+		m_size += count;
+	}
+
+	void splice_after(const_iterator pos, forward_list&& other, const_iterator first,
+					  const_iterator last)
+	{
+		splice_after(pos, other, first, last);
+	}
+
+	// Merges the sorted other into this sorted list, equal elements of this
+	// list come first.
+	template <class Compare>
+	void merge(forward_list& other, Compare comp)
+	{
+		if (&other == this)
+			return;
+
+		node_base* pos = &m_before_head;
+
+		while (other.head())
+		{
+			if (!pos->m_next)
+			{
+				pos->m_next = std::move(other.head());
+				break;
+			}
+
+			if (comp(other.head()->m_value, pos->m_next->m_value))
+				transfer_after(pos, &other.m_before_head, other.head().get());
+
+			pos = pos->m_next.get();
+		}
 
-		return m_head->m_value;
+		m_size += std::exchange(other.m_size, 0);
 	}
 
-	[[nodiscard]] bool empty() const noexcept { return !static_cast<bool>(m_head); }
+	template <class Compare>
+	void merge(forward_list&& other, Compare comp)
+	{
+		merge(other, comp);
+	}
+
+	void merge(forward_list& other) { merge(other, std::less<>()); }
+
+	void merge(forward_list&& other) { merge(other, std::less<>()); }
+
+	// Stable bottom-up merge sort. Bucket i holds a sorted run of 2^i nodes,
+	// every node taken from the list is carried up through the buckets like
+	// a binary counter.
+	template <class Compare>
+	void sort(Compare comp)
+	{
+		if (m_size < 2)
+			return;
+
+		constexpr std::size_t MAX_BUCKETS = 64;
+
+		forward_list carry;
+		forward_list buckets[MAX_BUCKETS];
+		forward_list* fill = buckets;
 
-	[[nodiscard]] reference front() { return m_head->m_value; }
-	[[nodiscard]] const_reference front() const { return m_head->m_value; }
+		do
+		{
+			carry.splice_after(carry.cbefore_begin(), *this, cbefore_begin());
 
-	[[nodiscard]] iterator begin() const noexcept { return iterator(m_head.get()); }
-	[[nodiscard]] const_iterator cbegin() const noexcept { return const_iterator(m_head.get()); }
+			forward_list* counter = buckets;
+			for (; counter != fill && !counter->empty(); ++counter)
+			{
+				counter->merge(carry, comp);
+				carry.swap(*counter);
+			}
+
+			carry.swap(*counter);
+
+			if (counter == fill)
+				++fill;
+		} while (!empty());
+
+		for (forward_list* counter = buckets + 1; counter != fill; ++counter)
+			counter->merge(*(counter - 1), comp);
+
+		swap(*(fill - 1));
+	}
+
+	void sort() { sort(std::less<>()); }
+
+	void reverse() noexcept
+	{
+		unique_ptr<node> reversed;
+
+		while (head())
+		{
+			unique_ptr<node> current = std::move(head());
+			head() = std::move(current->m_next);
+
+			current->m_next = std::move(reversed);
+			reversed = std::move(current);
+		}
+
+		head() = std::move(reversed);
+	}
+
+	[[nodiscard]] bool empty() const noexcept { return !static_cast<bool>(m_before_head.m_next); }
+
+	[[nodiscard]] size_type size() const noexcept { return m_size; }
+
+	[[nodiscard]] reference front() { return head()->m_value; }
+	[[nodiscard]] const_reference front() const { return m_before_head.m_next->m_value; }
+
+	[[nodiscard]] iterator before_begin() const noexcept
+	{
+		return iterator(const_cast<node_base*>(&m_before_head));
+	}
+
+	[[nodiscard]] const_iterator cbefore_begin() const noexcept
+	{
+		return const_iterator(const_cast<node_base*>(&m_before_head));
+	}
+
+	[[nodiscard]] iterator begin() const noexcept { return iterator(m_before_head.m_next.get()); }
+	[[nodiscard]] const_iterator cbegin() const noexcept
+	{
+		return const_iterator(m_before_head.m_next.get());
+	}
 
 	[[nodiscard]] iterator end() const noexcept { return iterator(); }
 	[[nodiscard]] const_iterator cend() const noexcept { return const_iterator(); }
 
 private:
-	unique_ptr<node> m_head;
+	unique_ptr<node>& head() noexcept { return m_before_head.m_next; }
+
+	// Moves the nodes after before_first up to last (inclusive) behind pos.
+	static void transfer_after(node_base* pos, node_base* before_first, node_base* last) noexcept
+	{
+		if (pos == before_first || pos == last)
+			return;
+
+		unique_ptr<node> range = std::move(before_first->m_next);
+		before_first->m_next = std::move(last->m_next);
+		last->m_next = std::move(pos->m_next);
+		pos->m_next = std::move(range);
+	}
+
+	node_base m_before_head;
+	size_type m_size = 0;
+};
+
+// Nodes never point back into the list object itself.
+template <class T>
+struct is_trivially_relocatable<forward_list<T>> : std::true_type
+{
 };
 
 } // namespace simple
@@ -0,0 +1,93 @@
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <cstddef>
+
+namespace simple
+{
+
+using size_type = std::size_t;
+
+// A growth policy decides the capacity a container grows to once it runs out
+// of room. next_capacity receives the current capacity, the capacity that is
+// needed at least and the size of an element, and returns a capacity no
+// smaller than the required one.
+
+// Grows the capacity by Numerator / Denominator, 2x and 1.5x being the usual
+// choices. A smaller factor leaves less slack, a larger one reallocates less
+// often.
+template <size_type Numerator, size_type Denominator = 1>
+struct geometric_growth
+{
+	static_assert(Numerator > Denominator, "The growth factor must be larger than one");
+
+	[[nodiscard]] static constexpr size_type next_capacity(size_type capacity, size_type required,
+														   size_type /*element_size*/) noexcept
+	{
+		size_type grown = capacity / Denominator * Numerator +
+						  capacity % Denominator * Numerator / Denominator + 1;
+
+		return grown < required ? required : grown;
+	}
+};
+
+using double_growth = geometric_growth<2>;
+using one_and_a_half_growth = geometric_growth<3, 2>;
+
+// Rounds the capacity chosen by Policy up so that the block fills the whole
+// size class the allocator would hand out for it anyway. The classes follow
+// jemalloc: multiples of 16 bytes up to 128 bytes, then four classes per
+// doubling.
+template <class Policy = double_growth>
+struct size_class_growth
+{
+	[[nodiscard]] static constexpr size_type size_class(size_type bytes) noexcept
+	{
+		constexpr size_type SMALL_LIMIT = 128;
+		constexpr size_type SMALL_SPACING = 16;
+
+		if (bytes <= SMALL_LIMIT)
+			return (bytes + SMALL_SPACING - 1) / SMALL_SPACING * SMALL_SPACING;
+
+		size_type power = SMALL_LIMIT;
+		while (power * 2 < bytes)
+			power *= 2;
+
+		size_type spacing = power / 4;
+		return (bytes + spacing - 1) / spacing * spacing;
+	}
+
+	[[nodiscard]] static constexpr size_type next_capacity(size_type capacity, size_type required,
+														   size_type element_size) noexcept
+	{
+		size_type grown = Policy::next_capacity(capacity, required, element_size);
+
+		return size_class(grown * element_size) / element_size;
+	}
+};
+
+// Limits a single growth step of Policy to MaxStepBytes, so that huge buffers
+// grow linearly instead of doubling their slack.
+template <class Policy, size_type MaxStepBytes>
+struct capped_growth
+{
+	static_assert(MaxStepBytes > 0, "The growth step must not be empty");
+
+	[[nodiscard]] static constexpr size_type next_capacity(size_type capacity, size_type required,
+														   size_type element_size) noexcept
+	{
+		size_type grown = Policy::next_capacity(capacity, required, element_size);
+		size_type max_step = MaxStepBytes / element_size > 0 ? MaxStepBytes / element_size : 1;
+
+		if (grown - capacity > max_step)
+			grown = capacity + max_step;
+
+		return grown < required ? required : grown;
+	}
+};
+
+using default_growth = double_growth;
+
+} // namespace simple
+
+#endif // GROWTH_POLICY_H
@@ -9,7 +9,7 @@ std::size_t simple::hash<unsigned int>::operator()(unsigned int value) const
 	return static_cast<size_t>(value);
 }
 
-std::size_t simple::hash<string>::operator()(const string& value) const
+std::size_t simple::hash<simple::string_view>::operator()(simple::string_view value) const
 {
 	std::size_t h = 0;
 	for (char letter : value)
@@ -18,6 +18,11 @@ std::size_t simple::hash<string>::operator()(const string& value) const
 	return h;
 }
 
+std::size_t simple::hash<string>::operator()(const string& value) const
+{
+	return hash<string_view>()(value);
+}
+
 std::size_t simple::hash<string*>::operator()(const string* value) const
 {
 	hash<string> non_pointer_hash;
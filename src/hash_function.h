@@ -25,6 +25,14 @@ struct hash<unsigned int>
 	std::size_t operator()(unsigned int value) const;
 };
 
+// Hashes the characters, so a string and a view of the same characters hash
+// alike.
+template <>
+struct hash<string_view>
+{
+	std::size_t operator()(string_view value) const;
+};
+
 template <>
 struct hash<string>
 {
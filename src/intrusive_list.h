@@ -0,0 +1,357 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace simple
+{
+
+using size_type = std::size_t;
+
+enum class link_mode
+{
+	// No bookkeeping, the user guarantees an object is unlinked before it is
+	// destroyed or linked again.
+	normal,
+	// Unlinked hooks are reset, linking a linked hook or destroying a linked
+	// hook asserts.
+	safe_link,
+	// Like safe_link, but a hook removes itself from its list when destroyed.
+	auto_unlink
+};
+
+struct intrusive_list_links
+{
+	intrusive_list_links* prev = nullptr;
+	intrusive_list_links* next = nullptr;
+};
+
+template <link_mode Mode = link_mode::safe_link>
+class intrusive_list_hook : private intrusive_list_links
+{
+public:
+	constexpr static link_mode mode = Mode;
+
+	template <class T, auto Hook>
+	friend class intrusive_list;
+
+	template <class T, auto Hook>
+	friend struct intrusive_list_traits;
+
+	intrusive_list_hook() = default;
+
+	// Copying an object must not copy its list membership.
+	intrusive_list_hook(const intrusive_list_hook& /*other*/) noexcept : intrusive_list_links() {}
+	intrusive_list_hook& operator=(const intrusive_list_hook& /*other*/) noexcept { return *this; }
+
+	~intrusive_list_hook()
+	{
+		if constexpr (Mode == link_mode::auto_unlink)
+			unlink();
+
+		else if constexpr (Mode == link_mode::safe_link)
+			assert(!is_linked());
+	}
+
+	[[nodiscard]] bool is_linked() const noexcept { return next != nullptr; }
+
+	// Removes the object from whatever list it is on.
+	void unlink() noexcept
+	{
+		if (!is_linked())
+			return;
+
+		prev->next = next;
+		next->prev = prev;
+
+		if constexpr (Mode != link_mode::normal)
+		{
+			prev = nullptr;
+			next = nullptr;
+		}
+	}
+};
+
+template <class M>
+struct member_pointer_traits;
+
+template <class C, class M>
+struct member_pointer_traits<M C::*>
+{
+	using class_type = C;
+	using member_type = M;
+};
+
+template <class T, auto Hook>
+struct intrusive_list_traits
+{
+	using hook_type = typename member_pointer_traits<decltype(Hook)>::member_type;
+	using links = intrusive_list_links;
+
+	static_assert(std::is_base_of_v<typename member_pointer_traits<decltype(Hook)>::class_type, T>,
+				  "Hook must be a member of T");
+
+	[[nodiscard]] static links* to_links(T& value) noexcept { return &(value.*Hook); }
+
+	[[nodiscard]] static T* to_value(links* ptr) noexcept
+	{
+		auto* hook = static_cast<hook_type*>(ptr);
+		return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(hook) - hook_offset());
+	}
+
+private:
+	// The offset of the hook within T, read from the representation of the
+	// pointer to member rather than by forming the member of an object that
+	// does not exist. Both the Itanium C++ ABI and MSVC represent a pointer to
+	// data member of a class without virtual bases as that offset, and since
+	// Hook is a constant the copy folds to a constant as well. A Hook in a
+	// virtual base of T fails to convert below.
+	[[nodiscard]] static std::ptrdiff_t hook_offset() noexcept
+	{
+		constexpr hook_type T::*member = Hook;
+
+		using offset_type =
+			std::conditional_t<sizeof(member) == sizeof(int), int, std::ptrdiff_t>;
+		static_assert(sizeof(member) == sizeof(offset_type),
+					  "Unsupported representation of pointers to data members");
+
+		offset_type offset;
+		std::memcpy(&offset, &member, sizeof(offset));
+		return offset;
+	}
+};
+
+template <class T, auto Hook, bool Const = false>
+class intrusive_list_iterator
+{
+	using traits = intrusive_list_traits<T, Hook>;
+	using links = intrusive_list_links;
+
+public:
+	using value_type = T;
+	using reference = typename std::conditional_t<Const, value_type const&, value_type&>;
+	using pointer = typename std::conditional_t<Const, value_type const*, value_type*>;
+	using iterator_category = std::bidirectional_iterator_tag;
+	using difference_type = std::ptrdiff_t;
+
+	friend class intrusive_list_iterator<T, Hook, true>;
+
+	template <class U, auto UHook>
+	friend class intrusive_list;
+
+	intrusive_list_iterator() = default;
+
+	explicit intrusive_list_iterator(links* ptr) : m_ptr(ptr) {}
+
+	template <bool Const_ = Const, class = std::enable_if_t<Const_>>
+	intrusive_list_iterator(const intrusive_list_iterator<T, Hook, false>& rhs) : m_ptr(rhs.m_ptr)
+	{
+	}
+
+	intrusive_list_iterator& operator++()
+	{
+		m_ptr = m_ptr->next;
+		return *this;
+	}
+
+	intrusive_list_iterator operator++(int)
+	{
+		intrusive_list_iterator it(*this);
+		++*this;
+		return it;
+	}
+
+	intrusive_list_iterator& operator--()
+	{
+		m_ptr = m_ptr->prev;
+		return *this;
+	}
+
+	intrusive_list_iterator operator--(int)
+	{
+		intrusive_list_iterator it(*this);
+		--*this;
+		return it;
+	}
+
+	reference operator*() const { return *traits::to_value(m_ptr); }
+
+	pointer operator->() const { return traits::to_value(m_ptr); }
+
+	friend bool operator==(const intrusive_list_iterator& lhs, const intrusive_list_iterator& rhs)
+	{
+		return lhs.m_ptr == rhs.m_ptr;
+	}
+
+	friend bool operator!=(const intrusive_list_iterator& lhs, const intrusive_list_iterator& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+private:
+	links* m_ptr = nullptr;
+};
+
+// Doubly-linked list whose links live inside the elements (in the member
+// pointed to by Hook), so linking never allocates and an element can be
+// unlinked in O(1) from just a reference to it. The list does not own its
+// elements. Because elements can leave the list without going through it,
+// size() walks the list.
+template <class T, auto Hook>
+class intrusive_list
+{
+	using traits = intrusive_list_traits<T, Hook>;
+	using links = intrusive_list_links;
+
+public:
+	using value_type = T;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using hook_type = typename traits::hook_type;
+	using iterator = intrusive_list_iterator<T, Hook>;
+	using const_iterator = intrusive_list_iterator<T, Hook, true>;
+
+	intrusive_list() { reset_root(); }
+
+	~intrusive_list() { clear(); }
+
+	intrusive_list(intrusive_list&& other) noexcept
+	{
+		reset_root();
+		take_elements(other);
+	}
+
+	intrusive_list& operator=(intrusive_list&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			take_elements(other);
+		}
+
+		return *this;
+	}
+
+	intrusive_list(const intrusive_list& other) = delete;
+	intrusive_list& operator=(const intrusive_list& other) = delete;
+
+	[[nodiscard]] bool empty() const noexcept { return m_root.next == &m_root; }
+
+	[[nodiscard]] size_type size() const noexcept
+	{
+		size_type count = 0;
+		for (const links* it = m_root.next; it != &m_root; it = it->next)
+			++count;
+
+		return count;
+	}
+
+	void clear() noexcept
+	{
+		if constexpr (hook_type::mode != link_mode::normal)
+		{
+			links* it = m_root.next;
+			while (it != &m_root)
+			{
+				links* next = it->next;
+				it->prev = nullptr;
+				it->next = nullptr;
+				it = next;
+			}
+		}
+
+		reset_root();
+	}
+
+	void push_front(reference value) { link_before(m_root.next, traits::to_links(value)); }
+
+	void push_back(reference value) { link_before(&m_root, traits::to_links(value)); }
+
+	void pop_front() { value_of(m_root.next).unlink(); }
+
+	void pop_back() { value_of(m_root.prev).unlink(); }
+
+	iterator insert(const_iterator pos, reference value)
+	{
+		links* new_links = traits::to_links(value);
+		link_before(pos.m_ptr, new_links);
+
+		return iterator(new_links);
+	}
+
+	iterator erase(const_iterator pos)
+	{
+		links* next = pos.m_ptr->next;
+		value_of(pos.m_ptr).unlink();
+
+		return iterator(next);
+	}
+
+	iterator erase(reference value) { return erase(iterator_to(value)); }
+
+	[[nodiscard]] iterator iterator_to(reference value) const noexcept
+	{
+		return iterator(traits::to_links(value));
+	}
+
+	[[nodiscard]] reference front() { return *traits::to_value(m_root.next); }
+	[[nodiscard]] const_reference front() const { return *traits::to_value(m_root.next); }
+
+	[[nodiscard]] reference back() { return *traits::to_value(m_root.prev); }
+	[[nodiscard]] const_reference back() const { return *traits::to_value(m_root.prev); }
+
+	[[nodiscard]] iterator begin() const noexcept { return iterator(m_root.next); }
+	[[nodiscard]] const_iterator cbegin() const noexcept { return const_iterator(m_root.next); }
+
+	[[nodiscard]] iterator end() const noexcept { return iterator(root()); }
+	[[nodiscard]] const_iterator cend() const noexcept { return const_iterator(root()); }
+
+private:
+	[[nodiscard]] static hook_type& value_of(links* ptr) noexcept
+	{
+		return *static_cast<hook_type*>(ptr);
+	}
+
+	[[nodiscard]] links* root() const noexcept { return const_cast<links*>(&m_root); }
+
+	void reset_root() noexcept
+	{
+		m_root.prev = &m_root;
+		m_root.next = &m_root;
+	}
+
+	void take_elements(intrusive_list& other) noexcept
+	{
+		if (other.empty())
+			return;
+
+		m_root.next = other.m_root.next;
+		m_root.prev = other.m_root.prev;
+		m_root.next->prev = &m_root;
+		m_root.prev->next = &m_root;
+
+		other.reset_root();
+	}
+
+	static void link_before(links* pos, links* new_links) noexcept
+	{
+		if constexpr (hook_type::mode != link_mode::normal)
+			assert(!new_links->next && "The object is already linked");
+
+		new_links->prev = pos->prev;
+		new_links->next = pos;
+		pos->prev->next = new_links;
+		pos->prev = new_links;
+	}
+
+	links m_root;
+};
+
+} // namespace simple
+
+#endif // INTRUSIVE_LIST_H
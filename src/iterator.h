@@ -3,6 +3,7 @@
 
 #include <iterator>
 #include <cstddef>
+#include <type_traits>
 
 namespace simple
 {
@@ -16,6 +17,7 @@ public:
 	using reference = typename std::conditional_t<Const, value_type const&, value_type&>;
 	using pointer = typename std::conditional_t<Const, value_type const*, value_type*>;
 	using difference_type = std::ptrdiff_t;
+	using iterator_category = std::forward_iterator_tag;
 
 	friend class my_iterator<T, true>;
 
@@ -49,29 +51,11 @@ public:
 		return lhs.m_ptr != rhs.m_ptr;
 	}
 
-	template <bool Const_ = Const>
-	std::enable_if_t<Const_, pointer> operator->() const
-	{
-		return m_ptr;
-	}
-
-	template <bool Const_ = Const>
-	std::enable_if_t<!Const_, pointer> operator->()
-	{
-		return m_ptr;
-	}
+	// Constness of the iterator itself does not change what it points to,
+	// std::to_address and the C++20 iterator concepts rely on that.
+	pointer operator->() const { return m_ptr; }
 
-	template <bool Const_ = Const>
-	std::enable_if_t<Const_, reference> operator*() const
-	{
-		return *m_ptr;
-	}
-
-	template <bool Const_ = Const>
-	std::enable_if_t<!Const_, reference> operator*()
-	{
-		return *m_ptr;
-	}
+	reference operator*() const { return *m_ptr; }
 
 protected:
 	T* m_ptr = nullptr;
@@ -93,13 +77,25 @@ public:
 	}
 };
 
+// Iterator over contiguous elements, conforming to std::iterator_traits and,
+// under C++20, to std::contiguous_iterator, so that standard algorithms and
+// ranges take their pointer fast paths. Offsets may be any integer type:
+// signed ones as the standard requires, unsigned ones for indices.
 template <typename T, bool Const = false>
 class random_access_iterator : public forward_iterator<T, Const>
 {
+	template <class Integer>
+	using if_integer = std::enable_if_t<std::is_integral_v<Integer>>;
+
 public:
+	using value_type = T;
 	using pointer = typename my_iterator<T, Const>::pointer;
 	using reference = typename my_iterator<T, Const>::reference;
 	using difference_type = typename my_iterator<T, Const>::difference_type;
+	using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+	using iterator_concept = std::contiguous_iterator_tag;
+#endif
 
 	friend class random_access_iterator<T, true>;
 
@@ -112,6 +108,19 @@ public:
 	{
 	}
 
+	random_access_iterator& operator++()
+	{
+		++this->m_ptr;
+		return *this;
+	}
+
+	random_access_iterator operator++(int)
+	{
+		random_access_iterator it(*this);
+		++this->m_ptr;
+		return it;
+	}
+
 	random_access_iterator& operator--()
 	{
 		--this->m_ptr;
@@ -125,18 +134,30 @@ public:
 		return it;
 	}
 
-	random_access_iterator& operator+=(size_type offset)
+	template <class Integer, class = if_integer<Integer>>
+	random_access_iterator& operator+=(Integer offset)
 	{
 		this->m_ptr += offset;
 		return *this;
 	}
 
-	random_access_iterator& operator-=(size_type offset)
+	template <class Integer, class = if_integer<Integer>>
+	random_access_iterator& operator-=(Integer offset)
 	{
 		this->m_ptr -= offset;
 		return *this;
 	}
 
+	friend bool operator==(const random_access_iterator& lhs, const random_access_iterator& rhs)
+	{
+		return lhs.m_ptr == rhs.m_ptr;
+	}
+
+	friend bool operator!=(const random_access_iterator& lhs, const random_access_iterator& rhs)
+	{
+		return lhs.m_ptr != rhs.m_ptr;
+	}
+
 	friend bool operator<(const random_access_iterator& lhs, const random_access_iterator& rhs)
 	{
 		return lhs.m_ptr < rhs.m_ptr;
@@ -144,25 +165,33 @@ public:
 
 	friend bool operator<=(const random_access_iterator& lhs, const random_access_iterator& rhs)
 	{
-		return lhs.m_ptr < rhs.m_ptr;
+		return lhs.m_ptr <= rhs.m_ptr;
 	}
 
 	friend bool operator>(const random_access_iterator& lhs, const random_access_iterator& rhs)
 	{
-		return lhs.m_ptr < rhs.m_ptr;
+		return lhs.m_ptr > rhs.m_ptr;
 	}
 
 	friend bool operator>=(const random_access_iterator& lhs, const random_access_iterator& rhs)
 	{
-		return lhs.m_ptr < rhs.m_ptr;
+		return lhs.m_ptr >= rhs.m_ptr;
 	}
 
-	friend random_access_iterator operator+(const random_access_iterator& it, size_type offset)
+	template <class Integer, class = if_integer<Integer>>
+	friend random_access_iterator operator+(const random_access_iterator& it, Integer offset)
 	{
 		return random_access_iterator(it.m_ptr + offset);
 	}
 
-	friend random_access_iterator operator-(const random_access_iterator& it, size_type offset)
+	template <class Integer, class = if_integer<Integer>>
+	friend random_access_iterator operator+(Integer offset, const random_access_iterator& it)
+	{
+		return random_access_iterator(it.m_ptr + offset);
+	}
+
+	template <class Integer, class = if_integer<Integer>>
+	friend random_access_iterator operator-(const random_access_iterator& it, Integer offset)
 	{
 		return random_access_iterator(it.m_ptr - offset);
 	}
@@ -173,9 +202,11 @@ public:
 		return lhs.m_ptr - rhs.m_ptr;
 	}
 
-	reference operator[](size_type index) { return *(this->m_ptr + index); }
-
-	reference operator[](size_type index) const { return *(this->m_ptr + index); }
+	template <class Integer, class = if_integer<Integer>>
+	reference operator[](Integer index) const
+	{
+		return this->m_ptr[index];
+	}
 };
 
 } // namespace simple
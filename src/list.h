@@ -2,9 +2,12 @@
 #define LIST_H
 
 #include <cstddef>
+#include <functional>
 #include <iterator>
 #include <utility>
 
+#include "node_pool.h"
+#include "traits.h"
 #include "unique_ptr.h"
 
 namespace simple
@@ -21,6 +24,16 @@ struct list_node
 	{
 	}
 
+	static void* operator new(std::size_t /*size*/)
+	{
+		return node_pool<list_node>::instance().allocate();
+	}
+
+	static void operator delete(void* ptr) noexcept
+	{
+		node_pool<list_node>::instance().deallocate(ptr);
+	}
+
 	list_node* prev;
 	unique_ptr<list_node> next;
 
@@ -135,17 +148,25 @@ public:
 	using iterator_category = std::bidirectional_iterator_tag;
 
 	list() = default;
-	~list() = default;
+	~list() { clear(); }
 
-	list(list&& other) noexcept = default;
+	list(list&& other) noexcept :
+		m_head(std::move(other.m_head)), m_tail(std::exchange(other.m_tail, nullptr)),
+		m_size(std::exchange(other.m_size, 0))
+	{
+	}
 
 	list(const list& other) = delete;
 	list& operator=(const list& other) = delete;
 
+	// Unlink the nodes one at a time, freeing them through the unique_ptr
+	// chain would recurse once per node.
 	void clear() noexcept
 	{
+		while (m_head)
+			m_head = std::move(m_head->next);
+
 		m_size = 0;
-		m_head.reset();
 		m_tail = nullptr;
 	}
 
@@ -305,6 +326,213 @@ public:
 		}
 	}
 
+	void swap(list& other) noexcept
+	{
+		m_head.swap(other.m_head);
+		std::swap(m_tail, other.m_tail);
+		std::swap(m_size, other.m_size);
+	}
+
+	friend void swap(list& a, list& b) noexcept { a.swap(b); }
+
+	// The splice, merge, sort, reverse and unique operations below only
+	// relink nodes, they never allocate, copy or move elements.
+
+	void splice(const_iterator pos, list& other)
+	{
+		if (&other == this || other.empty())
+			return;
+
+		node* last = other.m_tail;
+		link_range(pos.m_ptr, other.unlink_range(other.m_head.get(), last), last);
+
+		m_size += std::exchange(other.m_size, 0);
+	}
+
+	void splice(const_iterator pos, list&& other) { splice(pos, other); }
+
+	void splice(const_iterator pos, list& other, const_iterator it)
+	{
+		node* item = it.m_ptr;
+
+		if (&other == this && (item == pos.m_ptr || item->next.get() == pos.m_ptr))
+			return;
+
+		link_range(pos.m_ptr, other.unlink_range(item, item), item);
+
+		--other.m_size;
+		++m_size;
+	}
+
+	void splice(const_iterator pos, list&& other, const_iterator it) { splice(pos, other, it); }
+
+	void splice(const_iterator pos, list& other, const_iterator first, const_iterator last)
+	{
+		if (first == last)
+			return;
+
+		node* last_item = last.m_ptr ? last.m_ptr->prev : other.m_tail;
+
+		if (&other != this)
+		{
+			size_type count = 1;
+			for (node* it = first.m_ptr; it != last_item; it = it->next.get())
+				++count;
+
+			other.m_size -= count;
+			m_size += count;
+		}
+
+		link_range(pos.m_ptr, other.unlink_range(first.m_ptr, last_item), last_item);
+	}
+
+	void splice(const_iterator pos, list&& other, const_iterator first, const_iterator last)
+	{
+		splice(pos, other, first, last);
+	}
+
+	// Merges the sorted other into this sorted list, equal elements of this
+	// list come first.
+	template <class Compare>
+	void merge(list& other, Compare comp)
+	{
+		if (&other == this)
+			return;
+
+		node* pos = m_head.get();
+
+		while (other.m_head)
+		{
+			if (!pos)
+			{
+				splice(end(), other);
+				return;
+			}
+
+			if (!comp(other.m_head->m_value, pos->m_value))
+			{
+				pos = pos->next.get();
+				continue;
+			}
+
+			node* run_last = other.m_head.get();
+			size_type count = 1;
+
+			while (run_last->next && comp(run_last->next->m_value, pos->m_value))
+			{
+				run_last = run_last->next.get();
+				++count;
+			}
+
+			link_range(pos, other.unlink_range(other.m_head.get(), run_last), run_last);
+
+			other.m_size -= count;
+			m_size += count;
+		}
+	}
+
+	template <class Compare>
+	void merge(list&& other, Compare comp)
+	{
+		merge(other, comp);
+	}
+
+	void merge(list& other) { merge(other, std::less<>()); }
+
+	void merge(list&& other) { merge(other, std::less<>()); }
+
+	// Stable bottom-up merge sort. Bucket i holds a sorted run of 2^i nodes,
+	// every node taken from the list is carried up through the buckets like
+	// a binary counter.
+	template <class Compare>
+	void sort(Compare comp)
+	{
+		if (m_size < 2)
+			return;
+
+		constexpr std::size_t MAX_BUCKETS = 64;
+
+		list carry;
+		list buckets[MAX_BUCKETS];
+		list* fill = buckets;
+
+		do
+		{
+			carry.splice(carry.begin(), *this, begin());
+
+			list* counter = buckets;
+			for (; counter != fill && !counter->empty(); ++counter)
+			{
+				counter->merge(carry, comp);
+				carry.swap(*counter);
+			}
+
+			carry.swap(*counter);
+
+			if (counter == fill)
+				++fill;
+		} while (!empty());
+
+		for (list* counter = buckets + 1; counter != fill; ++counter)
+			counter->merge(*(counter - 1), comp);
+
+		swap(*(fill - 1));
+	}
+
+	void sort() { sort(std::less<>()); }
+
+	void reverse() noexcept
+	{
+		unique_ptr<node> reversed;
+		node* new_tail = m_head.get();
+
+		while (m_head)
+		{
+			unique_ptr<node> current = std::move(m_head);
+			m_head = std::move(current->next);
+
+			current->prev = m_head.get();
+			current->next = std::move(reversed);
+			reversed = std::move(current);
+		}
+
+		m_head = std::move(reversed);
+		m_tail = new_tail;
+	}
+
+	// Removes all but the first element of every run of equal elements and
+	// returns the number of removed elements.
+	template <class BinaryPredicate>
+	size_type unique(BinaryPredicate pred)
+	{
+		size_type removed = 0;
+		node* current = m_head.get();
+
+		while (current && current->next)
+		{
+			if (!pred(current->m_value, current->next->m_value))
+			{
+				current = current->next.get();
+				continue;
+			}
+
+			current->next = std::move(current->next->next);
+
+			if (current->next)
+				current->next->prev = current;
+			else
+				m_tail = current;
+
+			++removed;
+		}
+
+		m_size -= removed;
+
+		return removed;
+	}
+
+	size_type unique() { return unique(std::equal_to<>()); }
+
 	[[nodiscard]] reference front() { return m_head->m_value; }
 	[[nodiscard]] const_reference front() const { return m_head->m_value; }
 
@@ -321,11 +549,54 @@ public:
 	[[nodiscard]] const_iterator cend() const noexcept { return const_iterator(m_tail); }
 
 private:
+	// Detaches the nodes from first to last (inclusive) and returns the
+	// owner of first.
+	unique_ptr<node> unlink_range(node* first, node* last) noexcept
+	{
+		unique_ptr<node>& owner = first->prev ? first->prev->next : m_head;
+
+		unique_ptr<node> range = std::move(owner);
+		owner = std::move(last->next);
+
+		if (owner)
+			owner->prev = first->prev;
+		else
+			m_tail = first->prev;
+
+		first->prev = nullptr;
+
+		return range;
+	}
+
+	// Links a detached range ending at last in front of pos (null for the
+	// end of the list).
+	void link_range(node* pos, unique_ptr<node>&& range, node* last) noexcept
+	{
+		node* prev = pos ? pos->prev : m_tail;
+		unique_ptr<node>& owner = prev ? prev->next : m_head;
+
+		last->next = std::move(owner);
+
+		if (last->next)
+			last->next->prev = last;
+		else
+			m_tail = last;
+
+		range->prev = prev;
+		owner = std::move(range);
+	}
+
 	unique_ptr<node> m_head = nullptr;
 	node* m_tail = nullptr;
 	size_type m_size = 0;
 };
 
+// Nodes never point back into the list object itself.
+template <class T>
+struct is_trivially_relocatable<list<T>> : std::true_type
+{
+};
+
 } // namespace simple
 
 #endif // LIST_H
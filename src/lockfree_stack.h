@@ -0,0 +1,278 @@
+#ifndef LOCKFREE_STACK_H
+#define LOCKFREE_STACK_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace simple
+{
+
+using size_type = std::size_t;
+
+// Same shape as forward_list_node: one next pointer followed by the value.
+// The value lives in raw storage so that popped nodes can be recycled.
+template <class T>
+struct lockfree_stack_node
+{
+	[[nodiscard]] T* value() noexcept { return std::launder(reinterpret_cast<T*>(m_storage)); }
+
+	std::atomic<lockfree_stack_node*> m_next {nullptr};
+	alignas(T) unsigned char m_storage[sizeof(T)];
+};
+
+// Treiber stack. The top of the stack is a 48-bit pointer packed with a
+// 16-bit modification tag, so a pop that was preempted between reading the top and
+// its CAS fails if the top was popped and pushed again in between (ABA).
+// Popped nodes are never freed while the stack is alive, they go to an
+// internal free list (itself a tagged Treiber stack) and are reused by later
+// pushes. Reading the next pointer of a node that was concurrently popped is
+// therefore always a read of valid memory, and the tag makes the CAS fail.
+// Nodes are released when the stack is destroyed. Pushing throws
+// std::runtime_error if a new node lies above the 48-bit address range.
+template <class T>
+class lockfree_stack
+{
+	using node = lockfree_stack_node<T>;
+	using tagged_pointer = std::uint64_t;
+
+	static_assert(sizeof(void*) == sizeof(tagged_pointer), "Tagged pointers need 64-bit pointers");
+
+	constexpr static unsigned POINTER_BITS = 48;
+	constexpr static tagged_pointer POINTER_MASK = (tagged_pointer(1) << POINTER_BITS) - 1;
+
+public:
+	using value_type = T;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+
+	lockfree_stack() = default;
+
+	~lockfree_stack()
+	{
+		pop_all([](T&& /*value*/) {});
+
+		delete_chain(unpack(m_free.load(std::memory_order_relaxed)));
+	}
+
+	lockfree_stack(const lockfree_stack& other) = delete;
+	lockfree_stack(lockfree_stack&& other) = delete;
+	lockfree_stack& operator=(const lockfree_stack& other) = delete;
+	lockfree_stack& operator=(lockfree_stack&& other) = delete;
+
+	void push(const_reference item) { emplace(item); }
+
+	void push(T&& item) { emplace(std::move(item)); }
+
+	template <typename... Args>
+	void emplace(Args&&... args)
+	{
+		node* new_node = create_node(std::forward<Args>(args)...);
+		push_chain(m_top, new_node, new_node);
+	}
+
+	// Pushes the range with a single CAS, the last element ends up on top.
+	template <class InputIt>
+	void push_range(InputIt first, InputIt last)
+	{
+		if (first == last)
+			return;
+
+		node* chain_last = create_node(*first);
+		node* chain_first = chain_last;
+
+		try
+		{
+			for (++first; first != last; ++first)
+			{
+				node* new_node = create_node(*first);
+				new_node->m_next.store(chain_first, std::memory_order_relaxed);
+				chain_first = new_node;
+			}
+		}
+
+		catch (...)
+		{
+			recycle_chain(chain_first, chain_last);
+			throw;
+		}
+
+		push_chain(m_top, chain_first, chain_last);
+	}
+
+	// Moves the top element into value, returns false if the stack is empty.
+	bool pop(T& value)
+	{
+		node* top = pop_node(m_top);
+
+		if (!top)
+			return false;
+
+		value = std::move(*top->value());
+		recycle_chain(top, top);
+
+		return true;
+	}
+
+	// Detaches all elements with a single exchange and passes them, from top
+	// to bottom, as rvalues to func. Returns the number of elements.
+	template <class Func>
+	size_type pop_all(Func func)
+	{
+		tagged_pointer old_top = m_top.load(std::memory_order_relaxed);
+
+		while (!m_top.compare_exchange_weak(old_top, pack(nullptr, old_top),
+											std::memory_order_acquire, std::memory_order_relaxed))
+		{
+		}
+
+		node* first = unpack(old_top);
+
+		if (!first)
+			return 0;
+
+		size_type count = 1;
+		node* last = first;
+
+		while (true)
+		{
+			func(std::move(*last->value()));
+
+			node* next = last->m_next.load(std::memory_order_relaxed);
+			if (!next)
+				break;
+
+			last = next;
+			++count;
+		}
+
+		recycle_chain(first, last);
+
+		return count;
+	}
+
+	// Only a snapshot, other threads may push or pop right after.
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return unpack(m_top.load(std::memory_order_acquire)) == nullptr;
+	}
+
+private:
+	[[nodiscard]] static tagged_pointer pack(node* ptr, tagged_pointer previous) noexcept
+	{
+		auto address = reinterpret_cast<tagged_pointer>(ptr);
+		assert((address & ~POINTER_MASK) == 0);
+
+		tagged_pointer tag = (previous >> POINTER_BITS) + 1;
+		return (tag << POINTER_BITS) | address;
+	}
+
+	[[nodiscard]] static node* unpack(tagged_pointer value) noexcept
+	{
+		return reinterpret_cast<node*>(value & POINTER_MASK);
+	}
+
+	static void push_chain(std::atomic<tagged_pointer>& head, node* first, node* last) noexcept
+	{
+		tagged_pointer old_head = head.load(std::memory_order_relaxed);
+
+		do
+		{
+			last->m_next.store(unpack(old_head), std::memory_order_relaxed);
+		} while (!head.compare_exchange_weak(old_head, pack(first, old_head),
+											 std::memory_order_release,
+											 std::memory_order_relaxed));
+	}
+
+	[[nodiscard]] static node* pop_node(std::atomic<tagged_pointer>& head) noexcept
+	{
+		tagged_pointer old_head = head.load(std::memory_order_acquire);
+
+		while (node* top = unpack(old_head))
+		{
+			node* next = top->m_next.load(std::memory_order_relaxed);
+
+			if (head.compare_exchange_weak(old_head, pack(next, old_head),
+										   std::memory_order_acquire, std::memory_order_acquire))
+				return top;
+		}
+
+		return nullptr;
+	}
+
+	template <typename... Args>
+	node* create_node(Args&&... args)
+	{
+		node* new_node = pop_node(m_free);
+
+		if (!new_node)
+			new_node = allocate_node();
+
+		try
+		{
+			new (new_node->m_storage) T(std::forward<Args>(args)...);
+		}
+
+		catch (...)
+		{
+			push_chain(m_free, new_node, new_node);
+			throw;
+		}
+
+		return new_node;
+	}
+
+	// Nodes are never freed while the stack is alive, so checking that the
+	// address leaves room for the tag once per node is enough. Addresses above
+	// 48 bits, from 5-level paging or from pointer tagging such as MTE, would
+	// be silently corrupted by the tag otherwise.
+	[[nodiscard]] static node* allocate_node()
+	{
+		node* new_node = new node();
+
+		if (reinterpret_cast<tagged_pointer>(new_node) & ~POINTER_MASK)
+		{
+			delete new_node;
+			throw std::runtime_error("Node address does not fit in a tagged pointer");
+		}
+
+		return new_node;
+	}
+
+	// Destroys the values of the chain and hands its nodes to the free list.
+	void recycle_chain(node* first, node* last) noexcept
+	{
+		for (node* it = first;; it = it->m_next.load(std::memory_order_relaxed))
+		{
+			it->value()->~T();
+
+			if (it == last)
+				break;
+		}
+
+		push_chain(m_free, first, last);
+	}
+
+	static void delete_chain(node* first) noexcept
+	{
+		while (first)
+		{
+			node* next = first->m_next.load(std::memory_order_relaxed);
+			delete first;
+			first = next;
+		}
+	}
+
+	constexpr static std::size_t CACHE_LINE_SIZE = 64;
+
+	alignas(CACHE_LINE_SIZE) std::atomic<tagged_pointer> m_top {0};
+	alignas(CACHE_LINE_SIZE) std::atomic<tagged_pointer> m_free {0};
+};
+
+} // namespace simple
+
+#endif // LOCKFREE_STACK_H
@@ -1,38 +1,45 @@
 #include "my_string.h"
 
-simple::string::string() : m_elem(create_string(STARTING_CAPACITY)) {}
+#include <functional>
+#include <stdexcept>
 
-simple::string::string(simple::size_type count, char ch) :
-	m_size(count), m_elem(create_string(count)), m_capacity(count)
-{
-	memset(m_elem, ch, count);
-}
+simple::string::string() noexcept { set_short_size(0); }
 
-simple::string::string(const simple::string& other) :
-	m_size(other.m_size), m_elem(create_string(other.m_size)), m_capacity(m_size)
+simple::string::string(simple::size_type count, char ch)
 {
-	std::memcpy(m_elem, other.m_elem, m_size);
+	init(count);
+	memset(data(), ch, count);
 }
 
-simple::string::string(simple::string&& other) noexcept
+simple::string::string(const simple::string& other)
 {
-	m_size = std::exchange(other.m_size, 0);
-	m_elem = std::exchange(other.m_elem, nullptr);
-	m_capacity = std::exchange(other.m_capacity, 0);
+	if (!other.is_long())
+	{
+		m_rep = other.m_rep;
+		return;
+	}
+
+	init(other.size());
+	std::memcpy(data(), other.data(), other.size());
 }
 
-simple::string::string(const char* other) :
-	m_size(strlen(other)), m_elem(create_string(m_size)), m_capacity(m_size)
+simple::string::string(simple::string&& other) noexcept : m_rep(other.m_rep)
 {
-	std::memcpy(m_elem, other, m_size);
+	other.set_short_size(0);
 }
 
-simple::string::string(const char* other, size_type count) :
-	m_size(count), m_elem(create_string(count)), m_capacity(count)
+simple::string::string(const char* other) : string(other, strlen(other)) {}
+
+simple::string::string(const char* other, size_type count)
 {
-	std::memcpy(m_elem, other, count);
+	init(count);
+
+	if (count)
+		std::memcpy(data(), other, count);
 }
 
+simple::string::string(simple::string_view other) : string(other.data(), other.size()) {}
+
 simple::string& simple::string::operator=(simple::string other)
 {
 	other.swap(*this);
@@ -41,142 +48,341 @@ simple::string& simple::string::operator=(simple::string other)
 
 simple::string& simple::string::operator=(const char* other)
 {
-	m_size = strlen(other);
-	fit(m_size);
-	std::memcpy(m_elem, other, m_size);
-	m_elem[m_size] = '\0';
-
+	assign(other, strlen(other));
 	return *this;
 }
 
 simple::string::~string() { delete_string(); }
 
-bool simple::string::empty() const { return m_size == 0; }
+simple::string::iterator simple::string::begin() const noexcept { return iterator(data()); }
 
-simple::size_type simple::string::size() const { return m_size; }
+simple::string::iterator simple::string::end() const noexcept { return iterator(data() + size()); }
 
-simple::size_type simple::string::length() const { return m_size; }
+simple::string::value_type& simple::string::front() noexcept { return data()[0]; }
 
-simple::string::iterator simple::string::begin() const noexcept { return iterator(m_elem); }
+const simple::string::value_type& simple::string::front() const noexcept { return data()[0]; }
 
-simple::string::iterator simple::string::end() const noexcept { return iterator(m_elem + m_size); }
+simple::string::value_type& simple::string::back() noexcept { return data()[size() - 1]; }
 
-simple::string::value_type& simple::string::front() noexcept { return m_elem[0]; }
+const simple::string::value_type& simple::string::back() const noexcept
+{
+	return data()[size() - 1];
+}
 
-const simple::string::value_type& simple::string::front() const noexcept { return m_elem[0]; }
+bool simple::string::operator==(const simple::string& other) const
+{
+	if (size() != other.size())
+		return false;
 
-simple::string::value_type& simple::string::back() noexcept { return m_elem[m_size - 1]; }
+	return !(std::memcmp(data(), other.data(), size()));
+}
 
-const simple::string::value_type& simple::string::back() const noexcept { return m_elem[m_size - 1]; }
+bool simple::string::operator==(const char* other) const { return !(std::strcmp(data(), other)); }
 
-simple::string::pointer simple::string::data() noexcept { return m_elem; }
+bool simple::string::operator!=(const simple::string& other) const { return !(*this == other); }
 
-simple::string::pointer simple::string::data() const noexcept { return m_elem; }
+bool simple::string::operator!=(const char* other) const { return !(*this == other); }
 
-bool simple::string::operator==(const simple::string& other) const
+simple::string::value_type& simple::string::at(simple::size_type pos)
 {
-	if (m_size != other.m_size)
-		return false;
+	if (pos < size())
+		return data()[pos];
 
-	return !(std::memcmp(m_elem, other.m_elem, m_size));
+	throw std::out_of_range("Index out of range");
 }
 
-bool simple::string::operator==(const char* other) const { return !(std::strcmp(m_elem, other)); }
+const simple::string::value_type& simple::string::at(simple::size_type pos) const
+{
+	if (pos < size())
+		return data()[pos];
 
-bool simple::string::operator!=(const simple::string& other) const { return !(*this == other); }
+	throw std::out_of_range("Index out of range");
+}
 
-bool simple::string::operator!=(const char* other) const { return !(this->m_elem == other); }
+void simple::string::reserve(simple::size_type new_cap)
+{
+	if (capacity() < new_cap)
+		reallocate(new_cap);
+}
 
-simple::string::value_type& simple::string::operator[](simple::size_type pos) noexcept
+simple::size_type simple::string::max_size() noexcept
 {
-	return m_elem[pos];
+	// The tag takes the top byte of the capacity, and one character is kept
+	// for the terminating null.
+	return (size_type(1) << TAG_SHIFT) - 2;
 }
 
-const simple::string::value_type& simple::string::operator[](simple::size_type pos) const noexcept
+void simple::string::shrink_to_fit()
 {
-	return m_elem[pos];
+	if (!is_long())
+		return;
+
+	size_type size = this->size();
+
+	if (size > SHORT_CAPACITY)
+	{
+		if (long_capacity() > size)
+			reallocate(size);
+
+		return;
+	}
+
+	char* heap_data = m_rep.m_long.m_data;
+	std::memcpy(m_rep.m_short.m_data, heap_data, size);
+	set_short_size(size);
+	delete[] heap_data;
 }
 
-simple::string::value_type& simple::string::at(simple::size_type pos)
+void simple::string::clear() noexcept { set_size(0); }
+
+const char* simple::string::c_str() const { return data(); }
+
+void simple::string::push_back(char ch)
 {
-	if (pos < m_size)
-		return m_elem[pos];
+	size_type size = this->size();
 
-	throw std::out_of_range("Index out of range");
+	if (size == capacity())
+		reallocate(get_increased_capacity(size + 1));
+
+	data()[size] = ch;
+	set_size(size + 1);
 }
 
-const simple::string::value_type& simple::string::at(simple::size_type pos) const
+void simple::string::pop_back() { set_size(size() - 1); }
+
+simple::string& simple::string::append(const char* other, simple::size_type count)
 {
-	if (pos < m_size)
-		return m_elem[pos];
+	return insert(size(), other, count);
+}
 
-	throw std::out_of_range("Index out of range");
+simple::string& simple::string::append(const char* other) { return append(other, strlen(other)); }
+
+simple::string& simple::string::append(const simple::string& other)
+{
+	return append(other.data(), other.size());
 }
 
-void simple::string::reserve(simple::size_type new_cap)
+simple::string& simple::string::append(simple::string_view other)
 {
-	if (m_capacity < new_cap)
-		reallocate(new_cap);
+	return append(other.data(), other.size());
 }
 
-simple::size_type simple::string::capacity() const { return m_capacity; }
+simple::string& simple::string::append(simple::size_type count, char ch)
+{
+	return insert(size(), count, ch);
+}
 
-void simple::string::clear() noexcept
+simple::string& simple::string::insert(simple::size_type pos, const char* other,
+									   simple::size_type count)
 {
-	m_elem[0] = '\0';
-	m_size = 0;
+	if (pos > size())
+		throw std::out_of_range("Index out of range");
+
+	if (!count)
+		return *this;
+
+	// Growing would free the characters before they are copied.
+	if (points_into(other))
+	{
+		string copy(other, count);
+		std::memcpy(open_gap(pos, count), copy.data(), count);
+		return *this;
+	}
+
+	std::memcpy(open_gap(pos, count), other, count);
+	return *this;
 }
 
-const char* simple::string::c_str() const { return m_elem; }
+simple::string& simple::string::insert(simple::size_type pos, const char* other)
+{
+	return insert(pos, other, strlen(other));
+}
 
-void simple::string::push_back(char ch)
+simple::string& simple::string::insert(simple::size_type pos, const simple::string& other)
 {
-	if (m_size == m_capacity)
-		reallocate(get_increased_capacity());
+	return insert(pos, other.data(), other.size());
+}
 
-	m_elem[m_size] = ch;
-	m_size++;
-	m_elem[m_size] = '\0';
+simple::string& simple::string::insert(simple::size_type pos, simple::string_view other)
+{
+	return insert(pos, other.data(), other.size());
 }
 
-void simple::string::pop_back()
+simple::string& simple::string::insert(simple::size_type pos, simple::size_type count, char ch)
 {
-	m_elem[m_size - 1] = '\0';
-	m_size--;
+	if (pos > size())
+		throw std::out_of_range("Index out of range");
+
+	std::memset(open_gap(pos, count), ch, count);
+	return *this;
+}
+
+void simple::string::resize_uninitialized(simple::size_type count)
+{
+	grow_to(count);
+	set_size(count);
+}
+
+void simple::string::set_size(simple::size_type size) noexcept
+{
+	if (is_long())
+	{
+		m_rep.m_long.m_size = size;
+		m_rep.m_long.m_data[size] = '\0';
+	}
+
+	else
+		set_short_size(size);
+}
+
+void simple::string::set_short_size(simple::size_type size) noexcept
+{
+	// A full buffer stores zero here, which doubles as the terminator.
+	m_rep.m_short.m_data[SHORT_CAPACITY] = static_cast<char>(SHORT_CAPACITY - size);
+	m_rep.m_short.m_data[size] = '\0';
+}
+
+void simple::string::set_long(char* data, simple::size_type size,
+							  simple::size_type capacity) noexcept
+{
+	// Written directly rather than through set_size, whose short branch GCC
+	// cannot rule out here and reports as out of bounds at -O2.
+	m_rep.m_long.m_data = data;
+	m_rep.m_long.m_size = size;
+	m_rep.m_long.m_capacity = encode_capacity(capacity);
+	data[size] = '\0';
+}
+
+void simple::string::init(simple::size_type size)
+{
+	if (size <= SHORT_CAPACITY)
+		set_short_size(size);
+
+	else
+		set_long(create_string(size), size, size);
 }
 
 void simple::string::reallocate(simple::size_type new_cap)
 {
+	size_type size = this->size();
+
 	auto* tmp_string = create_string(new_cap);
-	std::memcpy(tmp_string, m_elem, m_size);
+	std::memcpy(tmp_string, data(), size);
 
 	delete_string();
-
-	m_elem = tmp_string;
-	m_elem[m_size] = '\0';
-	m_capacity = new_cap;
+	set_long(tmp_string, size, new_cap);
 }
 
-void simple::string::fit(simple::size_type new_cap)
+void simple::string::assign(const char* other, simple::size_type count)
 {
-	if (m_capacity < new_cap)
+	if (capacity() < count)
 	{
+		// Copied before the old buffer is freed, other may point into it.
+		auto* tmp_string = create_string(count);
+		std::memcpy(tmp_string, other, count);
+
 		delete_string();
-		m_elem = create_string(new_cap);
-		m_capacity = new_cap;
+		set_long(tmp_string, count, count);
+		return;
+	}
+
+	std::memmove(data(), other, count);
+	set_size(count);
+}
+
+void simple::string::grow_to(simple::size_type min_cap)
+{
+	if (capacity() >= min_cap)
+		return;
+
+	reallocate(get_increased_capacity(min_cap));
+}
+
+char* simple::string::open_gap(simple::size_type pos, simple::size_type count)
+{
+	size_type size = this->size();
+
+	if (count > max_size() - size)
+		throw std::length_error("String too long");
+
+	if (capacity() - size >= count)
+	{
+		char* chars = data();
+		std::memmove(chars + pos + count, chars + pos, size - pos);
+		set_size(size + count);
+		return chars + pos;
 	}
+
+	size_type new_cap = get_increased_capacity(size + count);
+	auto* tmp_string = create_string(new_cap);
+	std::memcpy(tmp_string, data(), pos);
+	std::memcpy(tmp_string + pos + count, data() + pos, size - pos);
+
+	delete_string();
+	set_long(tmp_string, size + count, new_cap);
+	return tmp_string + pos;
+}
+
+bool simple::string::points_into(const char* other) const noexcept
+{
+	std::less<const char*> less;
+	return !less(other, data()) && less(other, data() + size());
 }
 
-void simple::string::delete_string() { delete[] m_elem; }
+void simple::string::delete_string() noexcept
+{
+	if (is_long())
+		delete[] m_rep.m_long.m_data;
+}
 
 char* simple::string::create_string(simple::size_type size)
 {
+	if (size > max_size())
+		throw std::length_error("String too long");
+
 	auto* tmp = new char[size + 1];
 	tmp[size] = '\0';
 	return tmp;
 }
 
-simple::size_type simple::string::get_increased_capacity() const
+simple::size_type
+simple::string::get_increased_capacity(simple::size_type required) const noexcept
+{
+	return growth_policy::next_capacity(capacity(), required, sizeof(value_type));
+}
+
+simple::string simple::operator+(const simple::string& lhs, const simple::string& rhs)
+{
+	return concat(lhs, rhs);
+}
+
+simple::string simple::operator+(simple::string&& lhs, const simple::string& rhs)
+{
+	return std::move(lhs.append(rhs));
+}
+
+simple::string simple::operator+(const simple::string& lhs, const char* rhs)
+{
+	return concat(lhs, rhs);
+}
+
+simple::string simple::operator+(simple::string&& lhs, const char* rhs)
+{
+	return std::move(lhs.append(rhs));
+}
+
+simple::string simple::operator+(const char* lhs, const simple::string& rhs)
+{
+	return concat(lhs, rhs);
+}
+
+simple::string simple::operator+(const simple::string& lhs, char rhs)
+{
+	return concat(lhs, rhs);
+}
+
+simple::string simple::operator+(simple::string&& lhs, char rhs)
 {
-	return m_capacity * CAPACITY_INCREASE_FACTOR + 1;
+	lhs.push_back(rhs);
+	return std::move(lhs);
 }
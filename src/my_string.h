@@ -5,19 +5,32 @@
 #include <utility>
 #include <exception>
 #include <iostream>
+#include <type_traits>
 
+#include "growth_policy.h"
 #include "iterator.h"
+#include "string_view.h"
+#include "traits.h"
 
 namespace simple
 {
 
+// Strings of up to SHORT_CAPACITY characters are stored inline, without a heap
+// allocation. The last byte of the object tells the two layouts apart: an
+// inline string keeps SHORT_CAPACITY - size there, which becomes the
+// terminating null once the buffer is full, a heap string keeps LONG_TAG in
+// the highest byte of its capacity. Nothing points into the object itself, so
+// a string can still be relocated with memcpy.
 class string
 {
-	constexpr static std::size_t CAPACITY_INCREASE_FACTOR = 2;
-	constexpr static std::size_t STARTING_CAPACITY = 8;
-
 public:
 	using size_type = std::size_t;
+
+	constexpr static size_type SHORT_CAPACITY = 2 * sizeof(size_type) + sizeof(char*) - 1;
+
+	// string is not a template, so its policy is fixed here rather than
+	// passed in like vector's.
+	using growth_policy = default_growth;
 	using value_type = char;
 	using iterator = random_access_iterator<value_type>;
 	using pointer = value_type*;
@@ -26,7 +39,7 @@ public:
 	using iterator_category = std::random_access_iterator_tag;
 	using difference_type = std::ptrdiff_t;
 
-	string();
+	string() noexcept;
 
 	string(size_type count, char ch);
 
@@ -38,6 +51,8 @@ public:
 
 	string(const char* other, size_type count);
 
+	explicit string(string_view other);
+
 	string(std::nullptr_t) = delete;
 
 	string& operator=(string other);
@@ -48,10 +63,14 @@ public:
 
 	~string();
 
-	[[nodiscard]] bool empty() const;
+	[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+	[[nodiscard]] size_type size() const noexcept
+	{
+		return is_long() ? m_rep.m_long.m_size : SHORT_CAPACITY - short_remaining();
+	}
 
-	[[nodiscard]] size_type size() const;
-	[[nodiscard]] size_type length() const;
+	[[nodiscard]] size_type length() const noexcept { return size(); }
 
 	[[nodiscard]] iterator begin() const noexcept;
 
@@ -63,23 +82,16 @@ public:
 	[[nodiscard]] reference back() noexcept;
 	[[nodiscard]] const_reference back() const noexcept;
 
-	[[nodiscard]] pointer data() noexcept;
-	[[nodiscard]] pointer data() const noexcept;
-
-	void swap(string& other) noexcept
+	[[nodiscard]] pointer data() noexcept
 	{
-		size_type size_tmp = m_size;
-		m_size = other.m_size;
-		other.m_size = size_tmp;
+		return is_long() ? m_rep.m_long.m_data : m_rep.m_short.m_data;
+	}
 
-		char* elem_tmp = m_elem;
-		m_elem = other.m_elem;
-		other.m_elem = elem_tmp;
+	[[nodiscard]] pointer data() const noexcept { return const_cast<string*>(this)->data(); }
 
-		size_tmp = m_capacity;
-		m_capacity = other.m_capacity;
-		other.m_capacity = size_tmp;
-	}
+	operator string_view() const noexcept { return string_view(data(), size()); }
+
+	void swap(string& other) noexcept { std::swap(m_rep, other.m_rep); }
 
 	bool operator==(const string& other) const;
 
@@ -88,8 +100,8 @@ public:
 	bool operator!=(const string& other) const;
 	bool operator!=(const char* other) const;
 
-	reference operator[](size_type pos) noexcept;
-	const_reference operator[](size_type pos) const noexcept;
+	reference operator[](size_type pos) noexcept { return data()[pos]; }
+	const_reference operator[](size_type pos) const noexcept { return data()[pos]; }
 
 	[[nodiscard]] reference at(size_type pos);
 
@@ -99,7 +111,16 @@ public:
 
 	void reserve(size_type new_cap);
 
-	[[nodiscard]] size_type capacity() const;
+	[[nodiscard]] size_type capacity() const noexcept
+	{
+		return is_long() ? long_capacity() : SHORT_CAPACITY;
+	}
+
+	[[nodiscard]] static size_type max_size() noexcept;
+
+	// Gives the unused capacity back to the allocator, moving the characters
+	// back inline when they fit.
+	void shrink_to_fit();
 
 	void clear() noexcept;
 
@@ -109,28 +130,216 @@ public:
 
 	void pop_back();
 
+	// Appending grows the capacity geometrically, and copies other even if it
+	// points into this string.
+	string& append(const char* other, size_type count);
+	string& append(const char* other);
+	string& append(const string& other);
+	string& append(string_view other);
+	string& append(size_type count, char ch);
+
+	string& operator+=(const string& other) { return append(other); }
+	string& operator+=(const char* other) { return append(other); }
+	string& operator+=(string_view other) { return append(other); }
+
+	string& operator+=(char ch)
+	{
+		push_back(ch);
+		return *this;
+	}
+
+	// Inserts the characters before pos, throws std::out_of_range if pos is
+	// past the end.
+	string& insert(size_type pos, const char* other, size_type count);
+	string& insert(size_type pos, const char* other);
+	string& insert(size_type pos, const string& other);
+	string& insert(size_type pos, string_view other);
+	string& insert(size_type pos, size_type count, char ch);
+
+	// Grows or shrinks to count characters, new characters are left
+	// indeterminate so that a read() or recv() can write them directly.
+	void resize_uninitialized(size_type count);
+
+	// The characters are default-initialized, which for char is the same as
+	// leaving them uninitialized.
+	void resize_default_init(size_type count) { resize_uninitialized(count); }
+
+	// Makes room for count characters and calls op(data(), count), which
+	// writes the characters it wants to keep and returns how many there are,
+	// at most count. The characters past the current size are indeterminate
+	// when op is called.
+	template <class Operation>
+	void resize_and_overwrite(size_type count, Operation op)
+	{
+		grow_to(count);
+
+		set_size(std::move(op)(data(), count));
+	}
+
 	friend std::ostream& operator<<(std::ostream& os, const string& str)
 	{
-		os << str.m_elem;
+		os << str.c_str();
 		return os;
 	}
 
 private:
+	struct long_rep
+	{
+		char* m_data;
+		size_type m_size;
+		// The capacity with LONG_TAG in its last byte.
+		size_type m_capacity;
+	};
+
+	struct short_rep
+	{
+		// The last byte holds SHORT_CAPACITY - size.
+		char m_data[SHORT_CAPACITY + 1];
+	};
+
+	union rep
+	{
+		long_rep m_long;
+		short_rep m_short;
+	};
+
+	static_assert(sizeof(long_rep) == sizeof(short_rep), "The layouts must overlap exactly");
+
+	constexpr static unsigned char LONG_TAG = 0x80;
+
+	constexpr static unsigned TAG_SHIFT = 8 * (sizeof(size_type) - 1);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	// The last byte of the object is the lowest byte of the capacity.
+	[[nodiscard]] static constexpr size_type encode_capacity(size_type capacity) noexcept
+	{
+		return capacity << 8 | LONG_TAG;
+	}
+
+	[[nodiscard]] size_type long_capacity() const noexcept { return m_rep.m_long.m_capacity >> 8; }
+#else
+	// The last byte of the object is the highest byte of the capacity.
+	[[nodiscard]] static constexpr size_type encode_capacity(size_type capacity) noexcept
+	{
+		return capacity | size_type(LONG_TAG) << TAG_SHIFT;
+	}
+
+	[[nodiscard]] size_type long_capacity() const noexcept
+	{
+		return m_rep.m_long.m_capacity & ~(size_type(0xff) << TAG_SHIFT);
+	}
+#endif
+
+	[[nodiscard]] unsigned char short_remaining() const noexcept
+	{
+		return static_cast<unsigned char>(m_rep.m_short.m_data[SHORT_CAPACITY]);
+	}
+
+	[[nodiscard]] bool is_long() const noexcept { return short_remaining() & LONG_TAG; }
+
+	// Sets the size, which must fit the capacity, and terminates the string.
+	void set_size(size_type size) noexcept;
+
+	// Switches to the inline layout with size characters, which must already
+	// be in the buffer.
+	void set_short_size(size_type size) noexcept;
+
+	void set_long(char* data, size_type size, size_type capacity) noexcept;
+
+	// Makes room for size characters in a fresh string and sets the size.
+	void init(size_type size);
+
 	void reallocate(size_type new_cap);
 
-	void fit(size_type new_cap);
+	void assign(const char* other, size_type count);
+
+	void grow_to(size_type min_cap);
+
+	// Moves the characters from pos on count places back, reallocating if
+	// needed, and returns where the count new characters go.
+	[[nodiscard]] char* open_gap(size_type pos, size_type count);
 
-	void delete_string();
+	[[nodiscard]] bool points_into(const char* other) const noexcept;
+
+	void delete_string() noexcept;
 
 	[[nodiscard]] static char* create_string(size_type size);
 
-	[[nodiscard]] size_type get_increased_capacity() const;
+	[[nodiscard]] size_type get_increased_capacity(size_type required) const noexcept;
 
-	size_type m_size = 0;
-	char* m_elem;
-	size_type m_capacity = STARTING_CAPACITY;
+	rep m_rep {};
 };
 
+template <>
+struct is_trivially_relocatable<string> : std::true_type
+{
+};
+
+string operator+(const string& lhs, const string& rhs);
+string operator+(string&& lhs, const string& rhs);
+string operator+(const string& lhs, const char* rhs);
+string operator+(string&& lhs, const char* rhs);
+string operator+(const char* lhs, const string& rhs);
+string operator+(const string& lhs, char rhs);
+string operator+(string&& lhs, char rhs);
+
+namespace detail
+{
+
+inline string_view make_string_piece(string_view str) noexcept { return str; }
+
+// Only exactly char: any other type would convert to a temporary char that
+// is gone before the piece is read.
+template <class Char, std::enable_if_t<std::is_same_v<Char, char>, int> = 0>
+inline string_view make_string_piece(const Char& ch) noexcept
+{
+	return string_view(&ch, 1);
+}
+
+template <class Piece, class = void>
+constexpr bool is_string_piece_v = false;
+
+template <class Piece>
+constexpr bool is_string_piece_v<
+	Piece, std::void_t<decltype(make_string_piece(std::declval<const Piece&>()))>> = true;
+
+} // namespace detail
+
+// Concatenates strings, string views, C strings and characters into a new
+// string, which is allocated once with the total size.
+template <class... Pieces>
+string concat(const Pieces&... pieces)
+{
+	static_assert((detail::is_string_piece_v<Pieces> && ...),
+				  "concat takes strings, string views, C strings and chars");
+
+	string result;
+
+	if constexpr (sizeof...(Pieces) > 0)
+	{
+		const string_view parts[] = {detail::make_string_piece(pieces)...};
+
+		size_type total = 0;
+
+		for (string_view part : parts)
+			total += part.size();
+
+		result.reserve(total);
+		result.resize_uninitialized(total);
+		char* out = result.data();
+
+		for (string_view part : parts)
+		{
+			if (!part.empty())
+				std::memcpy(out, part.data(), part.size());
+
+			out += part.size();
+		}
+	}
+
+	return result;
+}
+
 } // namespace simple
 
 #endif // MY_STRING_H
@@ -0,0 +1,332 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace simple
+{
+
+// Slab allocator shared by every container that uses the same node type.
+// Nodes are carved out of CHUNK_SIZE aligned chunks, so the owning chunk of a
+// node is found by masking its address. Freed nodes are reused before the
+// chunk is bumped further, and a chunk is returned to the system as soon as
+// its last node is freed (one empty chunk is kept around to avoid thrashing).
+//
+// Each thread keeps up to 2 * CACHE_BATCH free slots of its own in front of
+// the chunks, so most allocations and frees touch no lock and no shared
+// memory. Slots move between a thread cache and the chunks CACHE_BATCH at a
+// time under the mutex, and a cache is handed back when its thread exits.
+// Cached slots count as used, so a chunk can stay allocated while another
+// thread still caches one of its slots.
+template <class Node>
+class node_pool
+{
+	struct free_slot
+	{
+		free_slot* next;
+	};
+
+	enum class cache_state : unsigned char
+	{
+		unregistered,
+		active,
+		exited
+	};
+
+	// Trivial, so that the fast paths read it without a guard or a call.
+	struct thread_cache
+	{
+		free_slot* head;
+		std::size_t count;
+		cache_state state;
+	};
+
+	// Hands the cache of its thread back to the pool when the thread exits.
+	struct cache_flusher
+	{
+		cache_flusher() = default;
+		cache_flusher(const cache_flusher& other) = delete;
+		cache_flusher& operator=(const cache_flusher& other) = delete;
+
+		~cache_flusher()
+		{
+			instance().drain(t_cache, t_cache.count);
+			t_cache.state = cache_state::exited;
+		}
+	};
+
+	struct chunk_header
+	{
+		chunk_header* prev = nullptr;
+		chunk_header* next = nullptr;
+		free_slot* free_list = nullptr;
+		std::size_t used = 0;
+		std::size_t bumped = 0;
+	};
+
+	constexpr static std::size_t round_up(std::size_t value, std::size_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	constexpr static std::size_t next_power_of_two(std::size_t value)
+	{
+		std::size_t result = 1;
+		while (result < value)
+			result *= 2;
+
+		return result;
+	}
+
+	constexpr static std::size_t MIN_CHUNK_SIZE = 64 * 1024;
+	constexpr static std::size_t MIN_SLOTS_PER_CHUNK = 16;
+	constexpr static std::size_t CACHE_BATCH = 32;
+
+	constexpr static std::size_t SLOT_ALIGN =
+		alignof(Node) > alignof(free_slot) ? alignof(Node) : alignof(free_slot);
+	constexpr static std::size_t SLOT_SIZE =
+		round_up(sizeof(Node) > sizeof(free_slot) ? sizeof(Node) : sizeof(free_slot), SLOT_ALIGN);
+	constexpr static std::size_t FIRST_SLOT_OFFSET = round_up(sizeof(chunk_header), SLOT_ALIGN);
+
+public:
+	using size_type = std::size_t;
+
+	constexpr static size_type CHUNK_SIZE =
+		next_power_of_two(FIRST_SLOT_OFFSET + SLOT_SIZE * MIN_SLOTS_PER_CHUNK) > MIN_CHUNK_SIZE
+			? next_power_of_two(FIRST_SLOT_OFFSET + SLOT_SIZE * MIN_SLOTS_PER_CHUNK)
+			: MIN_CHUNK_SIZE;
+	constexpr static size_type SLOTS_PER_CHUNK = (CHUNK_SIZE - FIRST_SLOT_OFFSET) / SLOT_SIZE;
+
+	node_pool(const node_pool& other) = delete;
+	node_pool(node_pool&& other) = delete;
+	node_pool& operator=(const node_pool& other) = delete;
+	node_pool& operator=(node_pool&& other) = delete;
+
+	// The pool is never destroyed, so containers with static storage duration
+	// can still free their nodes during program exit.
+	static node_pool& instance()
+	{
+		static node_pool* const pool = new node_pool();
+		return *pool;
+	}
+
+	[[nodiscard]] void* allocate()
+	{
+		thread_cache& cache = t_cache;
+
+		if (!cache.head)
+			return refill(cache);
+
+		free_slot* slot = cache.head;
+		cache.head = slot->next;
+		--cache.count;
+
+		return slot;
+	}
+
+	void deallocate(void* ptr) noexcept
+	{
+		if (!ptr)
+			return;
+
+		thread_cache& cache = t_cache;
+
+		if (!cache.head && !prepare(cache))
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			release_slot(ptr);
+			return;
+		}
+
+		auto* slot = static_cast<free_slot*>(ptr);
+		slot->next = cache.head;
+		cache.head = slot;
+
+		if (++cache.count == 2 * CACHE_BATCH)
+			drain(cache, CACHE_BATCH);
+	}
+
+	[[nodiscard]] size_type chunk_count() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_chunk_count;
+	}
+
+private:
+	node_pool() = default;
+
+	// Registers the thread cache for flushing on thread exit the first time
+	// it is used. Returns false once the thread is exiting and its cache has
+	// been flushed, after which the caller goes to the chunks directly.
+	static bool prepare(thread_cache& cache)
+	{
+		if (cache.state == cache_state::unregistered)
+		{
+			static thread_local cache_flusher flusher;
+			cache.state = cache_state::active;
+		}
+
+		return cache.state == cache_state::active;
+	}
+
+	// Takes a batch of slots from the chunks, returns one of them and keeps
+	// the rest in the cache. The slots go through the cache, so that none is
+	// lost if creating a chunk throws halfway.
+	void* refill(thread_cache& cache)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (!prepare(cache))
+			return take_slot();
+
+		for (; cache.count < CACHE_BATCH; ++cache.count)
+		{
+			auto* cached = static_cast<free_slot*>(take_slot());
+			cached->next = cache.head;
+			cache.head = cached;
+		}
+
+		free_slot* slot = cache.head;
+		cache.head = slot->next;
+		--cache.count;
+
+		return slot;
+	}
+
+	// Returns count slots from the top of the cache to the chunks.
+	void drain(thread_cache& cache, size_type count) noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (; count; --count)
+		{
+			free_slot* slot = cache.head;
+			cache.head = slot->next;
+			--cache.count;
+
+			release_slot(slot);
+		}
+	}
+
+	void* take_slot()
+	{
+		if (!m_available)
+		{
+			chunk_header* chunk = std::exchange(m_empty, nullptr);
+			if (!chunk)
+				chunk = create_chunk();
+
+			link_available(chunk);
+		}
+
+		chunk_header* chunk = m_available;
+		void* slot;
+
+		if (chunk->free_list)
+		{
+			slot = chunk->free_list;
+			chunk->free_list = chunk->free_list->next;
+		}
+
+		else
+			slot = slot_address(chunk, chunk->bumped++);
+
+		if (++chunk->used == SLOTS_PER_CHUNK)
+			unlink_available(chunk);
+
+		return slot;
+	}
+
+	void release_slot(void* ptr) noexcept
+	{
+		chunk_header* chunk = chunk_of(ptr);
+
+		auto* slot = static_cast<free_slot*>(ptr);
+		slot->next = chunk->free_list;
+		chunk->free_list = slot;
+
+		if (chunk->used-- == SLOTS_PER_CHUNK)
+			link_available(chunk);
+
+		if (chunk->used != 0)
+			return;
+
+		unlink_available(chunk);
+
+		if (m_empty)
+		{
+			destroy_chunk(chunk);
+			return;
+		}
+
+		chunk->free_list = nullptr;
+		chunk->bumped = 0;
+		m_empty = chunk;
+	}
+
+	chunk_header* create_chunk()
+	{
+		void* memory = ::operator new(CHUNK_SIZE, std::align_val_t(CHUNK_SIZE));
+		++m_chunk_count;
+
+		return new (memory) chunk_header();
+	}
+
+	void destroy_chunk(chunk_header* chunk) noexcept
+	{
+		chunk->~chunk_header();
+		::operator delete(chunk, std::align_val_t(CHUNK_SIZE));
+		--m_chunk_count;
+	}
+
+	void link_available(chunk_header* chunk) noexcept
+	{
+		chunk->prev = nullptr;
+		chunk->next = m_available;
+
+		if (m_available)
+			m_available->prev = chunk;
+
+		m_available = chunk;
+	}
+
+	void unlink_available(chunk_header* chunk) noexcept
+	{
+		if (chunk->prev)
+			chunk->prev->next = chunk->next;
+		else
+			m_available = chunk->next;
+
+		if (chunk->next)
+			chunk->next->prev = chunk->prev;
+
+		chunk->prev = nullptr;
+		chunk->next = nullptr;
+	}
+
+	[[nodiscard]] static void* slot_address(chunk_header* chunk, size_type index) noexcept
+	{
+		return reinterpret_cast<unsigned char*>(chunk) + FIRST_SLOT_OFFSET + index * SLOT_SIZE;
+	}
+
+	[[nodiscard]] static chunk_header* chunk_of(void* ptr) noexcept
+	{
+		auto address = reinterpret_cast<std::uintptr_t>(ptr);
+		return reinterpret_cast<chunk_header*>(address & ~(CHUNK_SIZE - 1));
+	}
+
+	static inline thread_local thread_cache t_cache {};
+
+	mutable std::mutex m_mutex;
+	chunk_header* m_available = nullptr;
+	chunk_header* m_empty = nullptr;
+	size_type m_chunk_count = 0;
+};
+
+} // namespace simple
+
+#endif // NODE_POOL_H
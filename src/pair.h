@@ -3,6 +3,8 @@
 
 #include <utility>
 
+#include "traits.h"
+
 namespace simple
 {
 
@@ -13,20 +15,20 @@ struct pair
 	pair(const pair& p) = default;
 	pair(pair&& p) noexcept = default;
 
-	pair(const T1& x, const T2& y) : first(x), second(y) {}
+	constexpr pair(const T1& x, const T2& y) : first(x), second(y) {}
 
 	template <class U1, class U2>
-	pair(U1&& x, U2&& y) : first(std::forward<U1>(x)), second(std::forward<U2>(y))
+	constexpr pair(U1&& x, U2&& y) : first(std::forward<U1>(x)), second(std::forward<U2>(y))
 	{
 	}
 
 	template <class U1, class U2>
-	pair(const pair<U1, U2>& p) : first(p.first), second(p.second)
+	constexpr pair(const pair<U1, U2>& p) : first(p.first), second(p.second)
 	{
 	}
 
 	template <class U1, class U2>
-	pair(pair<U1, U2>&& p) noexcept :
+	constexpr pair(pair<U1, U2>&& p) noexcept :
 		first(std::forward<U1>(p.first)), second(std::forward<U2>(p.second))
 	{
 	}
@@ -51,6 +53,12 @@ struct pair
 	T2 second;
 };
 
+template <class T1, class T2>
+struct is_trivially_relocatable<pair<T1, T2>>
+	: std::bool_constant<is_trivially_relocatable_v<T1> && is_trivially_relocatable_v<T2>>
+{
+};
+
 } // namespace simple
 
 #endif // PAIR_H
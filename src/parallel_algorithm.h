@@ -0,0 +1,555 @@
+#ifndef PARALLEL_ALGORITHM_H
+#define PARALLEL_ALGORITHM_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "thread_pool.h"
+#include "vector.h"
+
+namespace simple
+{
+
+// Execution policy for the parallel algorithms below, e.g.
+//
+//   simple::for_each(simple::parallel_policy(pool), v.begin(), v.end(), f);
+//
+// Ranges of at most serial_threshold elements are processed serially on the
+// calling thread. Larger ones are cut into contiguous chunks of at least
+// serial_threshold elements, a few per pool thread so that stealing evens out
+// chunks that take longer than others. Each task streams through one chunk,
+// so neighbouring elements stay on the same core.
+class parallel_policy
+{
+public:
+	constexpr static size_type DEFAULT_SERIAL_THRESHOLD = 1 << 14;
+	constexpr static size_type CHUNKS_PER_THREAD = 4;
+
+	explicit parallel_policy(thread_pool& pool,
+							 size_type serial_threshold = DEFAULT_SERIAL_THRESHOLD) noexcept :
+		m_pool(&pool), m_serial_threshold(serial_threshold ? serial_threshold : 1)
+	{
+	}
+
+	[[nodiscard]] thread_pool& pool() const noexcept { return *m_pool; }
+
+	[[nodiscard]] size_type serial_threshold() const noexcept { return m_serial_threshold; }
+
+	[[nodiscard]] bool is_serial(size_type count) const noexcept
+	{
+		return count <= m_serial_threshold;
+	}
+
+	// Elements per chunk when count elements are split across the pool.
+	[[nodiscard]] size_type chunk_size(size_type count) const noexcept
+	{
+		size_type chunks = m_pool->thread_count() * CHUNKS_PER_THREAD;
+		return std::max(m_serial_threshold, (count + chunks - 1) / chunks);
+	}
+
+private:
+	thread_pool* m_pool;
+	size_type m_serial_threshold;
+};
+
+namespace detail
+{
+
+// Value type of an iterator, also for the simple iterators, which have no
+// std::iterator_traits.
+template <class It>
+using iterator_value_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<It&>())>>;
+
+// Splits [0, count) into the policy's chunks.
+class chunking
+{
+public:
+	chunking(const parallel_policy& policy, size_type count) :
+		m_count(count), m_size(policy.chunk_size(count)), m_chunks((count + m_size - 1) / m_size)
+	{
+	}
+
+	[[nodiscard]] size_type chunks() const noexcept { return m_chunks; }
+
+	[[nodiscard]] size_type begin(size_type chunk) const noexcept { return chunk * m_size; }
+
+	[[nodiscard]] size_type end(size_type chunk) const noexcept
+	{
+		return std::min(begin(chunk) + m_size, m_count);
+	}
+
+private:
+	size_type m_count;
+	size_type m_size;
+	size_type m_chunks;
+};
+
+// Calls func(chunk, begin, end) for every chunk of [0, count) on the pool.
+template <class Func>
+void for_each_chunk(const parallel_policy& policy, const chunking& chunks, Func&& func)
+{
+	policy.pool().parallel_for(0, chunks.chunks(), 1, [&chunks, &func](size_type chunk) {
+		func(chunk, chunks.begin(chunk), chunks.end(chunk));
+	});
+}
+
+// Scans [first, last) into out, combining from carry when there is one.
+// Inclusive scans without a carry start from the first element, exclusive
+// scans always have one. Every input is read before its output is written, so
+// out may equal first.
+template <bool Inclusive, class T, class InputIt, class OutputIt, class BinaryOp>
+OutputIt serial_scan(InputIt first, InputIt last, OutputIt out, BinaryOp& op, const T* carry)
+{
+	if (first == last)
+		return out;
+
+	if constexpr (Inclusive)
+	{
+		T sum = carry ? op(*carry, *first) : T(*first);
+		*out = sum;
+
+		for (++first, ++out; first != last; ++first, ++out)
+		{
+			sum = op(std::move(sum), *first);
+			*out = sum;
+		}
+	}
+
+	else
+	{
+		T sum = *carry;
+
+		for (; first != last; ++first, ++out)
+		{
+			T next = op(sum, *first);
+			*out = std::move(sum);
+			sum = std::move(next);
+		}
+	}
+
+	return out;
+}
+
+// Three passes: every chunk but the last is reduced in parallel, the chunk
+// sums are combined serially into the carry of each chunk, then the chunks
+// are scanned in parallel starting from their carries.
+template <bool Inclusive, class T, class RandomIt, class OutputIt, class BinaryOp>
+OutputIt scan(const parallel_policy& policy, RandomIt first, RandomIt last, OutputIt out,
+			  BinaryOp op, const T* init)
+{
+	auto count = static_cast<size_type>(last - first);
+
+	if (policy.is_serial(count))
+		return serial_scan<Inclusive>(first, last, out, op, init);
+
+	chunking chunks(policy, count);
+	vector<T> carries(chunks.chunks());
+
+	for_each_chunk(policy, chunks, [&](size_type chunk, size_type begin, size_type end) {
+		if (chunk + 1 == chunks.chunks())
+			return;
+
+		T sum = first[begin];
+
+		for (size_type i = begin + 1; i < end; ++i)
+			sum = op(std::move(sum), first[i]);
+
+		carries[chunk + 1] = std::move(sum);
+	});
+
+	if (init)
+		carries[1] = op(*init, carries[1]);
+
+	for (size_type chunk = 2; chunk < chunks.chunks(); ++chunk)
+		carries[chunk] = op(carries[chunk - 1], carries[chunk]);
+
+	if (init)
+		carries[0] = *init;
+
+	for_each_chunk(policy, chunks, [&](size_type chunk, size_type begin, size_type end) {
+		const T* carry = chunk || init ? &carries[chunk] : nullptr;
+		serial_scan<Inclusive>(first + begin, first + end, out + begin, op, carry);
+	});
+
+	return out + count;
+}
+
+// Finds how many of the first k elements of the stable merge of [a, a +
+// a_count) and [b, b + b_count) come from a.
+template <class T, class Compare>
+size_type merge_split(const T* a, size_type a_count, const T* b, size_type b_count, size_type k,
+					  Compare& comp)
+{
+	size_type low = k > b_count ? k - b_count : 0;
+	size_type high = std::min(k, a_count);
+
+	while (low < high)
+	{
+		size_type i = low + (high - low) / 2;
+		size_type j = k - i;
+
+		// a[i] is merged before b[j - 1], so more than i come from a.
+		if (j > 0 && !comp(b[j - 1], a[i]))
+			low = i + 1;
+
+		else
+			high = i;
+	}
+
+	return low;
+}
+
+// Merges the sorted runs of width elements in [source, source + count)
+// pairwise into destination. Each pair is cut into pieces of the policy's
+// chunk size, which are merged independently, so the last rounds, with few
+// long runs, still use every thread. The merges move from source, so where
+// each piece starts in both runs is found before any piece is merged.
+template <class T, class Compare>
+void merge_runs(const parallel_policy& policy, T* source, T* destination, size_type count,
+				size_type width, Compare& comp)
+{
+	size_type piece = policy.chunk_size(count);
+	size_type pair_width = 2 * width;
+	size_type pairs = (count + pair_width - 1) / pair_width;
+	size_type pieces_per_pair = (pair_width + piece - 1) / piece;
+
+	struct piece_bounds
+	{
+		size_type pair_begin;
+		size_type middle;
+		size_type pair_end;
+		size_type begin;
+		size_type end;
+	};
+
+	auto bounds = [&](size_type task) {
+		size_type pair_begin = task / pieces_per_pair * pair_width;
+		size_type pair_end = std::min(pair_begin + pair_width, count);
+		size_type begin = std::min(pair_begin + task % pieces_per_pair * piece, pair_end);
+
+		return piece_bounds {pair_begin, std::min(pair_begin + width, count), pair_end, begin,
+							 std::min(begin + piece, pair_end)};
+	};
+
+	// a_splits[task] elements of the first run are merged before the task's
+	// piece.
+	vector<size_type> a_splits(pairs * pieces_per_pair);
+
+	policy.pool().parallel_for(0, a_splits.size(), 1, [&](size_type task) {
+		piece_bounds span = bounds(task);
+
+		a_splits[task] = merge_split(source + span.pair_begin, span.middle - span.pair_begin,
+									 source + span.middle, span.pair_end - span.middle,
+									 span.begin - span.pair_begin, comp);
+	});
+
+	policy.pool().parallel_for(0, a_splits.size(), 1, [&](size_type task) {
+		piece_bounds span = bounds(task);
+
+		if (span.begin == span.end)
+			return;
+
+		bool is_last_piece = (task + 1) % pieces_per_pair == 0;
+
+		size_type a_begin = a_splits[task];
+		size_type a_end = is_last_piece ? span.middle - span.pair_begin : a_splits[task + 1];
+		size_type b_begin = span.begin - span.pair_begin - a_begin;
+		size_type b_end = span.end - span.pair_begin - a_end;
+
+		T* a = source + span.pair_begin;
+		T* b = source + span.middle;
+
+		std::merge(std::make_move_iterator(a + a_begin), std::make_move_iterator(a + a_end),
+				   std::make_move_iterator(b + b_begin),
+				   std::make_move_iterator(b + b_end), destination + span.begin, comp);
+	});
+}
+
+// Moves [source, source + count) onto destination in parallel.
+template <class T>
+void parallel_move(const parallel_policy& policy, T* source, T* destination, size_type count)
+{
+	chunking chunks(policy, count);
+
+	for_each_chunk(policy, chunks, [&](size_type, size_type begin, size_type end) {
+		std::move(source + begin, source + end, destination + begin);
+	});
+}
+
+} // namespace detail
+
+template <class RandomIt, class UnaryFunc>
+void for_each(const parallel_policy& policy, RandomIt first, RandomIt last, UnaryFunc func)
+{
+	auto count = static_cast<size_type>(last - first);
+
+	if (policy.is_serial(count))
+	{
+		for (; first != last; ++first)
+			func(*first);
+
+		return;
+	}
+
+	detail::chunking chunks(policy, count);
+
+	detail::for_each_chunk(policy, chunks, [&](size_type, size_type begin, size_type end) {
+		for (RandomIt it = first + begin, chunk_last = first + end; it != chunk_last; ++it)
+			func(*it);
+	});
+}
+
+template <class RandomIt, class OutputIt, class UnaryOp>
+OutputIt transform(const parallel_policy& policy, RandomIt first, RandomIt last, OutputIt out,
+				   UnaryOp op)
+{
+	auto count = static_cast<size_type>(last - first);
+
+	if (policy.is_serial(count))
+	{
+		for (; first != last; ++first, ++out)
+			*out = op(*first);
+
+		return out;
+	}
+
+	detail::chunking chunks(policy, count);
+
+	detail::for_each_chunk(policy, chunks, [&](size_type, size_type begin, size_type end) {
+		OutputIt chunk_out = out + begin;
+
+		for (RandomIt it = first + begin, chunk_last = first + end; it != chunk_last; ++it)
+			*chunk_out++ = op(*it);
+	});
+
+	return out + count;
+}
+
+template <class RandomIt1, class RandomIt2, class OutputIt, class BinaryOp>
+OutputIt transform(const parallel_policy& policy, RandomIt1 first1, RandomIt1 last1,
+				   RandomIt2 first2, OutputIt out, BinaryOp op)
+{
+	auto count = static_cast<size_type>(last1 - first1);
+
+	if (policy.is_serial(count))
+	{
+		for (; first1 != last1; ++first1, ++first2, ++out)
+			*out = op(*first1, *first2);
+
+		return out;
+	}
+
+	detail::chunking chunks(policy, count);
+
+	detail::for_each_chunk(policy, chunks, [&](size_type, size_type begin, size_type end) {
+		for (size_type i = begin; i < end; ++i)
+			out[i] = op(first1[i], first2[i]);
+	});
+
+	return out + count;
+}
+
+// op must be associative and commutative, the chunks are reduced in parallel
+// and their sums are combined in chunk order.
+template <class RandomIt, class T, class BinaryOp>
+T reduce(const parallel_policy& policy, RandomIt first, RandomIt last, T init, BinaryOp op)
+{
+	auto count = static_cast<size_type>(last - first);
+
+	if (policy.is_serial(count))
+	{
+		for (; first != last; ++first)
+			init = op(std::move(init), *first);
+
+		return init;
+	}
+
+	detail::chunking chunks(policy, count);
+	vector<T> sums(chunks.chunks());
+
+	detail::for_each_chunk(policy, chunks, [&](size_type chunk, size_type begin, size_type end) {
+		T sum = first[begin];
+
+		for (size_type i = begin + 1; i < end; ++i)
+			sum = op(std::move(sum), first[i]);
+
+		sums[chunk] = std::move(sum);
+	});
+
+	for (T& sum : sums)
+		init = op(std::move(init), sum);
+
+	return init;
+}
+
+template <class RandomIt, class T>
+T reduce(const parallel_policy& policy, RandomIt first, RandomIt last, T init)
+{
+	return simple::reduce(policy, first, last, std::move(init), std::plus<>());
+}
+
+template <class RandomIt>
+detail::iterator_value_t<RandomIt> reduce(const parallel_policy& policy, RandomIt first,
+										  RandomIt last)
+{
+	return simple::reduce(policy, first, last, detail::iterator_value_t<RandomIt>());
+}
+
+// out[i] = first[0] op ... op first[i]. op must be associative. out may be
+// first.
+template <class RandomIt, class OutputIt, class BinaryOp>
+OutputIt inclusive_scan(const parallel_policy& policy, RandomIt first, RandomIt last,
+						OutputIt out, BinaryOp op)
+{
+	using value_type = detail::iterator_value_t<RandomIt>;
+	return detail::scan<true, value_type>(policy, first, last, out, op, nullptr);
+}
+
+template <class RandomIt, class OutputIt, class BinaryOp, class T>
+OutputIt inclusive_scan(const parallel_policy& policy, RandomIt first, RandomIt last,
+						OutputIt out, BinaryOp op, T init)
+{
+	return detail::scan<true, T>(policy, first, last, out, op, &init);
+}
+
+template <class RandomIt, class OutputIt>
+OutputIt inclusive_scan(const parallel_policy& policy, RandomIt first, RandomIt last,
+						OutputIt out)
+{
+	return simple::inclusive_scan(policy, first, last, out, std::plus<>());
+}
+
+// out[i] = init op first[0] op ... op first[i - 1]. op must be associative.
+// out may be first.
+template <class RandomIt, class OutputIt, class T, class BinaryOp>
+OutputIt exclusive_scan(const parallel_policy& policy, RandomIt first, RandomIt last,
+						OutputIt out, T init, BinaryOp op)
+{
+	return detail::scan<false, T>(policy, first, last, out, op, &init);
+}
+
+template <class RandomIt, class OutputIt, class T>
+OutputIt exclusive_scan(const parallel_policy& policy, RandomIt first, RandomIt last,
+						OutputIt out, T init)
+{
+	return simple::exclusive_scan(policy, first, last, out, std::move(init), std::plus<>());
+}
+
+// Stable merge sort over a contiguous range, e.g. of a simple::vector. The
+// chunks are sorted in parallel, then merged pairwise through a buffer of
+// the same size, with every merge split across the pool. The buffer is a
+// simple::vector<T>, so T must be default constructible.
+template <class RandomIt, class Compare>
+void sort(const parallel_policy& policy, RandomIt first, RandomIt last, Compare comp)
+{
+	using value_type = detail::iterator_value_t<RandomIt>;
+
+	auto count = static_cast<size_type>(last - first);
+
+	if (count == 0)
+		return;
+
+	value_type* data = &*first;
+
+	if (policy.is_serial(count))
+	{
+		std::stable_sort(data, data + count, comp);
+		return;
+	}
+
+	detail::chunking chunks(policy, count);
+
+	detail::for_each_chunk(policy, chunks, [&](size_type, size_type begin, size_type end) {
+		std::stable_sort(data + begin, data + end, comp);
+	});
+
+	if (chunks.chunks() == 1)
+		return;
+
+	vector<value_type> buffer;
+	buffer.resize_default_init(count);
+
+	value_type* source = data;
+	value_type* destination = buffer.data();
+
+	for (size_type width = policy.chunk_size(count); width < count; width *= 2)
+	{
+		detail::merge_runs(policy, source, destination, count, width, comp);
+		std::swap(source, destination);
+	}
+
+	if (source != data)
+		detail::parallel_move(policy, source, data, count);
+}
+
+template <class RandomIt>
+void sort(const parallel_policy& policy, RandomIt first, RandomIt last)
+{
+	simple::sort(policy, first, last, std::less<>());
+}
+
+// Stable partition of a contiguous range: the elements for which pred is
+// true are moved before the others, both groups keep their order. Returns
+// the first element of the second group. pred is called twice per element,
+// once to count each chunk's true elements and once to scatter them through
+// a buffer, which needs T to be default constructible.
+template <class RandomIt, class UnaryPredicate>
+RandomIt partition(const parallel_policy& policy, RandomIt first, RandomIt last,
+				   UnaryPredicate pred)
+{
+	using value_type = detail::iterator_value_t<RandomIt>;
+
+	auto count = static_cast<size_type>(last - first);
+
+	if (count == 0)
+		return first;
+
+	value_type* data = &*first;
+
+	if (policy.is_serial(count))
+	{
+		value_type* point = std::stable_partition(data, data + count, pred);
+		return first + static_cast<size_type>(point - data);
+	}
+
+	detail::chunking chunks(policy, count);
+	vector<size_type> true_offsets(chunks.chunks() + 1);
+
+	detail::for_each_chunk(policy, chunks, [&](size_type chunk, size_type begin, size_type end) {
+		true_offsets[chunk + 1] =
+			static_cast<size_type>(std::count_if(data + begin, data + end, pred));
+	});
+
+	for (size_type chunk = 1; chunk <= chunks.chunks(); ++chunk)
+		true_offsets[chunk] += true_offsets[chunk - 1];
+
+	size_type true_count = true_offsets[chunks.chunks()];
+
+	vector<value_type> buffer;
+	buffer.resize_default_init(count);
+
+	detail::for_each_chunk(policy, chunks, [&](size_type chunk, size_type begin, size_type end) {
+		value_type* true_out = buffer.data() + true_offsets[chunk];
+		value_type* false_out = buffer.data() + true_count + (begin - true_offsets[chunk]);
+
+		for (value_type* it = data + begin; it != data + end; ++it)
+		{
+			if (pred(*it))
+				*true_out++ = std::move(*it);
+
+			else
+				*false_out++ = std::move(*it);
+		}
+	});
+
+	detail::parallel_move(policy, buffer.data(), data, count);
+
+	return first + true_count;
+}
+
+} // namespace simple
+
+#endif // PARALLEL_ALGORITHM_H
@@ -0,0 +1,314 @@
+#include "rope.h"
+
+#include <cstring>
+#include <stdexcept>
+
+simple::rope::chunk_iterator::chunk_iterator(const node* root)
+{
+	if (root)
+		descend_left(root);
+}
+
+simple::rope::chunk_iterator& simple::rope::chunk_iterator::operator++()
+{
+	m_path.pop_back();
+	++m_index;
+
+	while (!m_path.empty())
+	{
+		step& parent = m_path.back();
+
+		if (!parent.m_in_right)
+		{
+			parent.m_in_right = true;
+			descend_left(parent.m_node->m_right.get());
+			return *this;
+		}
+
+		m_path.pop_back();
+	}
+
+	return *this;
+}
+
+void simple::rope::chunk_iterator::descend_left(const node* current)
+{
+	for (;;)
+	{
+		m_path.push_back(step {current, false});
+
+		if (current->is_leaf())
+			return;
+
+		current = current->m_left.get();
+	}
+}
+
+simple::rope::rope(simple::string str)
+{
+	size_type size = str.size();
+
+	if (size)
+		m_root = make_leaf(make_shared<string>(std::move(str)), 0, size);
+}
+
+simple::rope::rope(simple::string_view str) : rope(string(str)) {}
+
+simple::rope& simple::rope::append(const simple::rope& other)
+{
+	m_root = join(m_root, other.m_root);
+	return *this;
+}
+
+simple::rope& simple::rope::append(simple::string str) { return append(rope(std::move(str))); }
+
+simple::rope& simple::rope::append(simple::string_view str) { return append(rope(str)); }
+
+simple::rope& simple::rope::prepend(const simple::rope& other)
+{
+	m_root = join(other.m_root, m_root);
+	return *this;
+}
+
+simple::rope simple::rope::substr(simple::size_type pos, simple::size_type count) const
+{
+	if (pos > size())
+		throw std::out_of_range("Index out of range");
+
+	node_ptr tail = split(m_root, pos).second;
+	return rope(split(tail, count).first);
+}
+
+simple::rope& simple::rope::insert(simple::size_type pos, const simple::rope& other)
+{
+	if (pos > size())
+		throw std::out_of_range("Index out of range");
+
+	auto parts = split(m_root, pos);
+	m_root = join(join(std::move(parts.first), other.m_root), std::move(parts.second));
+	return *this;
+}
+
+simple::rope& simple::rope::erase(simple::size_type pos, simple::size_type count)
+{
+	if (pos > size())
+		throw std::out_of_range("Index out of range");
+
+	auto parts = split(m_root, pos);
+	m_root = join(std::move(parts.first), split(parts.second, count).second);
+	return *this;
+}
+
+char simple::rope::operator[](simple::size_type pos) const noexcept
+{
+	const node* current = m_root.get();
+
+	while (!current->is_leaf())
+	{
+		size_type left_size = current->m_left->m_size;
+
+		if (pos < left_size)
+			current = current->m_left.get();
+
+		else
+		{
+			pos -= left_size;
+			current = current->m_right.get();
+		}
+	}
+
+	return current->text()[pos];
+}
+
+char simple::rope::at(simple::size_type pos) const
+{
+	if (pos >= size())
+		throw std::out_of_range("Index out of range");
+
+	return (*this)[pos];
+}
+
+simple::string simple::rope::to_string() const
+{
+	string result;
+	result.reserve(size());
+	result.resize_uninitialized(size());
+
+	char* out = result.data();
+
+	for (string_view chunk : chunks())
+	{
+		std::memcpy(out, chunk.data(), chunk.size());
+		out += chunk.size();
+	}
+
+	return result;
+}
+
+bool simple::rope::equals(simple::string_view other) const
+{
+	if (size() != other.size())
+		return false;
+
+	size_type offset = 0;
+
+	for (string_view chunk : chunks())
+	{
+		if (chunk != other.substr(offset, chunk.size()))
+			return false;
+
+		offset += chunk.size();
+	}
+
+	return true;
+}
+
+simple::rope::node_ptr simple::rope::make_leaf(simple::shared_ptr<simple::string> chunk,
+											   simple::size_type offset, simple::size_type size)
+{
+	shared_ptr<node> leaf = make_shared<node>();
+	leaf->m_chunk = std::move(chunk);
+	leaf->m_offset = offset;
+	leaf->m_size = size;
+
+	return leaf;
+}
+
+simple::rope::node_ptr simple::rope::make_concat(node_ptr left, node_ptr right)
+{
+	shared_ptr<node> concat = make_shared<node>();
+	concat->m_size = left->m_size + right->m_size;
+	concat->m_leaf_count = left->m_leaf_count + right->m_leaf_count;
+	concat->m_height = 1 + (left->m_height > right->m_height ? left->m_height : right->m_height);
+	concat->m_left = std::move(left);
+	concat->m_right = std::move(right);
+
+	return concat;
+}
+
+simple::rope::node_ptr simple::rope::balance(node_ptr left, node_ptr right)
+{
+	if (height(left) > height(right) + 1)
+	{
+		if (height(left->m_left) >= height(left->m_right))
+			return make_concat(left->m_left, make_concat(left->m_right, std::move(right)));
+
+		const node_ptr& middle = left->m_right;
+		return make_concat(make_concat(left->m_left, middle->m_left),
+						   make_concat(middle->m_right, std::move(right)));
+	}
+
+	if (height(right) > height(left) + 1)
+	{
+		if (height(right->m_right) >= height(right->m_left))
+			return make_concat(make_concat(std::move(left), right->m_left), right->m_right);
+
+		const node_ptr& middle = right->m_left;
+		return make_concat(make_concat(std::move(left), middle->m_left),
+						   make_concat(middle->m_right, right->m_right));
+	}
+
+	return make_concat(std::move(left), std::move(right));
+}
+
+simple::rope::node_ptr simple::rope::join(node_ptr left, node_ptr right)
+{
+	if (!left)
+		return right;
+
+	if (!right)
+		return left;
+
+	// A small leaf goes all the way down to the leaf next to it, so that the
+	// two can be merged.
+	if (height(left) > height(right) + 1 || (is_small_leaf(right) && !left->is_leaf()))
+		return join_right(left, std::move(right));
+
+	if (height(right) > height(left) + 1 || (is_small_leaf(left) && !right->is_leaf()))
+		return join_left(std::move(left), right);
+
+	return merge_or_concat(std::move(left), std::move(right));
+}
+
+simple::rope::node_ptr simple::rope::join_right(const node_ptr& left, node_ptr right)
+{
+	const node_ptr& middle = left->m_right;
+	node_ptr joined;
+
+	if (height(middle) <= height(right) + 1 && !(is_small_leaf(right) && !middle->is_leaf()))
+		joined = merge_or_concat(middle, std::move(right));
+
+	else
+		joined = join_right(middle, std::move(right));
+
+	return balance(left->m_left, std::move(joined));
+}
+
+simple::rope::node_ptr simple::rope::join_left(node_ptr left, const node_ptr& right)
+{
+	const node_ptr& middle = right->m_left;
+	node_ptr joined;
+
+	if (height(middle) <= height(left) + 1 && !(is_small_leaf(left) && !middle->is_leaf()))
+		joined = merge_or_concat(std::move(left), middle);
+
+	else
+		joined = join_left(std::move(left), middle);
+
+	return balance(std::move(joined), right->m_right);
+}
+
+simple::rope::node_ptr simple::rope::merge_or_concat(node_ptr left, node_ptr right)
+{
+	if (!left->is_leaf() || !right->is_leaf() || left->m_size + right->m_size > LEAF_MERGE_LIMIT)
+		return make_concat(std::move(left), std::move(right));
+
+	string& chunk = *left->m_chunk;
+	size_type size = left->m_size + right->m_size;
+
+	// Nothing refers to the characters past the end of the chunk, so if the
+	// left leaf ends there they can be written without copying the leaf.
+	if (left->m_offset + left->m_size == chunk.size() &&
+		chunk.capacity() - chunk.size() >= right->m_size)
+	{
+		chunk.append(right->text());
+		return make_leaf(left->m_chunk, left->m_offset, size);
+	}
+
+	string merged;
+	merged.reserve(LEAF_MERGE_LIMIT);
+	merged.append(left->text());
+	merged.append(right->text());
+
+	return make_leaf(make_shared<string>(std::move(merged)), 0, size);
+}
+
+simple::pair<simple::rope::node_ptr, simple::rope::node_ptr>
+simple::rope::split(const node_ptr& tree, simple::size_type pos)
+{
+	if (!tree || pos == 0)
+		return {node_ptr(), tree};
+
+	if (pos >= tree->m_size)
+		return {tree, node_ptr()};
+
+	if (tree->is_leaf())
+		return {make_leaf(tree->m_chunk, tree->m_offset, pos),
+				make_leaf(tree->m_chunk, tree->m_offset + pos, tree->m_size - pos)};
+
+	size_type left_size = tree->m_left->m_size;
+
+	if (pos < left_size)
+	{
+		auto parts = split(tree->m_left, pos);
+		return {std::move(parts.first), join(std::move(parts.second), tree->m_right)};
+	}
+
+	if (pos > left_size)
+	{
+		auto parts = split(tree->m_right, pos - left_size);
+		return {join(tree->m_left, std::move(parts.first)), std::move(parts.second)};
+	}
+
+	return {tree->m_left, tree->m_right};
+}
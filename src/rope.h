@@ -0,0 +1,238 @@
+#ifndef ROPE_H
+#define ROPE_H
+
+#include <cstddef>
+#include <iterator>
+
+#include "my_string.h"
+#include "pair.h"
+#include "shared_ptr.h"
+#include "small_vector.h"
+#include "string_view.h"
+
+namespace simple
+{
+
+namespace detail
+{
+
+// A node of a rope is immutable once built, so that ropes can share it. A
+// leaf refers to m_size characters of a shared chunk from m_offset on, a
+// concatenation has a left and a right child and no chunk. Characters may be
+// appended to a chunk in place, past the ranges of all leaves and within its
+// capacity, but the characters a leaf refers to never change.
+struct rope_node
+{
+	shared_ptr<const rope_node> m_left;
+	shared_ptr<const rope_node> m_right;
+	shared_ptr<string> m_chunk;
+	size_type m_offset = 0;
+	size_type m_size = 0;
+	size_type m_leaf_count = 1;
+	int m_height = 1;
+
+	[[nodiscard]] bool is_leaf() const noexcept { return !m_left; }
+
+	[[nodiscard]] string_view text() const noexcept
+	{
+		return string_view(m_chunk->data() + m_offset, m_size);
+	}
+};
+
+} // namespace detail
+
+// A string kept as an AVL-balanced tree of shared, immutable chunks, for
+// large texts that are built by concatenation. Concatenation, substr, insert
+// and erase are O(log n) in the number of chunks and copy no characters,
+// apart from merging small chunks into one; substr keeps referring to the
+// original chunks. Reading a character is O(log n) as well.
+//
+// Copying a rope shares the whole tree. The reference counts of
+// simple::shared_ptr are not atomic, so ropes that share nodes must stay on
+// one thread.
+class rope
+{
+public:
+	using size_type = simple::size_type;
+
+private:
+	using node = detail::rope_node;
+	using node_ptr = shared_ptr<const node>;
+
+	// Adjacent leaves that are together no larger than this are merged, so
+	// that appending many small pieces does not make a leaf for each. A
+	// merged chunk reserves this much, so that the next small pieces can be
+	// appended to it in place instead of copying the leaf again.
+	constexpr static size_type LEAF_MERGE_LIMIT = 256;
+
+	constexpr static size_type INLINE_STACK_DEPTH = 48;
+
+public:
+	constexpr static size_type npos = static_cast<size_type>(-1);
+
+	// Iterates over the chunks in order as string_views, for example to fill
+	// the iovec array of a writev call. The rope must not change while its
+	// chunks are iterated.
+	class chunk_iterator
+	{
+	public:
+		using value_type = string_view;
+		using reference = string_view;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::input_iterator_tag;
+
+		chunk_iterator() = default;
+		explicit chunk_iterator(const node* root);
+
+		reference operator*() const { return m_path.back().m_node->text(); }
+
+		chunk_iterator& operator++();
+
+		chunk_iterator operator++(int)
+		{
+			chunk_iterator it(*this);
+			++*this;
+			return it;
+		}
+
+		friend bool operator==(const chunk_iterator& lhs, const chunk_iterator& rhs)
+		{
+			if (lhs.m_path.empty() || rhs.m_path.empty())
+				return lhs.m_path.empty() == rhs.m_path.empty();
+
+			return lhs.m_index == rhs.m_index;
+		}
+
+		friend bool operator!=(const chunk_iterator& lhs, const chunk_iterator& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+	private:
+		struct step
+		{
+			const node* m_node;
+			bool m_in_right;
+		};
+
+		void descend_left(const node* current);
+
+		// The nodes from the root to the current leaf. The two children of a
+		// node can be the same node, so the path records which one it took.
+		small_vector<step, INLINE_STACK_DEPTH> m_path;
+		size_type m_index = 0;
+	};
+
+	class chunk_range
+	{
+	public:
+		explicit chunk_range(node_ptr root) : m_root(std::move(root)) {}
+
+		[[nodiscard]] chunk_iterator begin() const { return chunk_iterator(m_root.get()); }
+		[[nodiscard]] chunk_iterator end() const { return chunk_iterator(); }
+
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_root ? m_root->m_leaf_count : 0;
+		}
+
+	private:
+		node_ptr m_root;
+	};
+
+	rope() = default;
+
+	// Takes over the characters of str as a single chunk.
+	explicit rope(string str);
+
+	explicit rope(string_view str);
+
+	explicit rope(const char* str) : rope(string_view(str)) {}
+
+	[[nodiscard]] size_type size() const noexcept { return m_root ? m_root->m_size : 0; }
+	[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+	rope& append(const rope& other);
+	rope& append(string str);
+	rope& append(string_view str);
+	rope& append(const char* str) { return append(string_view(str)); }
+
+	rope& prepend(const rope& other);
+
+	rope& operator+=(const rope& other) { return append(other); }
+	rope& operator+=(string str) { return append(std::move(str)); }
+	rope& operator+=(string_view str) { return append(str); }
+	rope& operator+=(const char* str) { return append(str); }
+
+	friend rope operator+(const rope& lhs, const rope& rhs)
+	{
+		return rope(join(lhs.m_root, rhs.m_root));
+	}
+
+	// Throws std::out_of_range if pos is past the end.
+	[[nodiscard]] rope substr(size_type pos, size_type count = npos) const;
+
+	rope& insert(size_type pos, const rope& other);
+
+	rope& erase(size_type pos, size_type count = npos);
+
+	[[nodiscard]] char operator[](size_type pos) const noexcept;
+	[[nodiscard]] char at(size_type pos) const;
+
+	// The number of chunks, and so of the iovec entries a writev needs.
+	[[nodiscard]] size_type chunk_count() const noexcept
+	{
+		return m_root ? m_root->m_leaf_count : 0;
+	}
+
+	[[nodiscard]] chunk_range chunks() const { return chunk_range(m_root); }
+
+	// Copies the characters into one string, allocated once.
+	[[nodiscard]] string to_string() const;
+
+	friend bool operator==(const rope& lhs, string_view rhs) { return lhs.equals(rhs); }
+	friend bool operator!=(const rope& lhs, string_view rhs) { return !lhs.equals(rhs); }
+
+private:
+	explicit rope(node_ptr root) noexcept : m_root(std::move(root)) {}
+
+	[[nodiscard]] bool equals(string_view other) const;
+
+	[[nodiscard]] static int height(const node_ptr& tree) noexcept
+	{
+		return tree ? tree->m_height : 0;
+	}
+
+	[[nodiscard]] static bool is_small_leaf(const node_ptr& tree) noexcept
+	{
+		return tree && tree->is_leaf() && tree->m_size < LEAF_MERGE_LIMIT;
+	}
+
+	[[nodiscard]] static node_ptr make_leaf(shared_ptr<string> chunk, size_type offset,
+											size_type size);
+
+	[[nodiscard]] static node_ptr make_concat(node_ptr left, node_ptr right);
+
+	// Concatenates two trees whose heights differ by at most two, rotating
+	// once if they differ by two.
+	[[nodiscard]] static node_ptr balance(node_ptr left, node_ptr right);
+
+	// Concatenates two balanced trees into a balanced tree in O(log n).
+	[[nodiscard]] static node_ptr join(node_ptr left, node_ptr right);
+
+	[[nodiscard]] static node_ptr join_right(const node_ptr& left, node_ptr right);
+	[[nodiscard]] static node_ptr join_left(node_ptr left, const node_ptr& right);
+
+	// Two small leaves merged into one, anything else concatenated.
+	[[nodiscard]] static node_ptr merge_or_concat(node_ptr left, node_ptr right);
+
+	// The first pos characters and the rest.
+	[[nodiscard]] static pair<node_ptr, node_ptr> split(const node_ptr& tree, size_type pos);
+
+	node_ptr m_root;
+};
+
+} // namespace simple
+
+#endif // ROPE_H
@@ -3,6 +3,7 @@
 
 #include <utility>
 
+#include "traits.h"
 #include "unique_ptr.h"
 
 namespace simple
@@ -207,6 +208,11 @@ void swap(TT& a, TT& b) noexcept
 	a.swap(b);
 }
 
+template <class T>
+struct is_trivially_relocatable<shared_ptr<T>> : std::true_type
+{
+};
+
 } // namespace simple
 
 #endif // SHARED_PTR_H
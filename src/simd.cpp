@@ -0,0 +1,335 @@
+#include "simd.h"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// AVX2 kernels are compiled with a target attribute and only called after a
+// run time check, so the rest of the build needs no -mavx2.
+#if defined(__SSE2__) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMPLE_SIMD_AVX2 1
+#define SIMPLE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace
+{
+
+using simple::size_type;
+
+template <class U>
+U load_element(const unsigned char* bytes, size_type index) noexcept
+{
+	U element;
+	std::memcpy(&element, bytes + index * sizeof(U), sizeof(U));
+	return element;
+}
+
+template <class U>
+size_type find_scalar(const unsigned char* bytes, size_type first, size_type count,
+					  U value) noexcept
+{
+	for (; first < count; ++first)
+	{
+		if (load_element<U>(bytes, first) == value)
+			return first;
+	}
+
+	return count;
+}
+
+template <class U>
+size_type count_scalar(const unsigned char* bytes, size_type first, size_type count,
+					   U value) noexcept
+{
+	size_type matches = 0;
+
+	for (; first < count; ++first)
+		matches += load_element<U>(bytes, first) == value;
+
+	return matches;
+}
+
+size_type mismatch_scalar(const unsigned char* first, const unsigned char* second,
+						  size_type index, size_type bytes) noexcept
+{
+	while (index < bytes && first[index] == second[index])
+		++index;
+
+	return index;
+}
+
+#if defined(__SSE2__)
+
+// Movemask bits that mark the first byte of each U in a vector, a match is
+// reported on those bits only.
+template <class U, class Mask>
+constexpr Mask element_start_bits()
+{
+	Mask bits = 0;
+
+	for (unsigned i = 0; i < sizeof(Mask) * 8; i += sizeof(U))
+		bits = static_cast<Mask>(bits | Mask(1) << i);
+
+	return bits;
+}
+
+template <class U>
+__m128i broadcast_sse2(U value) noexcept
+{
+	if constexpr (sizeof(U) == 1)
+		return _mm_set1_epi8(static_cast<char>(value));
+	else if constexpr (sizeof(U) == 2)
+		return _mm_set1_epi16(static_cast<short>(value));
+	else if constexpr (sizeof(U) == 4)
+		return _mm_set1_epi32(static_cast<int>(value));
+	else
+		return _mm_set1_epi64x(static_cast<long long>(value));
+}
+
+// Bit i is set when byte i starts an element equal to the needle.
+template <class U>
+unsigned match_mask_sse2(const unsigned char* bytes, __m128i needle) noexcept
+{
+	__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+	unsigned mask;
+
+	if constexpr (sizeof(U) == 1)
+		mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+	else if constexpr (sizeof(U) == 2)
+		mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(block, needle)));
+	else
+	{
+		mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(block, needle)));
+
+		// SSE2 has no 64-bit compare, both halves must match.
+		if constexpr (sizeof(U) == 8)
+			mask &= mask >> 4;
+	}
+
+	return mask & element_start_bits<U, std::uint16_t>();
+}
+
+template <class U>
+size_type find_sse2(const unsigned char* bytes, size_type count, U value) noexcept
+{
+	constexpr size_type LANES = sizeof(__m128i) / sizeof(U);
+
+	__m128i needle = broadcast_sse2(value);
+	size_type i = 0;
+
+	for (; i + LANES <= count; i += LANES)
+	{
+		if (unsigned mask = match_mask_sse2<U>(bytes + i * sizeof(U), needle))
+			return i + static_cast<size_type>(__builtin_ctz(mask)) / sizeof(U);
+	}
+
+	return find_scalar(bytes, i, count, value);
+}
+
+template <class U>
+size_type count_sse2(const unsigned char* bytes, size_type count, U value) noexcept
+{
+	constexpr size_type LANES = sizeof(__m128i) / sizeof(U);
+
+	__m128i needle = broadcast_sse2(value);
+	size_type i = 0;
+	size_type matches = 0;
+
+	for (; i + LANES <= count; i += LANES)
+	{
+		unsigned mask = match_mask_sse2<U>(bytes + i * sizeof(U), needle);
+		matches += static_cast<size_type>(__builtin_popcount(mask));
+	}
+
+	return matches + count_scalar(bytes, i, count, value);
+}
+
+size_type mismatch_sse2(const unsigned char* first, const unsigned char* second,
+						size_type bytes) noexcept
+{
+	constexpr size_type WIDTH = sizeof(__m128i);
+	constexpr unsigned ALL_EQUAL = 0xFFFF;
+
+	size_type i = 0;
+
+	for (; i + WIDTH <= bytes; i += WIDTH)
+	{
+		__m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+		__m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+
+		auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs)));
+		if (mask != ALL_EQUAL)
+			return i + static_cast<size_type>(__builtin_ctz(~mask));
+	}
+
+	return mismatch_scalar(first, second, i, bytes);
+}
+
+#endif // __SSE2__
+
+#if defined(SIMPLE_SIMD_AVX2)
+
+bool has_avx2() noexcept
+{
+	static const bool supported = __builtin_cpu_supports("avx2");
+	return supported;
+}
+
+template <class U>
+SIMPLE_TARGET_AVX2 __m256i broadcast_avx2(U value) noexcept
+{
+	if constexpr (sizeof(U) == 1)
+		return _mm256_set1_epi8(static_cast<char>(value));
+	else if constexpr (sizeof(U) == 2)
+		return _mm256_set1_epi16(static_cast<short>(value));
+	else if constexpr (sizeof(U) == 4)
+		return _mm256_set1_epi32(static_cast<int>(value));
+	else
+		return _mm256_set1_epi64x(static_cast<long long>(value));
+}
+
+template <class U>
+SIMPLE_TARGET_AVX2 std::uint32_t match_mask_avx2(const unsigned char* bytes,
+												 __m256i needle) noexcept
+{
+	__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes));
+	__m256i equal;
+
+	if constexpr (sizeof(U) == 1)
+		equal = _mm256_cmpeq_epi8(block, needle);
+	else if constexpr (sizeof(U) == 2)
+		equal = _mm256_cmpeq_epi16(block, needle);
+	else if constexpr (sizeof(U) == 4)
+		equal = _mm256_cmpeq_epi32(block, needle);
+	else
+		equal = _mm256_cmpeq_epi64(block, needle);
+
+	auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(equal));
+	return mask & element_start_bits<U, std::uint32_t>();
+}
+
+template <class U>
+SIMPLE_TARGET_AVX2 size_type find_avx2(const unsigned char* bytes, size_type count,
+									   U value) noexcept
+{
+	constexpr size_type LANES = sizeof(__m256i) / sizeof(U);
+
+	__m256i needle = broadcast_avx2(value);
+	size_type i = 0;
+
+	for (; i + LANES <= count; i += LANES)
+	{
+		if (std::uint32_t mask = match_mask_avx2<U>(bytes + i * sizeof(U), needle))
+			return i + static_cast<size_type>(__builtin_ctz(mask)) / sizeof(U);
+	}
+
+	return find_scalar(bytes, i, count, value);
+}
+
+template <class U>
+SIMPLE_TARGET_AVX2 size_type count_avx2(const unsigned char* bytes, size_type count,
+										U value) noexcept
+{
+	constexpr size_type LANES = sizeof(__m256i) / sizeof(U);
+
+	__m256i needle = broadcast_avx2(value);
+	size_type i = 0;
+	size_type matches = 0;
+
+	for (; i + LANES <= count; i += LANES)
+	{
+		std::uint32_t mask = match_mask_avx2<U>(bytes + i * sizeof(U), needle);
+		matches += static_cast<size_type>(__builtin_popcount(mask));
+	}
+
+	return matches + count_scalar(bytes, i, count, value);
+}
+
+SIMPLE_TARGET_AVX2 size_type mismatch_avx2(const unsigned char* first,
+										   const unsigned char* second, size_type bytes) noexcept
+{
+	constexpr size_type WIDTH = sizeof(__m256i);
+	constexpr std::uint32_t ALL_EQUAL = 0xFFFFFFFF;
+
+	size_type i = 0;
+
+	for (; i + WIDTH <= bytes; i += WIDTH)
+	{
+		__m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+		__m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i));
+
+		auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs)));
+		if (mask != ALL_EQUAL)
+			return i + static_cast<size_type>(__builtin_ctz(~mask));
+	}
+
+	return mismatch_sse2(first + i, second + i, bytes - i) + i;
+}
+
+#endif // SIMPLE_SIMD_AVX2
+
+} // namespace
+
+template <class U>
+simple::size_type simple::simd::find(const void* data, size_type count, U value) noexcept
+{
+	const auto* bytes = static_cast<const unsigned char*>(data);
+
+#if defined(SIMPLE_SIMD_AVX2)
+	if (has_avx2())
+		return find_avx2(bytes, count, value);
+#endif
+
+#if defined(__SSE2__)
+	return find_sse2(bytes, count, value);
+#else
+	return find_scalar(bytes, 0, count, value);
+#endif
+}
+
+template <class U>
+simple::size_type simple::simd::count(const void* data, size_type count, U value) noexcept
+{
+	const auto* bytes = static_cast<const unsigned char*>(data);
+
+#if defined(SIMPLE_SIMD_AVX2)
+	if (has_avx2())
+		return count_avx2(bytes, count, value);
+#endif
+
+#if defined(__SSE2__)
+	return count_sse2(bytes, count, value);
+#else
+	return count_scalar(bytes, 0, count, value);
+#endif
+}
+
+simple::size_type simple::simd::mismatch(const void* first, const void* second,
+										 size_type bytes) noexcept
+{
+	const auto* lhs = static_cast<const unsigned char*>(first);
+	const auto* rhs = static_cast<const unsigned char*>(second);
+
+#if defined(SIMPLE_SIMD_AVX2)
+	if (has_avx2())
+		return mismatch_avx2(lhs, rhs, bytes);
+#endif
+
+#if defined(__SSE2__)
+	return mismatch_sse2(lhs, rhs, bytes);
+#else
+	return mismatch_scalar(lhs, rhs, 0, bytes);
+#endif
+}
+
+template simple::size_type simple::simd::find(const void*, size_type, std::uint8_t) noexcept;
+template simple::size_type simple::simd::find(const void*, size_type, std::uint16_t) noexcept;
+template simple::size_type simple::simd::find(const void*, size_type, std::uint32_t) noexcept;
+template simple::size_type simple::simd::find(const void*, size_type, std::uint64_t) noexcept;
+
+template simple::size_type simple::simd::count(const void*, size_type, std::uint8_t) noexcept;
+template simple::size_type simple::simd::count(const void*, size_type, std::uint16_t) noexcept;
+template simple::size_type simple::simd::count(const void*, size_type, std::uint32_t) noexcept;
+template simple::size_type simple::simd::count(const void*, size_type, std::uint64_t) noexcept;
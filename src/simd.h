@@ -0,0 +1,34 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace simple
+{
+
+using size_type = std::size_t;
+
+// Vectorized kernels behind the algorithms in util.h. They work on raw
+// element bytes, U being the unsigned integer of the element size, and use
+// AVX2 when the CPU supports it at run time, SSE2 otherwise, and a scalar
+// loop on other architectures.
+namespace simd
+{
+
+// Index of the first of the count elements at data equal to value, or count.
+template <class U>
+[[nodiscard]] size_type find(const void* data, size_type count, U value) noexcept;
+
+// Number of the count elements at data equal to value.
+template <class U>
+[[nodiscard]] size_type count(const void* data, size_type count, U value) noexcept;
+
+// Index of the first byte that differs between the two blocks, or bytes.
+[[nodiscard]] size_type mismatch(const void* first, const void* second, size_type bytes) noexcept;
+
+} // namespace simd
+
+} // namespace simple
+
+#endif // SIMD_H
@@ -0,0 +1,166 @@
+#ifndef SMALL_FUNCTION_H
+#define SMALL_FUNCTION_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace simple
+{
+
+using size_type = std::size_t;
+
+template <class Signature, size_type Capacity = 6 * sizeof(void*)>
+class small_function;
+
+// Move-only std::function that keeps callables of up to Capacity bytes in
+// inline storage, so wrapping a lambda with a few captures never allocates.
+// Larger callables, or ones that may throw while being moved, are kept on
+// the heap.
+template <class R, class... Args, size_type Capacity>
+class small_function<R(Args...), Capacity>
+{
+	struct operations
+	{
+		R (*invoke)(void* storage, Args&&... args);
+		void (*move)(void* from, void* to) noexcept;
+		void (*destroy)(void* storage) noexcept;
+	};
+
+	template <class F>
+	constexpr static bool is_stored_inline = sizeof(F) <= Capacity &&
+											 alignof(F) <= alignof(std::max_align_t) &&
+											 std::is_nothrow_move_constructible_v<F>;
+
+	template <class F>
+	struct inline_operations
+	{
+		static F* get(void* storage) noexcept { return std::launder(static_cast<F*>(storage)); }
+
+		static R invoke(void* storage, Args&&... args)
+		{
+			return (*get(storage))(std::forward<Args>(args)...);
+		}
+
+		static void move(void* from, void* to) noexcept
+		{
+			new (to) F(std::move(*get(from)));
+			get(from)->~F();
+		}
+
+		static void destroy(void* storage) noexcept { get(storage)->~F(); }
+
+		constexpr static operations table {&invoke, &move, &destroy};
+	};
+
+	template <class F>
+	struct heap_operations
+	{
+		static F*& get(void* storage) noexcept { return *std::launder(static_cast<F**>(storage)); }
+
+		static R invoke(void* storage, Args&&... args)
+		{
+			return (*get(storage))(std::forward<Args>(args)...);
+		}
+
+		static void move(void* from, void* to) noexcept
+		{
+			new (to) F*(std::exchange(get(from), nullptr));
+		}
+
+		static void destroy(void* storage) noexcept { delete get(storage); }
+
+		constexpr static operations table {&invoke, &move, &destroy};
+	};
+
+public:
+	constexpr static size_type inline_capacity = Capacity;
+
+	small_function() noexcept = default;
+
+	small_function(std::nullptr_t) noexcept {}
+
+	template <class F, class Callable = std::decay_t<F>,
+			  class = std::enable_if_t<!std::is_same_v<Callable, small_function> &&
+									   std::is_invocable_r_v<R, Callable&, Args...>>>
+	small_function(F&& callable)
+	{
+		if constexpr (is_stored_inline<Callable>)
+		{
+			new (m_storage) Callable(std::forward<F>(callable));
+			m_operations = &inline_operations<Callable>::table;
+		}
+
+		else
+		{
+			new (m_storage) Callable*(new Callable(std::forward<F>(callable)));
+			m_operations = &heap_operations<Callable>::table;
+		}
+	}
+
+	small_function(small_function&& other) noexcept : m_operations(other.m_operations)
+	{
+		if (m_operations)
+		{
+			m_operations->move(other.m_storage, m_storage);
+			other.m_operations = nullptr;
+		}
+	}
+
+	small_function(const small_function& other) = delete;
+
+	~small_function() { reset(); }
+
+	small_function& operator=(small_function&& other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+
+			if (other.m_operations)
+			{
+				other.m_operations->move(other.m_storage, m_storage);
+				m_operations = std::exchange(other.m_operations, nullptr);
+			}
+		}
+
+		return *this;
+	}
+
+	small_function& operator=(const small_function& other) = delete;
+
+	small_function& operator=(std::nullptr_t) noexcept
+	{
+		reset();
+		return *this;
+	}
+
+	R operator()(Args... args)
+	{
+		return m_operations->invoke(m_storage, std::forward<Args>(args)...);
+	}
+
+	explicit operator bool() const noexcept { return m_operations != nullptr; }
+
+	// True when the callable lives in the inline storage.
+	template <class F>
+	[[nodiscard]] constexpr static bool stores_inline() noexcept
+	{
+		return is_stored_inline<std::decay_t<F>>;
+	}
+
+private:
+	void reset() noexcept
+	{
+		if (m_operations)
+			std::exchange(m_operations, nullptr)->destroy(m_storage);
+	}
+
+	const operations* m_operations = nullptr;
+	alignas(std::max_align_t) unsigned char m_storage[Capacity];
+};
+
+} // namespace simple
+
+#endif // SMALL_FUNCTION_H
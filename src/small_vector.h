@@ -0,0 +1,389 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "block_storage.h"
+#include "growth_policy.h"
+#include "iterator.h"
+#include "traits.h"
+
+namespace simple
+{
+
+// Vector that keeps up to N elements inline and only moves them to the heap
+// once it grows past N. Since the inline elements live inside the object,
+// moving a small_vector moves its elements one by one and iterators are
+// invalidated by a move. Growth and Storage are the policies of vector and
+// only apply once the elements are on the heap.
+template <class T, size_type N, class Growth = default_growth, class Storage = default_storage>
+class small_vector
+{
+	static_assert(N > 0, "A small_vector needs room for at least one inline element");
+
+	constexpr static std::size_t block_alignment =
+		Storage::alignment > alignof(T) ? Storage::alignment : alignof(T);
+
+	constexpr static bool is_bitwise_comparable =
+		std::is_scalar_v<T> && std::has_unique_object_representations_v<T>;
+
+public:
+	using value_type = T;
+	using iterator = random_access_iterator<T>;
+	using const_iterator = random_access_iterator<T, true>;
+	using pointer = T*;
+	using const_pointer = T const*;
+	using reference = value_type&;
+	using const_reference = value_type const&;
+	using size_type = std::size_t;
+	using growth_policy = Growth;
+	using storage_policy = Storage;
+
+	constexpr static size_type inline_capacity = N;
+
+	small_vector() noexcept : m_elements(inline_elements()) {}
+
+	small_vector(size_type num_of_elements, const T& value) : small_vector()
+	{
+		reserve(num_of_elements);
+		std::uninitialized_fill_n(m_elements, num_of_elements, value);
+		m_size = num_of_elements;
+	}
+
+	explicit small_vector(size_type num_of_elements) : small_vector()
+	{
+		reserve(num_of_elements);
+
+		if constexpr (is_zero_initialized_by_memset_v<T>)
+		{
+			if (num_of_elements)
+				std::memset(static_cast<void*>(m_elements), 0, sizeof(T) * num_of_elements);
+
+			m_size = num_of_elements;
+		}
+
+		else
+		{
+			for (size_type i = 0; i < num_of_elements; ++i)
+				emplace_back();
+		}
+	}
+
+	small_vector(small_vector const& other) : small_vector() { copy_elements_from(other); }
+
+	small_vector(small_vector&& other) noexcept : small_vector() { take_elements_from(other); }
+
+	~small_vector()
+	{
+		destruct_elements();
+		release_heap_block();
+	}
+
+	small_vector& operator=(small_vector const& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			copy_elements_from(other);
+		}
+
+		return *this;
+	}
+
+	small_vector& operator=(small_vector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			release_heap_block();
+			take_elements_from(other);
+		}
+
+		return *this;
+	}
+
+	bool operator==(small_vector const& other) const
+	{
+		if (m_size != other.m_size)
+			return false;
+
+		if constexpr (is_bitwise_comparable)
+			return m_size == 0 || !std::memcmp(m_elements, other.m_elements, sizeof(T) * m_size);
+
+		for (size_type i = 0; i < m_size; ++i)
+		{
+			if (m_elements[i] != other.m_elements[i])
+				return false;
+		}
+
+		return true;
+	}
+
+	bool operator!=(small_vector const& other) const { return !(*this == other); }
+
+	reference operator[](size_type pos) noexcept { return m_elements[pos]; }
+	const_reference operator[](size_type pos) const noexcept { return m_elements[pos]; }
+
+	[[nodiscard]] reference at(size_type pos)
+	{
+		if (pos < m_size)
+			return m_elements[pos];
+
+		throw std::out_of_range("Index out of range");
+	}
+
+	[[nodiscard]] const_reference at(size_type pos) const
+	{
+		if (pos < m_size)
+			return m_elements[pos];
+
+		throw std::out_of_range("Index out of range");
+	}
+
+	void swap(small_vector& other) noexcept
+	{
+		small_vector tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+	friend void swap(small_vector& a, small_vector& b) noexcept { a.swap(b); }
+
+	void reserve(size_type new_cap)
+	{
+		if (m_capacity < new_cap)
+			reallocate(new_cap);
+	}
+
+	void push_back(const T& value) { emplace_back(value); }
+
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	template <class... Args>
+	reference emplace_back(Args&&... args)
+	{
+		if (m_size == m_capacity)
+			reallocate(get_increased_capacity(m_size + 1));
+
+		new (&m_elements[m_size]) T(std::forward<Args>(args)...);
+
+		return m_elements[m_size++];
+	}
+
+	template <class InputIt>
+	void insert(InputIt first, InputIt last)
+	{
+		reserve(static_cast<size_type>(last - first) + m_size);
+
+		for (; first != last; ++first)
+			emplace_back(*first);
+	}
+
+	void pop_back() noexcept
+	{
+		--m_size;
+		m_elements[m_size].~T();
+	}
+
+	void clear() noexcept
+	{
+		destruct_elements();
+		m_size = 0;
+	}
+
+	iterator erase(const_iterator pos)
+	{
+		auto offset = static_cast<size_type>(pos - cbegin());
+
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			m_elements[offset].~T();
+
+			if (offset + 1 < m_size)
+				std::memmove(static_cast<void*>(m_elements + offset),
+							 static_cast<void*>(m_elements + offset + 1),
+							 sizeof(T) * (m_size - offset - 1));
+
+			--m_size;
+		}
+
+		else
+		{
+			for (size_type i = offset; i + 1 < m_size; ++i)
+			{
+				m_elements[i].~T();
+				new (&m_elements[i]) T(std::move(m_elements[i + 1]));
+			}
+
+			pop_back();
+		}
+
+		return begin() + offset;
+	}
+
+	[[nodiscard]] iterator begin() const noexcept { return iterator(m_elements); }
+	[[nodiscard]] const_iterator cbegin() const noexcept { return const_iterator(m_elements); }
+
+	[[nodiscard]] iterator end() const noexcept { return iterator(m_elements + m_size); }
+	[[nodiscard]] const_iterator cend() const noexcept
+	{
+		return const_iterator(m_elements + m_size);
+	}
+
+	[[nodiscard]] reference front() noexcept { return m_elements[0]; }
+	[[nodiscard]] const_reference front() const noexcept { return m_elements[0]; }
+
+	[[nodiscard]] reference back() noexcept { return m_elements[m_size - 1]; }
+	[[nodiscard]] const_reference back() const noexcept { return m_elements[m_size - 1]; }
+
+	[[nodiscard]] pointer data() noexcept { return m_elements; }
+	[[nodiscard]] const_pointer data() const noexcept { return m_elements; }
+
+	[[nodiscard]] size_type size() const noexcept { return m_size; }
+	[[nodiscard]] size_type capacity() const noexcept { return m_capacity; }
+	[[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+	// True while the elements live in the inline storage.
+	[[nodiscard]] bool is_inline() const noexcept { return m_elements == inline_elements(); }
+
+private:
+	[[nodiscard]] T* inline_elements() const noexcept
+	{
+		return std::launder(reinterpret_cast<T*>(const_cast<unsigned char*>(m_storage)));
+	}
+
+	// Trivially relocatable elements on the heap are moved by the storage
+	// policy, as in vector.
+	void reallocate(size_type new_cap)
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (!is_inline())
+			{
+				void* resized_block =
+					Storage::reallocate(static_cast<void*>(m_elements), sizeof(T) * m_capacity,
+										sizeof(T) * new_cap, block_alignment);
+
+				if (resized_block)
+				{
+					m_elements = static_cast<T*>(resized_block);
+					m_capacity = new_cap;
+					return;
+				}
+			}
+		}
+
+		T* new_block = allocate_new_blocks(new_cap);
+		relocate_elements(m_elements, m_size, new_block);
+		release_heap_block();
+
+		m_elements = new_block;
+		m_capacity = new_cap;
+	}
+
+	void copy_elements_from(small_vector const& other)
+	{
+		reserve(other.m_size);
+
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (other.m_size)
+				std::memcpy(static_cast<void*>(m_elements), other.m_elements,
+							sizeof(T) * other.m_size);
+		}
+
+		else
+		{
+			for (size_type i = 0; i < other.m_size; ++i)
+				new (&m_elements[i]) T(other.m_elements[i]);
+		}
+
+		m_size = other.m_size;
+	}
+
+	// Expects this to be empty and inline.
+	void take_elements_from(small_vector& other) noexcept
+	{
+		if (other.is_inline())
+		{
+			relocate_elements(other.m_elements, other.m_size, m_elements);
+			m_size = std::exchange(other.m_size, 0);
+			return;
+		}
+
+		m_elements = std::exchange(other.m_elements, other.inline_elements());
+		m_capacity = std::exchange(other.m_capacity, N);
+		m_size = std::exchange(other.m_size, 0);
+	}
+
+	// Moves count elements from source to the uninitialized destination,
+	// leaving no live objects in source.
+	static void relocate_elements(T* source, size_type count, T* destination) noexcept
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (count)
+				std::memcpy(static_cast<void*>(destination), static_cast<void*>(source),
+							sizeof(T) * count);
+		}
+
+		else
+		{
+			for (size_type i = 0; i < count; ++i)
+			{
+				new (&destination[i]) T(std::move_if_noexcept(source[i]));
+				source[i].~T();
+			}
+		}
+	}
+
+	void release_heap_block() noexcept
+	{
+		if (is_inline())
+			return;
+
+		deallocate_blocks(m_elements, m_capacity);
+
+		m_elements = inline_elements();
+		m_capacity = N;
+	}
+
+	void destruct_elements() noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			for (size_type i = 0; i < m_size; ++i)
+				m_elements[i].~T();
+		}
+	}
+
+	[[nodiscard]] size_type get_increased_capacity(size_type required) const noexcept
+	{
+		return Growth::next_capacity(m_capacity, required, sizeof(T));
+	}
+
+	[[nodiscard]] static T* allocate_new_blocks(size_type size)
+	{
+		return static_cast<T*>(Storage::allocate(sizeof(T) * size, block_alignment));
+	}
+
+	static void deallocate_blocks(T* block, size_type capacity) noexcept
+	{
+		Storage::deallocate(static_cast<void*>(block), sizeof(T) * capacity, block_alignment);
+	}
+
+	T* m_elements;
+	size_type m_capacity = N;
+	size_type m_size = 0;
+	alignas(T) unsigned char m_storage[sizeof(T) * N];
+};
+
+} // namespace simple
+
+#endif // SMALL_VECTOR_H
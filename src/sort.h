@@ -0,0 +1,753 @@
+#ifndef SORT_H
+#define SORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "my_string.h"
+#include "pair.h"
+#include "vector.h"
+
+namespace simple
+{
+
+namespace detail
+{
+
+// Pattern-defeating quicksort, after Orson Peters' pdqsort. Works on
+// pointers, the public sort takes the address of the first element.
+namespace pdq
+{
+
+constexpr size_type INSERTION_SORT_THRESHOLD = 24;
+constexpr size_type NINTHER_THRESHOLD = 128;
+constexpr size_type PARTIAL_INSERTION_SORT_LIMIT = 8;
+constexpr size_type BLOCK_SIZE = 64;
+constexpr size_type CACHE_LINE_SIZE = 64;
+
+// Comparisons that compile to a single instruction without side effects, so
+// partitioning may evaluate them for every element in a block and keep the
+// results instead of branching on each one.
+template <class T, class Compare>
+constexpr bool is_branchless_v =
+	std::is_arithmetic_v<T> &&
+	(std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>> ||
+	 std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<T>>);
+
+template <class T, class Compare>
+void insertion_sort(T* begin, T* end, Compare& comp)
+{
+	if (begin == end)
+		return;
+
+	for (T* current = begin + 1; current != end; ++current)
+	{
+		T* sift = current;
+		T* sift_1 = current - 1;
+
+		if (comp(*sift, *sift_1))
+		{
+			T value = std::move(*sift);
+
+			do
+				*sift-- = std::move(*sift_1);
+			while (sift != begin && comp(value, *--sift_1));
+
+			*sift = std::move(value);
+		}
+	}
+}
+
+// Like insertion_sort, but *(begin - 1) must not be greater than any element
+// of the range, which ends every sift without a bounds check.
+template <class T, class Compare>
+void unguarded_insertion_sort(T* begin, T* end, Compare& comp)
+{
+	if (begin == end)
+		return;
+
+	for (T* current = begin + 1; current != end; ++current)
+	{
+		T* sift = current;
+		T* sift_1 = current - 1;
+
+		if (comp(*sift, *sift_1))
+		{
+			T value = std::move(*sift);
+
+			do
+				*sift-- = std::move(*sift_1);
+			while (comp(value, *--sift_1));
+
+			*sift = std::move(value);
+		}
+	}
+}
+
+// Insertion sort that gives up after moving PARTIAL_INSERTION_SORT_LIMIT
+// elements, returns whether the range got sorted.
+template <class T, class Compare>
+bool partial_insertion_sort(T* begin, T* end, Compare& comp)
+{
+	if (begin == end)
+		return true;
+
+	size_type moves = 0;
+
+	for (T* current = begin + 1; current != end; ++current)
+	{
+		T* sift = current;
+		T* sift_1 = current - 1;
+
+		if (comp(*sift, *sift_1))
+		{
+			T value = std::move(*sift);
+
+			do
+				*sift-- = std::move(*sift_1);
+			while (sift != begin && comp(value, *--sift_1));
+
+			*sift = std::move(value);
+			moves += static_cast<size_type>(current - sift);
+		}
+
+		if (moves > PARTIAL_INSERTION_SORT_LIMIT)
+			return false;
+	}
+
+	return true;
+}
+
+template <class T, class Compare>
+void sort2(T* a, T* b, Compare& comp)
+{
+	if (comp(*b, *a))
+		std::iter_swap(a, b);
+}
+
+template <class T, class Compare>
+void sort3(T* a, T* b, T* c, Compare& comp)
+{
+	sort2(a, b, comp);
+	sort2(b, c, comp);
+	sort2(a, b, comp);
+}
+
+// Swaps the misplaced elements found by partition_right_branchless. When both
+// sides have the same number left the pairs are swapped, otherwise the
+// elements are rotated through a cycle, which moves each element once.
+template <class T>
+void swap_offsets(T* first, T* last, const unsigned char* offsets_l,
+				  const unsigned char* offsets_r, size_type count, bool use_swaps)
+{
+	if (use_swaps)
+	{
+		for (size_type i = 0; i < count; ++i)
+			std::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+	}
+
+	else if (count > 0)
+	{
+		T* l = first + offsets_l[0];
+		T* r = last - offsets_r[0];
+
+		T value(std::move(*l));
+		*l = std::move(*r);
+
+		for (size_type i = 1; i < count; ++i)
+		{
+			l = first + offsets_l[i];
+			*r = std::move(*l);
+
+			r = last - offsets_r[i];
+			*l = std::move(*r);
+		}
+
+		*r = std::move(value);
+	}
+}
+
+// Partitions [begin, end) around the pivot *begin, elements equal to the
+// pivot go to the right. Returns the pivot's final position and whether the
+// range was already partitioned.
+template <class T, class Compare>
+pair<T*, bool> partition_right(T* begin, T* end, Compare& comp)
+{
+	T pivot(std::move(*begin));
+
+	T* first = begin;
+	T* last = end;
+
+	// The median of three put an element not less than the pivot at the
+	// end, so the first scan needs no bounds check.
+	while (comp(*++first, pivot))
+		;
+
+	// Unless nothing was skipped, the second scan is bounded by an element
+	// less than the pivot too.
+	if (first - 1 == begin)
+	{
+		while (first < last && !comp(*--last, pivot))
+			;
+	}
+
+	else
+	{
+		while (!comp(*--last, pivot))
+			;
+	}
+
+	bool already_partitioned = first >= last;
+
+	while (first < last)
+	{
+		std::iter_swap(first, last);
+
+		while (comp(*++first, pivot))
+			;
+
+		while (!comp(*--last, pivot))
+			;
+	}
+
+	T* pivot_position = first - 1;
+	*begin = std::move(*pivot_position);
+	*pivot_position = std::move(pivot);
+
+	return pair<T*, bool>(pivot_position, already_partitioned);
+}
+
+// partition_right without a branch per element: BLOCK_SIZE elements from
+// each side are compared against the pivot, the offsets of the misplaced
+// ones are recorded and then swapped in one go (Edelkamp and Weiss,
+// BlockQuicksort).
+template <class T, class Compare>
+pair<T*, bool> partition_right_branchless(T* begin, T* end, Compare& comp)
+{
+	T pivot(std::move(*begin));
+
+	T* first = begin;
+	T* last = end;
+
+	while (comp(*++first, pivot))
+		;
+
+	if (first - 1 == begin)
+	{
+		while (first < last && !comp(*--last, pivot))
+			;
+	}
+
+	else
+	{
+		while (!comp(*--last, pivot))
+			;
+	}
+
+	bool already_partitioned = first >= last;
+
+	if (!already_partitioned)
+	{
+		std::iter_swap(first, last);
+		++first;
+
+		alignas(CACHE_LINE_SIZE) unsigned char offsets_l[BLOCK_SIZE];
+		alignas(CACHE_LINE_SIZE) unsigned char offsets_r[BLOCK_SIZE];
+
+		T* offsets_l_base = first;
+		T* offsets_r_base = last;
+
+		size_type count_l = 0;
+		size_type count_r = 0;
+		size_type start_l = 0;
+		size_type start_r = 0;
+
+		while (first < last)
+		{
+			// Refill the side that ran out of misplaced elements, splitting
+			// what is left between both sides when both ran out.
+			auto unknown = static_cast<size_type>(last - first);
+			size_type left_split = count_l == 0 ? (count_r == 0 ? unknown / 2 : unknown) : 0;
+			size_type right_split = count_r == 0 ? unknown - left_split : 0;
+
+			size_type left_block = std::min(left_split, BLOCK_SIZE);
+			size_type right_block = std::min(right_split, BLOCK_SIZE);
+
+			for (size_type i = 0; i < left_block; ++i)
+			{
+				offsets_l[count_l] = static_cast<unsigned char>(i);
+				count_l += !comp(*first, pivot);
+				++first;
+			}
+
+			for (size_type i = 0; i < right_block; ++i)
+			{
+				offsets_r[count_r] = static_cast<unsigned char>(i + 1);
+				count_r += comp(*--last, pivot);
+			}
+
+			size_type count = std::min(count_l, count_r);
+			swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+						 count, count_l == count_r);
+
+			count_l -= count;
+			count_r -= count;
+			start_l += count;
+			start_r += count;
+
+			if (count_l == 0)
+			{
+				start_l = 0;
+				offsets_l_base = first;
+			}
+
+			if (count_r == 0)
+			{
+				start_r = 0;
+				offsets_r_base = last;
+			}
+		}
+
+		// Every element is classified, the misplaced ones left on one side
+		// are swapped to the boundary.
+		if (count_l)
+		{
+			while (count_l)
+				std::iter_swap(offsets_l_base + offsets_l[start_l + --count_l], --last);
+
+			first = last;
+		}
+
+		if (count_r)
+		{
+			while (count_r)
+				std::iter_swap(offsets_r_base - offsets_r[start_r + --count_r], first++);
+
+			last = first;
+		}
+	}
+
+	T* pivot_position = first - 1;
+	*begin = std::move(*pivot_position);
+	*pivot_position = std::move(pivot);
+
+	return pair<T*, bool>(pivot_position, already_partitioned);
+}
+
+// Partitions [begin, end) around the pivot *begin, elements equal to the
+// pivot go to the left. Used when the pivot equals the element before the
+// range, so that runs of equal elements are handled in linear time.
+template <class T, class Compare>
+T* partition_left(T* begin, T* end, Compare& comp)
+{
+	T pivot(std::move(*begin));
+
+	T* first = begin;
+	T* last = end;
+
+	while (comp(pivot, *--last))
+		;
+
+	if (last + 1 == end)
+	{
+		while (first < last && !comp(pivot, *++first))
+			;
+	}
+
+	else
+	{
+		while (!comp(pivot, *++first))
+			;
+	}
+
+	while (first < last)
+	{
+		std::iter_swap(first, last);
+
+		while (comp(pivot, *--last))
+			;
+
+		while (!comp(pivot, *++first))
+			;
+	}
+
+	T* pivot_position = last;
+	*begin = std::move(*pivot_position);
+	*pivot_position = std::move(pivot);
+
+	return pivot_position;
+}
+
+template <bool Branchless, class T, class Compare>
+void sort_loop(T* begin, T* end, Compare& comp, int bad_allowed, bool leftmost)
+{
+	while (true)
+	{
+		auto size = static_cast<size_type>(end - begin);
+
+		if (size < INSERTION_SORT_THRESHOLD)
+		{
+			if (leftmost)
+				insertion_sort(begin, end, comp);
+
+			else
+				unguarded_insertion_sort(begin, end, comp);
+
+			return;
+		}
+
+		// Pivot is the median of three, or the pseudo median of nine for
+		// larger ranges, moved to *begin.
+		size_type half = size / 2;
+
+		if (size > NINTHER_THRESHOLD)
+		{
+			sort3(begin, begin + half, end - 1, comp);
+			sort3(begin + 1, begin + (half - 1), end - 2, comp);
+			sort3(begin + 2, begin + (half + 1), end - 3, comp);
+			sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+			std::iter_swap(begin, begin + half);
+		}
+
+		else
+			sort3(begin + half, begin, end - 1, comp);
+
+		// A pivot equal to the element before the range is the smallest
+		// value left, put every element equal to it on the left and skip
+		// them.
+		if (!leftmost && !comp(*(begin - 1), *begin))
+		{
+			begin = partition_left(begin, end, comp) + 1;
+			continue;
+		}
+
+		pair<T*, bool> partitioned;
+
+		if constexpr (Branchless)
+			partitioned = partition_right_branchless(begin, end, comp);
+
+		else
+			partitioned = partition_right(begin, end, comp);
+
+		T* pivot_position = partitioned.first;
+		bool already_partitioned = partitioned.second;
+
+		auto size_l = static_cast<size_type>(pivot_position - begin);
+		auto size_r = static_cast<size_type>(end - (pivot_position + 1));
+
+		if (size_l < size / 8 || size_r < size / 8)
+		{
+			// Too many bad partitions, the input defeats the pivot choice,
+			// fall back to heapsort for an O(n log n) bound.
+			if (--bad_allowed == 0)
+			{
+				std::make_heap(begin, end, comp);
+				std::sort_heap(begin, end, comp);
+				return;
+			}
+
+			// Otherwise shuffle a few elements to break the pattern.
+			if (size_l >= INSERTION_SORT_THRESHOLD)
+			{
+				std::iter_swap(begin, begin + size_l / 4);
+				std::iter_swap(pivot_position - 1, pivot_position - size_l / 4);
+
+				if (size_l > NINTHER_THRESHOLD)
+				{
+					std::iter_swap(begin + 1, begin + (size_l / 4 + 1));
+					std::iter_swap(begin + 2, begin + (size_l / 4 + 2));
+					std::iter_swap(pivot_position - 2, pivot_position - (size_l / 4 + 1));
+					std::iter_swap(pivot_position - 3, pivot_position - (size_l / 4 + 2));
+				}
+			}
+
+			if (size_r >= INSERTION_SORT_THRESHOLD)
+			{
+				std::iter_swap(pivot_position + 1, pivot_position + (1 + size_r / 4));
+				std::iter_swap(end - 1, end - size_r / 4);
+
+				if (size_r > NINTHER_THRESHOLD)
+				{
+					std::iter_swap(pivot_position + 2, pivot_position + (2 + size_r / 4));
+					std::iter_swap(pivot_position + 3, pivot_position + (3 + size_r / 4));
+					std::iter_swap(end - 2, end - (1 + size_r / 4));
+					std::iter_swap(end - 3, end - (2 + size_r / 4));
+				}
+			}
+		}
+
+		// An already partitioned range is likely sorted, try to finish it
+		// with a bounded insertion sort.
+		else if (already_partitioned && partial_insertion_sort(begin, pivot_position, comp) &&
+				 partial_insertion_sort(pivot_position + 1, end, comp))
+			return;
+
+		sort_loop<Branchless>(begin, pivot_position, comp, bad_allowed, leftmost);
+
+		begin = pivot_position + 1;
+		leftmost = false;
+	}
+}
+
+template <class T, class Compare>
+void sort(T* begin, T* end, Compare& comp)
+{
+	if (begin == end)
+		return;
+
+	int bad_allowed = 0;
+
+	for (auto size = static_cast<size_type>(end - begin); size > 1; size >>= 1)
+		++bad_allowed;
+
+	sort_loop<is_branchless_v<T, Compare>>(begin, end, comp, bad_allowed, true);
+}
+
+} // namespace pdq
+
+// Ranges this short are insertion sorted instead of radix sorted.
+constexpr size_type RADIX_SORT_THRESHOLD = 64;
+
+template <class Key>
+using radix_key_t = std::make_unsigned_t<std::remove_cv_t<Key>>;
+
+// Maps a key to an unsigned integer in the same order: signed keys get
+// their sign bit flipped.
+template <class Key>
+radix_key_t<Key> radix_bits(Key key) noexcept
+{
+	using bits_type = radix_key_t<Key>;
+
+	auto bits = static_cast<bits_type>(key);
+
+	if constexpr (std::is_signed_v<Key>)
+		bits = static_cast<bits_type>(bits ^ (bits_type(1) << (sizeof(Key) * 8 - 1)));
+
+	return bits;
+}
+
+template <class Bits>
+size_type radix_byte(Bits bits, size_type pass) noexcept
+{
+	return static_cast<size_type>((bits >> (pass * 8)) & 0xff);
+}
+
+// Stable LSD radix sort on the integer key(element), one byte per pass.
+// The histograms of every pass are counted in a single read, passes where
+// all keys share the byte are skipped.
+template <class T, class KeyFunc>
+void lsd_radix_sort(T* data, size_type count, KeyFunc& key)
+{
+	using key_type = std::remove_cv_t<std::remove_reference_t<decltype(key(*data))>>;
+
+	static_assert(std::is_integral_v<key_type> && !std::is_same_v<key_type, bool>,
+				  "radix_sort keys must be integers");
+
+	constexpr size_type PASSES = sizeof(key_type);
+	constexpr size_type BUCKETS = 256;
+
+	if (count < RADIX_SORT_THRESHOLD)
+	{
+		auto less = [&key](const T& lhs, const T& rhs) {
+			return radix_bits(key(lhs)) < radix_bits(key(rhs));
+		};
+
+		pdq::insertion_sort(data, data + count, less);
+		return;
+	}
+
+	size_type histograms[PASSES][BUCKETS] = {};
+
+	for (size_type i = 0; i < count; ++i)
+	{
+		auto bits = radix_bits(key(data[i]));
+
+		for (size_type pass = 0; pass < PASSES; ++pass)
+			++histograms[pass][radix_byte(bits, pass)];
+	}
+
+	vector<T> buffer;
+	buffer.resize_default_init(count);
+
+	T* source = data;
+	T* destination = buffer.data();
+
+	for (size_type pass = 0; pass < PASSES; ++pass)
+	{
+		size_type* histogram = histograms[pass];
+
+		if (std::find(histogram, histogram + BUCKETS, count) != histogram + BUCKETS)
+			continue;
+
+		size_type offset = 0;
+
+		for (size_type bucket = 0; bucket < BUCKETS; ++bucket)
+			offset += std::exchange(histogram[bucket], offset);
+
+		for (T* it = source; it != source + count; ++it)
+		{
+			size_type bucket = radix_byte(radix_bits(key(*it)), pass);
+			destination[histogram[bucket]++] = std::move(*it);
+		}
+
+		std::swap(source, destination);
+	}
+
+	if (source != data)
+		std::move(source, source + count, data);
+}
+
+// Compares two strings from byte depth on, as unsigned bytes.
+inline bool string_less_from(const string& lhs, const string& rhs, size_type depth) noexcept
+{
+	size_type lhs_size = lhs.size() - depth;
+	size_type rhs_size = rhs.size() - depth;
+
+	int result = std::memcmp(lhs.data() + depth, rhs.data() + depth, std::min(lhs_size, rhs_size));
+
+	return result < 0 || (result == 0 && lhs_size < rhs_size);
+}
+
+// MSD radix sort of strings sharing their first depth bytes, an American
+// flag sort: the strings are counted into 257 buckets by the byte at depth,
+// bucket 0 holding the strings that end there, and permuted into place by
+// swaps. The largest bucket is sorted by the loop and the others by
+// recursion, so the recursion depth stays logarithmic however long the
+// common prefixes are.
+inline void msd_radix_sort(string* first, string* last, size_type depth)
+{
+	constexpr size_type BUCKETS = 257;
+
+	auto bucket_of = [&depth](const string& value) -> size_type {
+		return depth < value.size() ? 1 + static_cast<unsigned char>(value.data()[depth]) : 0;
+	};
+
+	while (static_cast<size_type>(last - first) >= RADIX_SORT_THRESHOLD)
+	{
+		size_type counts[BUCKETS] = {};
+
+		for (string* it = first; it != last; ++it)
+			++counts[bucket_of(*it)];
+
+		string* bucket_begin[BUCKETS];
+		string* bucket_next[BUCKETS];
+
+		string* position = first;
+
+		for (size_type bucket = 0; bucket < BUCKETS; ++bucket)
+		{
+			bucket_begin[bucket] = bucket_next[bucket] = position;
+			position += counts[bucket];
+		}
+
+		for (size_type bucket = 0; bucket < BUCKETS; ++bucket)
+		{
+			string* bucket_end = bucket_begin[bucket] + counts[bucket];
+
+			while (bucket_next[bucket] != bucket_end)
+			{
+				size_type target = bucket_of(*bucket_next[bucket]);
+
+				if (target == bucket)
+					++bucket_next[bucket];
+
+				else
+					bucket_next[bucket]->swap(*bucket_next[target]++);
+			}
+		}
+
+		// Bucket 0 holds equal strings and needs no further sorting.
+		size_type largest = 1;
+
+		for (size_type bucket = 2; bucket < BUCKETS; ++bucket)
+		{
+			if (counts[bucket] > counts[largest])
+				largest = bucket;
+		}
+
+		for (size_type bucket = 1; bucket < BUCKETS; ++bucket)
+		{
+			if (bucket != largest && counts[bucket] > 1)
+				msd_radix_sort(bucket_begin[bucket], bucket_begin[bucket] + counts[bucket],
+							   depth + 1);
+		}
+
+		first = bucket_begin[largest];
+		last = first + counts[largest];
+		++depth;
+	}
+
+	auto less = [&depth](const string& lhs, const string& rhs) {
+		return string_less_from(lhs, rhs, depth);
+	};
+
+	pdq::insertion_sort(first, last, less);
+}
+
+} // namespace detail
+
+// Sorts a contiguous range, e.g. of a simple::vector, with pattern-defeating
+// quicksort: O(n log n) worst case, linear on sorted, reversed and few
+// distinct values. Not stable. With std::less or std::greater on arithmetic
+// types the partitioning is branchless.
+template <class RandomIt, class Compare>
+void sort(RandomIt first, RandomIt last, Compare comp)
+{
+	auto count = static_cast<size_type>(last - first);
+
+	if (count)
+	{
+		auto* data = &*first;
+		detail::pdq::sort(data, data + count, comp);
+	}
+}
+
+template <class RandomIt>
+void sort(RandomIt first, RandomIt last)
+{
+	simple::sort(first, last, std::less<>());
+}
+
+// Sorts a contiguous range of integers in ascending order with an LSD radix
+// sort, or of simple::strings in byte order with an MSD radix sort.
+template <class RandomIt>
+void radix_sort(RandomIt first, RandomIt last)
+{
+	auto count = static_cast<size_type>(last - first);
+
+	if (count == 0)
+		return;
+
+	auto* data = &*first;
+	using value_type = std::remove_cv_t<std::remove_reference_t<decltype(*data)>>;
+
+	if constexpr (std::is_same_v<value_type, string>)
+		detail::msd_radix_sort(data, data + count, 0);
+
+	else
+	{
+		auto identity = [](value_type value) { return value; };
+		detail::lsd_radix_sort(data, count, identity);
+	}
+}
+
+// Stable sort of a contiguous range by the integer key(element), e.g. a
+// record's id. key is called once per element and pass, so it should be
+// cheap, and the elements are moved through a buffer of the same size, so
+// they must be default constructible.
+template <class RandomIt, class KeyFunc>
+void radix_sort(RandomIt first, RandomIt last, KeyFunc key)
+{
+	auto count = static_cast<size_type>(last - first);
+
+	if (count)
+		detail::lsd_radix_sort(&*first, count, key);
+}
+
+} // namespace simple
+
+#endif // SORT_H
@@ -0,0 +1,83 @@
+#include "string_builder.h"
+
+simple::string_builder& simple::string_builder::append(const char* data, simple::size_type count)
+{
+	if (count)
+	{
+		m_pieces.push_back(piece {data, 0, count});
+		m_size += count;
+	}
+
+	return *this;
+}
+
+simple::string_builder& simple::string_builder::append(const char* str)
+{
+	return append(str, std::strlen(str));
+}
+
+simple::string_builder& simple::string_builder::append(const simple::string& str)
+{
+	return append(str.data(), str.size());
+}
+
+simple::string_builder& simple::string_builder::append(simple::string_view str)
+{
+	return append(str.data(), str.size());
+}
+
+simple::string_builder& simple::string_builder::append(char ch) { return append_copy(&ch, 1); }
+
+simple::string_builder& simple::string_builder::append_copy(const char* data,
+															simple::size_type count)
+{
+	if (!count)
+		return *this;
+
+	size_type offset = m_owned.size();
+	m_owned.append(data, count);
+	m_size += count;
+
+	// Consecutive copies share a piece.
+	if (!m_pieces.empty() && !m_pieces.back().m_data &&
+		m_pieces.back().m_offset + m_pieces.back().m_size == offset)
+	{
+		m_pieces.back().m_size += count;
+		return *this;
+	}
+
+	m_pieces.push_back(piece {nullptr, offset, count});
+	return *this;
+}
+
+void simple::string_builder::clear() noexcept
+{
+	m_pieces.clear();
+	m_owned.clear();
+	m_size = 0;
+}
+
+simple::string simple::string_builder::build() const
+{
+	string result;
+	result.reserve(m_size);
+	build_into(result);
+	return result;
+}
+
+void simple::string_builder::build_into(simple::string& out) const
+{
+	size_type offset = out.size();
+	out.resize_uninitialized(offset + m_size);
+	copy_to(out.data() + offset);
+}
+
+void simple::string_builder::copy_to(char* out) const noexcept
+{
+	for (const piece& part : m_pieces)
+	{
+		const char* source = part.m_data ? part.m_data : m_owned.data() + part.m_offset;
+		std::memcpy(out, source, part.m_size);
+		out += part.m_size;
+	}
+}
@@ -0,0 +1,82 @@
+#ifndef STRING_BUILDER_H
+#define STRING_BUILDER_H
+
+#include <charconv>
+#include <cstddef>
+#include <type_traits>
+
+#include "my_string.h"
+#include "small_vector.h"
+
+namespace simple
+{
+
+// Collects the pieces of a string and copies them into the result with a
+// single allocation when build() is called. Strings, views and C strings are
+// referenced, not copied, so they must stay alive and unchanged until then;
+// characters, numbers and append_copy() go into the builder's own buffer.
+class string_builder
+{
+	constexpr static size_type INLINE_PIECES = 16;
+
+public:
+	string_builder& append(const char* data, size_type count);
+	string_builder& append(const char* str);
+	string_builder& append(const string& str);
+	string_builder& append(string_view str);
+	string_builder& append(char ch);
+
+	template <class Integer, class = std::enable_if_t<std::is_integral_v<Integer> &&
+													  !std::is_same_v<Integer, char> &&
+													  !std::is_same_v<Integer, bool>>>
+	string_builder& append(Integer value)
+	{
+		char digits[24];
+		auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+		(void)error;
+
+		return append_copy(digits, static_cast<size_type>(end - digits));
+	}
+
+	// Copies the characters, for pieces that do not outlive the builder.
+	string_builder& append_copy(const char* data, size_type count);
+
+	template <class T>
+	string_builder& operator<<(const T& value)
+	{
+		return append(value);
+	}
+
+	// The number of characters collected so far.
+	[[nodiscard]] size_type size() const noexcept { return m_size; }
+	[[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+	void reserve_pieces(size_type count) { m_pieces.reserve(count); }
+
+	void clear() noexcept;
+
+	[[nodiscard]] string build() const;
+
+	// Appends the collected characters to out, growing it at most once. out
+	// must not be one of the pieces.
+	void build_into(string& out) const;
+
+private:
+	struct piece
+	{
+		// nullptr for pieces in m_owned, which can move as it grows.
+		const char* m_data;
+		size_type m_offset;
+		size_type m_size;
+	};
+
+	void copy_to(char* out) const noexcept;
+
+	small_vector<piece, INLINE_PIECES> m_pieces;
+	string m_owned;
+	size_type m_size = 0;
+};
+
+} // namespace simple
+
+#endif // STRING_BUILDER_H
@@ -0,0 +1,174 @@
+#include "string_pool.h"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+using simple::detail::interned_entry;
+
+simple::string_pool::~string_pool()
+{
+	for (shard& part : m_shards)
+	{
+		for (char* block : part.m_blocks)
+			delete[] block;
+	}
+}
+
+simple::interned_string simple::string_pool::intern(simple::string_view str)
+{
+	size_type hash = simple::hash<string_view>()(str);
+	size_type mixed = mix(hash);
+	shard& part = m_shards[mixed & (SHARD_COUNT - 1)];
+
+	std::lock_guard<std::mutex> lock(part.m_mutex);
+
+	if (const interned_entry* entry = find_in(part, str, hash, mixed))
+		return interned_string(entry);
+
+	size_type index = part.m_entries.size();
+
+	if (str.size() > UINT32_MAX || index >= (size_type(1) << (32 - SHARD_BITS)) - 1)
+		throw std::length_error("String pool is full");
+
+	// Below half full, so that probe sequences stay short.
+	if (2 * (index + 1) > part.m_slots.size())
+		grow_slots(part);
+
+	char* memory = allocate(part, sizeof(interned_entry) + str.size() + 1);
+	auto* entry = new (memory) interned_entry {
+		hash, static_cast<std::uint32_t>(index << SHARD_BITS | (mixed & (SHARD_COUNT - 1))),
+		static_cast<std::uint32_t>(str.size())};
+
+	char* chars = memory + sizeof(interned_entry);
+
+	if (!str.empty())
+		std::memcpy(chars, str.data(), str.size());
+
+	chars[str.size()] = '\0';
+
+	part.m_entries.push_back(entry);
+
+	size_type mask = part.m_slots.size() - 1;
+	size_type slot = (mixed >> SHARD_BITS) & mask;
+
+	while (part.m_slots[slot])
+		slot = (slot + 1) & mask;
+
+	part.m_slots[slot] = static_cast<std::uint32_t>(index + 1);
+
+	return interned_string(entry);
+}
+
+simple::interned_string simple::string_pool::find(simple::string_view str) const
+{
+	size_type hash = simple::hash<string_view>()(str);
+	size_type mixed = mix(hash);
+	const shard& part = m_shards[mixed & (SHARD_COUNT - 1)];
+
+	std::lock_guard<std::mutex> lock(part.m_mutex);
+	return interned_string(find_in(part, str, hash, mixed));
+}
+
+simple::interned_string simple::string_pool::operator[](std::uint32_t id) const
+{
+	const shard& part = m_shards[id & (SHARD_COUNT - 1)];
+
+	std::lock_guard<std::mutex> lock(part.m_mutex);
+	return interned_string(part.m_entries[id >> SHARD_BITS]);
+}
+
+simple::size_type simple::string_pool::size() const
+{
+	size_type count = 0;
+
+	for (const shard& part : m_shards)
+	{
+		std::lock_guard<std::mutex> lock(part.m_mutex);
+		count += part.m_entries.size();
+	}
+
+	return count;
+}
+
+simple::size_type simple::string_pool::mix(simple::size_type hash) noexcept
+{
+	// The 64-bit finalizer of MurmurHash3.
+	auto bits = static_cast<std::uint64_t>(hash);
+	bits ^= bits >> 33;
+	bits *= 0xff51afd7ed558ccdULL;
+	bits ^= bits >> 33;
+	bits *= 0xc4ceb9fe1a85ec53ULL;
+	bits ^= bits >> 33;
+
+	return static_cast<size_type>(bits);
+}
+
+const interned_entry* simple::string_pool::find_in(const shard& part, simple::string_view str,
+													simple::size_type hash,
+													simple::size_type mixed) noexcept
+{
+	if (part.m_slots.empty())
+		return nullptr;
+
+	size_type mask = part.m_slots.size() - 1;
+
+	for (size_type slot = (mixed >> SHARD_BITS) & mask; part.m_slots[slot];
+		 slot = (slot + 1) & mask)
+	{
+		const interned_entry* entry = part.m_entries[part.m_slots[slot] - 1];
+
+		if (entry->m_hash == hash && entry->m_size == str.size() &&
+			string_view(entry->chars(), entry->m_size) == str)
+			return entry;
+	}
+
+	return nullptr;
+}
+
+char* simple::string_pool::allocate(shard& part, simple::size_type bytes)
+{
+	constexpr size_type alignment = alignof(interned_entry);
+	bytes = (bytes + alignment - 1) / alignment * alignment;
+
+	// Large strings get a block of their own instead of wasting the rest of
+	// the current one. The slot for a block is added before the block is
+	// allocated, so that a failing push_back cannot leak it.
+	if (bytes > BLOCK_SIZE / 4)
+	{
+		part.m_blocks.push_back(nullptr);
+		part.m_blocks.back() = new char[bytes];
+		return part.m_blocks.back();
+	}
+
+	if (static_cast<size_type>(part.m_block_end - part.m_cursor) < bytes)
+	{
+		part.m_blocks.push_back(nullptr);
+		part.m_blocks.back() = new char[BLOCK_SIZE];
+		part.m_cursor = part.m_blocks.back();
+		part.m_block_end = part.m_cursor + BLOCK_SIZE;
+	}
+
+	char* memory = part.m_cursor;
+	part.m_cursor += bytes;
+	return memory;
+}
+
+void simple::string_pool::grow_slots(shard& part)
+{
+	size_type count = part.m_slots.empty() ? INITIAL_SLOT_COUNT : 2 * part.m_slots.size();
+	vector<std::uint32_t> slots(count, 0);
+	size_type mask = count - 1;
+
+	for (size_type index = 0; index < part.m_entries.size(); ++index)
+	{
+		size_type slot = (mix(part.m_entries[index]->m_hash) >> SHARD_BITS) & mask;
+
+		while (slots[slot])
+			slot = (slot + 1) & mask;
+
+		slots[slot] = static_cast<std::uint32_t>(index + 1);
+	}
+
+	part.m_slots.swap(slots);
+}
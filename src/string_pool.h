@@ -0,0 +1,158 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "hash_function.h"
+#include "my_string.h"
+#include "string_view.h"
+#include "vector.h"
+
+namespace simple
+{
+
+namespace detail
+{
+
+// A string in the arena of a string_pool, directly followed by its characters
+// and a terminating null.
+struct interned_entry
+{
+	size_type m_hash;
+	std::uint32_t m_id;
+	std::uint32_t m_size;
+
+	[[nodiscard]] const char* chars() const noexcept
+	{
+		return reinterpret_cast<const char*>(this + 1);
+	}
+};
+
+} // namespace detail
+
+// Handle to a string interned in a string_pool, valid as long as the pool.
+// Handles from the same pool are equal exactly when their strings are, so
+// comparing them compares pointers, and the hash is the one computed when
+// the string was interned. A default constructed handle refers to no string
+// and reads as empty.
+class interned_string
+{
+	friend class string_pool;
+
+public:
+	constexpr static std::uint32_t NO_ID = UINT32_MAX;
+
+	interned_string() noexcept = default;
+
+	[[nodiscard]] string_view view() const noexcept
+	{
+		return m_entry ? string_view(m_entry->chars(), m_entry->m_size) : string_view();
+	}
+
+	operator string_view() const noexcept { return view(); }
+
+	// Null-terminated, even for a default constructed handle.
+	[[nodiscard]] const char* c_str() const noexcept { return m_entry ? m_entry->chars() : ""; }
+
+	[[nodiscard]] size_type size() const noexcept { return m_entry ? m_entry->m_size : 0; }
+	[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+	// The same value as hash<string> of the characters.
+	[[nodiscard]] size_type hash() const noexcept { return m_entry ? m_entry->m_hash : 0; }
+
+	// The id to look the handle up with in its pool, NO_ID for no string.
+	[[nodiscard]] std::uint32_t id() const noexcept { return m_entry ? m_entry->m_id : NO_ID; }
+
+	explicit operator bool() const noexcept { return m_entry; }
+
+	friend bool operator==(interned_string lhs, interned_string rhs) noexcept
+	{
+		return lhs.m_entry == rhs.m_entry;
+	}
+
+	friend bool operator!=(interned_string lhs, interned_string rhs) noexcept
+	{
+		return !(lhs == rhs);
+	}
+
+private:
+	explicit interned_string(const detail::interned_entry* entry) noexcept : m_entry(entry) {}
+
+	const detail::interned_entry* m_entry = nullptr;
+};
+
+template <>
+struct hash<interned_string>
+{
+	std::size_t operator()(interned_string value) const noexcept { return value.hash(); }
+};
+
+// Keeps one immutable, null-terminated copy of every distinct string given
+// to intern() and hands out handles and 32-bit ids for them. The copies live
+// in arena blocks that are only freed with the pool, so handles never
+// dangle while it exists.
+//
+// The pool is split into shards by hash, each with its own mutex, table and
+// arena, so threads interning different strings rarely wait for each other.
+// An id keeps the shard in its low bits and the index within the shard above
+// them.
+class string_pool
+{
+	constexpr static unsigned SHARD_BITS = 4;
+	constexpr static size_type SHARD_COUNT = size_type(1) << SHARD_BITS;
+	constexpr static size_type BLOCK_SIZE = 64 * 1024;
+	constexpr static size_type INITIAL_SLOT_COUNT = 64;
+	constexpr static size_type CACHE_LINE_SIZE = 64;
+
+public:
+	string_pool() = default;
+	~string_pool();
+
+	string_pool(const string_pool& other) = delete;
+	string_pool& operator=(const string_pool& other) = delete;
+
+	// Returns the handle of the pooled copy of str, adding the copy first if
+	// there is none. Safe to call from several threads at once.
+	interned_string intern(string_view str);
+
+	// The handle of str if it was interned, or a default constructed one.
+	[[nodiscard]] interned_string find(string_view str) const;
+
+	// The handle with the given id, which must come from this pool.
+	[[nodiscard]] interned_string operator[](std::uint32_t id) const;
+
+	// The number of distinct strings.
+	[[nodiscard]] size_type size() const;
+
+private:
+	struct alignas(CACHE_LINE_SIZE) shard
+	{
+		mutable std::mutex m_mutex;
+		vector<const detail::interned_entry*> m_entries;
+		// Open addressing with linear probing, each slot holds an index into
+		// m_entries plus one, zero for an empty slot.
+		vector<std::uint32_t> m_slots;
+		vector<char*> m_blocks;
+		char* m_cursor = nullptr;
+		char* m_block_end = nullptr;
+	};
+
+	// Spreads the bits of the string hash, whose low bits pick the shard and
+	// the rest the first slot.
+	[[nodiscard]] static size_type mix(size_type hash) noexcept;
+
+	[[nodiscard]] static const detail::interned_entry*
+	find_in(const shard& part, string_view str, size_type hash, size_type mixed) noexcept;
+
+	[[nodiscard]] static char* allocate(shard& part, size_type bytes);
+
+	static void grow_slots(shard& part);
+
+	shard m_shards[SHARD_COUNT];
+};
+
+} // namespace simple
+
+#endif // STRING_POOL_H
@@ -0,0 +1,339 @@
+#ifndef STRING_VIEW_H
+#define STRING_VIEW_H
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "iterator.h"
+
+namespace simple
+{
+
+template <class Delimiter>
+class split_view;
+
+// A pointer and a length into characters owned by someone else, usually a
+// simple::string, which must outlive the view. Slicing a view never copies.
+class string_view
+{
+public:
+	using size_type = std::size_t;
+	using value_type = char;
+	using iterator = random_access_iterator<const value_type>;
+	using const_iterator = iterator;
+	using pointer = const value_type*;
+	using const_reference = const value_type&;
+	using difference_type = std::ptrdiff_t;
+
+	constexpr static size_type npos = static_cast<size_type>(-1);
+
+	constexpr string_view() noexcept = default;
+	constexpr string_view(const char* data, size_type count) noexcept : m_data(data), m_size(count)
+	{
+	}
+
+	constexpr string_view(const char* str) noexcept :
+		m_data(str), m_size(std::char_traits<char>::length(str))
+	{
+	}
+
+	string_view(std::nullptr_t) = delete;
+
+	[[nodiscard]] constexpr pointer data() const noexcept { return m_data; }
+	[[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+	[[nodiscard]] constexpr size_type length() const noexcept { return m_size; }
+	[[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+
+	[[nodiscard]] iterator begin() const noexcept { return iterator(m_data); }
+	[[nodiscard]] iterator end() const noexcept { return iterator(m_data + m_size); }
+
+	constexpr const_reference operator[](size_type pos) const noexcept { return m_data[pos]; }
+
+	[[nodiscard]] constexpr const_reference front() const noexcept { return m_data[0]; }
+	[[nodiscard]] constexpr const_reference back() const noexcept { return m_data[m_size - 1]; }
+
+	constexpr void remove_prefix(size_type count) noexcept
+	{
+		m_data += count;
+		m_size -= count;
+	}
+
+	constexpr void remove_suffix(size_type count) noexcept { m_size -= count; }
+
+	// The characters from pos on, at most count of them. Throws
+	// std::out_of_range if pos is past the end.
+	[[nodiscard]] string_view substr(size_type pos, size_type count = npos) const
+	{
+		if (pos > m_size)
+			throw std::out_of_range("Index out of range");
+
+		return string_view(m_data + pos, count < m_size - pos ? count : m_size - pos);
+	}
+
+	// Index of the first occurrence at or after pos, or npos.
+	[[nodiscard]] size_type find(char ch, size_type pos = 0) const noexcept
+	{
+		if (pos >= m_size)
+			return npos;
+
+		const void* match = std::memchr(m_data + pos, ch, m_size - pos);
+		return match ? static_cast<size_type>(static_cast<const char*>(match) - m_data) : npos;
+	}
+
+	[[nodiscard]] size_type find(string_view needle, size_type pos = 0) const noexcept
+	{
+		if (needle.m_size > m_size || pos > m_size - needle.m_size)
+			return npos;
+
+		if (needle.empty())
+			return pos;
+
+		// memchr finds the candidates for the first character, memcmp checks
+		// the rest.
+		const char* first = m_data + pos;
+		const char* last = m_data + m_size - needle.m_size + 1;
+
+		while (first < last)
+		{
+			first = static_cast<const char*>(
+				std::memchr(first, needle.front(), static_cast<size_type>(last - first)));
+
+			if (!first)
+				return npos;
+
+			if (same_chars(first + 1, needle.m_data + 1, needle.m_size - 1))
+				return static_cast<size_type>(first - m_data);
+
+			++first;
+		}
+
+		return npos;
+	}
+
+	// Index of the last occurrence that starts at or before pos, or npos.
+	[[nodiscard]] size_type rfind(char ch, size_type pos = npos) const noexcept
+	{
+		if (empty())
+			return npos;
+
+		for (size_type i = pos < m_size ? pos + 1 : m_size; i > 0; --i)
+		{
+			if (m_data[i - 1] == ch)
+				return i - 1;
+		}
+
+		return npos;
+	}
+
+	[[nodiscard]] size_type rfind(string_view needle, size_type pos = npos) const noexcept
+	{
+		if (needle.m_size > m_size)
+			return npos;
+
+		size_type last = m_size - needle.m_size;
+
+		for (size_type i = (pos < last ? pos : last) + 1; i > 0; --i)
+		{
+			if (same_chars(m_data + i - 1, needle.m_data, needle.m_size))
+				return i - 1;
+		}
+
+		return npos;
+	}
+
+	[[nodiscard]] bool starts_with(string_view prefix) const noexcept
+	{
+		return m_size >= prefix.m_size && same_chars(m_data, prefix.m_data, prefix.m_size);
+	}
+
+	[[nodiscard]] bool starts_with(char ch) const noexcept { return !empty() && front() == ch; }
+
+	[[nodiscard]] bool ends_with(string_view suffix) const noexcept
+	{
+		return m_size >= suffix.m_size &&
+			   same_chars(m_data + m_size - suffix.m_size, suffix.m_data, suffix.m_size);
+	}
+
+	[[nodiscard]] bool ends_with(char ch) const noexcept { return !empty() && back() == ch; }
+
+	// Negative, zero or positive as this view sorts before, equal to or after
+	// other, comparing the characters as unsigned bytes.
+	[[nodiscard]] int compare(string_view other) const noexcept
+	{
+		size_type common = m_size < other.m_size ? m_size : other.m_size;
+		int result = common ? std::memcmp(m_data, other.m_data, common) : 0;
+
+		if (result)
+			return result;
+
+		return m_size == other.m_size ? 0 : (m_size < other.m_size ? -1 : 1);
+	}
+
+	// Lazily splits at every delimiter. A delimiter at either end or two in
+	// a row give empty pieces, an empty view gives no pieces and an empty
+	// delimiter splits into single characters.
+	[[nodiscard]] split_view<char> split(char delimiter) const noexcept;
+	[[nodiscard]] split_view<string_view> split(string_view delimiter) const noexcept;
+
+	friend bool operator==(string_view lhs, string_view rhs) noexcept
+	{
+		return lhs.m_size == rhs.m_size && same_chars(lhs.m_data, rhs.m_data, lhs.m_size);
+	}
+
+	friend bool operator!=(string_view lhs, string_view rhs) noexcept { return !(lhs == rhs); }
+
+	friend bool operator<(string_view lhs, string_view rhs) noexcept
+	{
+		return lhs.compare(rhs) < 0;
+	}
+
+	friend bool operator<=(string_view lhs, string_view rhs) noexcept
+	{
+		return lhs.compare(rhs) <= 0;
+	}
+
+	friend bool operator>(string_view lhs, string_view rhs) noexcept
+	{
+		return lhs.compare(rhs) > 0;
+	}
+
+	friend bool operator>=(string_view lhs, string_view rhs) noexcept
+	{
+		return lhs.compare(rhs) >= 0;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, string_view view)
+	{
+		return os.write(view.m_data, static_cast<std::streamsize>(view.m_size));
+	}
+
+private:
+	// memcmp must not see the null pointer of an empty view, even for no
+	// characters.
+	[[nodiscard]] static bool same_chars(const char* lhs, const char* rhs, size_type count) noexcept
+	{
+		return !count || !std::memcmp(lhs, rhs, count);
+	}
+
+	const char* m_data = nullptr;
+	size_type m_size = 0;
+};
+
+// The pieces of a string_view between the delimiters, found one at a time
+// while iterating.
+template <class Delimiter>
+class split_view
+{
+	using size_type = string_view::size_type;
+
+public:
+	class iterator
+	{
+	public:
+		using value_type = string_view;
+		using reference = string_view;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::input_iterator_tag;
+
+		iterator() = default;
+
+		explicit iterator(const split_view* parent) :
+			m_parent(parent), m_done(parent->m_text.empty())
+		{
+			if (!m_done)
+				m_end = m_parent->find_end(0);
+		}
+
+		reference operator*() const
+		{
+			return string_view(m_parent->m_text.data() + m_begin, m_end - m_begin);
+		}
+
+		iterator& operator++()
+		{
+			if (m_end == m_parent->m_text.size())
+			{
+				m_done = true;
+				return *this;
+			}
+
+			m_begin = m_end + m_parent->delimiter_size();
+			m_end = m_parent->find_end(m_begin);
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator it(*this);
+			++*this;
+			return it;
+		}
+
+		friend bool operator==(const iterator& lhs, const iterator& rhs)
+		{
+			if (lhs.m_done || rhs.m_done)
+				return lhs.m_done == rhs.m_done;
+
+			return lhs.m_begin == rhs.m_begin;
+		}
+
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) { return !(lhs == rhs); }
+
+	private:
+		const split_view* m_parent = nullptr;
+		size_type m_begin = 0;
+		size_type m_end = 0;
+		bool m_done = true;
+	};
+
+	split_view(string_view text, Delimiter delimiter) noexcept :
+		m_text(text), m_delimiter(delimiter)
+	{
+	}
+
+	[[nodiscard]] iterator begin() const { return iterator(this); }
+	[[nodiscard]] iterator end() const { return iterator(); }
+
+private:
+	[[nodiscard]] size_type delimiter_size() const noexcept
+	{
+		if constexpr (std::is_same_v<Delimiter, char>)
+			return 1;
+
+		else
+			return m_delimiter.size();
+	}
+
+	// The end of the piece that starts at begin.
+	[[nodiscard]] size_type find_end(size_type begin) const noexcept
+	{
+		if (delimiter_size() == 0)
+			return begin < m_text.size() ? begin + 1 : begin;
+
+		size_type match = m_text.find(m_delimiter, begin);
+		return match == string_view::npos ? m_text.size() : match;
+	}
+
+	string_view m_text;
+	Delimiter m_delimiter;
+};
+
+inline split_view<char> string_view::split(char delimiter) const noexcept
+{
+	return split_view<char>(*this, delimiter);
+}
+
+inline split_view<string_view> string_view::split(string_view delimiter) const noexcept
+{
+	return split_view<string_view>(*this, delimiter);
+}
+
+} // namespace simple
+
+#endif // STRING_VIEW_H
@@ -0,0 +1,247 @@
+#include "thread_pool.h"
+
+#include <functional>
+
+namespace
+{
+
+thread_local const simple::thread_pool* t_pool = nullptr;
+thread_local void* t_worker = nullptr;
+
+// Per thread xorshift state for picking the first steal victim.
+thread_local std::uint32_t t_victim_seed = 0;
+
+std::uint32_t next_victim_seed() noexcept
+{
+	if (t_victim_seed == 0)
+		t_victim_seed = static_cast<std::uint32_t>(
+			std::hash<std::thread::id>()(std::this_thread::get_id()) | 1);
+
+	t_victim_seed ^= t_victim_seed << 13;
+	t_victim_seed ^= t_victim_seed >> 17;
+	t_victim_seed ^= t_victim_seed << 5;
+
+	return t_victim_seed;
+}
+
+} // namespace
+
+simple::thread_pool::thread_pool(size_type thread_count)
+{
+	if (thread_count == 0)
+		thread_count = 1;
+
+	m_workers.reserve(thread_count);
+
+	for (size_type i = 0; i < thread_count; ++i)
+		m_workers.push_back(make_unique<worker>());
+
+	// Every deque exists before the first worker starts stealing.
+	for (auto& self : m_workers)
+		self->thread = std::thread(&thread_pool::worker_loop, this, self.get());
+}
+
+simple::thread_pool::~thread_pool() { shutdown(); }
+
+simple::size_type simple::thread_pool::default_thread_count() noexcept
+{
+	unsigned hardware_threads = std::thread::hardware_concurrency();
+	return hardware_threads ? hardware_threads : 1;
+}
+
+void simple::thread_pool::shutdown()
+{
+	// Under the injection lock, so that a task injected concurrently is
+	// either counted in m_queued before the workers can see m_stopping or
+	// rejected by schedule.
+	{
+		std::lock_guard<std::mutex> injection_lock(m_injection_mutex);
+		std::lock_guard<std::mutex> sleep_lock(m_sleep_mutex);
+		m_stopping.store(true, std::memory_order_seq_cst);
+	}
+
+	m_wake.notify_all();
+
+	for (auto& self : m_workers)
+	{
+		if (self->thread.joinable())
+			self->thread.join();
+	}
+}
+
+bool simple::thread_pool::run_pending_task()
+{
+	pool_task* task = nullptr;
+
+	if (!take_task(task))
+		return false;
+
+	task->run(task);
+
+	return true;
+}
+
+void simple::thread_pool::schedule(pool_task* task)
+{
+	if (worker* self = current_worker())
+	{
+		m_queued.fetch_add(1, std::memory_order_seq_cst);
+
+		try
+		{
+			self->deque.push(task);
+		}
+
+		catch (...)
+		{
+			m_queued.fetch_sub(1, std::memory_order_relaxed);
+			throw;
+		}
+	}
+
+	else
+	{
+		std::lock_guard<std::mutex> lock(m_injection_mutex);
+
+		if (m_stopping.load(std::memory_order_relaxed))
+			throw std::runtime_error("thread_pool is shut down");
+
+		m_queued.fetch_add(1, std::memory_order_seq_cst);
+
+		try
+		{
+			m_injected.push_back(task);
+		}
+
+		catch (...)
+		{
+			m_queued.fetch_sub(1, std::memory_order_relaxed);
+			throw;
+		}
+	}
+
+	if (m_sleepers.load(std::memory_order_seq_cst) > 0)
+	{
+		// Taking the lock orders the notification after a worker that is
+		// about to sleep has checked m_queued.
+		{
+			std::lock_guard<std::mutex> lock(m_sleep_mutex);
+		}
+
+		m_wake.notify_one();
+	}
+}
+
+void simple::thread_pool::wait_for(const std::atomic<bool>& done)
+{
+	if (current_worker())
+	{
+		while (!done.load(std::memory_order_acquire))
+		{
+			if (!run_pending_task())
+				std::this_thread::yield();
+		}
+
+		return;
+	}
+
+	m_external_waiters.fetch_add(1, std::memory_order_seq_cst);
+
+	{
+		std::unique_lock<std::mutex> lock(m_done_mutex);
+		m_done.wait(lock, [&done] { return done.load(std::memory_order_seq_cst); });
+	}
+
+	m_external_waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void simple::thread_pool::complete(std::atomic<bool>& done)
+{
+	// done may be destroyed as soon as it is set, it is not touched after.
+	done.store(true, std::memory_order_seq_cst);
+
+	if (m_external_waiters.load(std::memory_order_seq_cst) > 0)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_done_mutex);
+		}
+
+		m_done.notify_all();
+	}
+}
+
+bool simple::thread_pool::take_task(pool_task*& task)
+{
+	worker* self = current_worker();
+
+	if (self && self->deque.pop(task))
+	{
+		m_queued.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	if (m_queued.load(std::memory_order_relaxed) <= 0)
+		return false;
+
+	{
+		std::lock_guard<std::mutex> lock(m_injection_mutex);
+
+		if (!m_injected.empty())
+		{
+			task = m_injected.front();
+			m_injected.pop_front();
+
+			m_queued.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	size_type count = m_workers.size();
+	size_type start = next_victim_seed() % count;
+
+	for (size_type i = 0; i < count; ++i)
+	{
+		worker* victim = m_workers[(start + i) % count].get();
+
+		if (victim != self && victim->deque.steal(task))
+		{
+			m_queued.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+simple::thread_pool::worker* simple::thread_pool::current_worker() const noexcept
+{
+	return t_pool == this ? static_cast<worker*>(t_worker) : nullptr;
+}
+
+void simple::thread_pool::worker_loop(worker* self)
+{
+	t_pool = this;
+	t_worker = self;
+
+	while (true)
+	{
+		if (run_pending_task())
+			continue;
+
+		std::unique_lock<std::mutex> lock(m_sleep_mutex);
+
+		m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+		m_wake.wait(lock, [this] {
+			return m_stopping.load(std::memory_order_seq_cst) ||
+				   m_queued.load(std::memory_order_seq_cst) > 0;
+		});
+		m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+
+		if (m_stopping.load(std::memory_order_seq_cst) &&
+			m_queued.load(std::memory_order_seq_cst) <= 0)
+			break;
+	}
+
+	t_pool = nullptr;
+	t_worker = nullptr;
+}
@@ -0,0 +1,425 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "list.h"
+#include "node_pool.h"
+#include "small_function.h"
+#include "unique_ptr.h"
+#include "vector.h"
+#include "work_stealing_deque.h"
+
+namespace simple
+{
+
+class thread_pool;
+
+// Unit of work in the pool's queues. The pool never owns a task: parallel_for
+// keeps its tasks on the stack of the forking thread, submit keeps its task in
+// the shared state of the returned future.
+struct pool_task
+{
+	void (*run)(pool_task* task) = nullptr;
+};
+
+template <class R>
+class future;
+
+// A reference result is stored as a pointer to the referred object.
+template <class R>
+class future_state : public pool_task
+{
+	static_assert(!std::is_rvalue_reference_v<R>, "Tasks cannot return rvalue references");
+
+	using result_type = std::conditional_t<std::is_void_v<R>, char,
+										   std::conditional_t<std::is_reference_v<R>,
+															  std::remove_reference_t<R>*, R>>;
+
+	friend class future<R>;
+
+public:
+	template <class F>
+	future_state(thread_pool& pool, F&& func) : m_function(std::forward<F>(func)), m_pool(pool)
+	{
+		run = &execute;
+	}
+
+	~future_state()
+	{
+		if (m_has_result)
+			result()->~result_type();
+	}
+
+	future_state(const future_state& other) = delete;
+	future_state& operator=(const future_state& other) = delete;
+
+	static void* operator new(std::size_t /*size*/)
+	{
+		return node_pool<future_state>::instance().allocate();
+	}
+
+	static void operator delete(void* ptr) noexcept
+	{
+		node_pool<future_state>::instance().deallocate(ptr);
+	}
+
+	// The state is shared by the future and the queued task, the last one to
+	// let go frees it.
+	void release() noexcept
+	{
+		if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete this;
+	}
+
+private:
+	static void execute(pool_task* task);
+
+	[[nodiscard]] result_type* result() noexcept
+	{
+		return std::launder(reinterpret_cast<result_type*>(m_result));
+	}
+
+	small_function<R()> m_function;
+	thread_pool& m_pool;
+	std::exception_ptr m_error;
+	std::atomic<bool> m_ready {false};
+	std::atomic<int> m_references {2};
+	bool m_has_result = false;
+	alignas(result_type) unsigned char m_result[sizeof(result_type)];
+};
+
+// Result of thread_pool::submit. Unlike std::future it is bound to its pool:
+// waiting on a pool thread runs other queued tasks instead of blocking, so
+// tasks may wait for the tasks they submit.
+template <class R>
+class future
+{
+public:
+	future() = default;
+
+	explicit future(future_state<R>* state) : m_state(state) {}
+
+	future(future&& other) noexcept : m_state(std::exchange(other.m_state, nullptr)) {}
+
+	future& operator=(future&& other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			m_state = std::exchange(other.m_state, nullptr);
+		}
+
+		return *this;
+	}
+
+	future(const future& other) = delete;
+	future& operator=(const future& other) = delete;
+
+	~future() { reset(); }
+
+	[[nodiscard]] bool valid() const noexcept { return m_state != nullptr; }
+
+	[[nodiscard]] bool is_ready() const noexcept
+	{
+		return m_state->m_ready.load(std::memory_order_acquire);
+	}
+
+	void wait() const;
+
+	// Waits for the task and returns its result or rethrows its exception.
+	// Leaves the future invalid.
+	R get();
+
+private:
+	void reset() noexcept
+	{
+		if (m_state)
+			std::exchange(m_state, nullptr)->release();
+	}
+
+	future_state<R>* m_state = nullptr;
+};
+
+// Fixed set of worker threads, each with a Chase-Lev deque. Tasks scheduled
+// from a worker go to the bottom of its own deque, idle workers steal from
+// the top of the others. Tasks scheduled from other threads go through a
+// shared injection queue. Idle workers sleep until new tasks arrive.
+class thread_pool
+{
+	template <class R>
+	friend class future_state;
+
+	template <class R>
+	friend class future;
+
+	struct worker
+	{
+		work_stealing_deque<pool_task*> deque;
+		std::thread thread;
+	};
+
+	template <class Func>
+	struct range_task : pool_task
+	{
+		range_task(thread_pool& t_pool, size_type t_first, size_type t_last, size_type t_grain,
+				   Func& t_func) :
+			pool(t_pool), first(t_first), last(t_last), grain(t_grain), func(t_func)
+		{
+			run = &execute;
+		}
+
+		static void execute(pool_task* task)
+		{
+			auto* self = static_cast<range_task*>(task);
+
+			try
+			{
+				self->pool.split_range(self->first, self->last, self->grain, self->func);
+			}
+
+			catch (...)
+			{
+				self->error = std::current_exception();
+			}
+
+			self->pool.complete(self->done);
+		}
+
+		thread_pool& pool;
+		size_type first;
+		size_type last;
+		size_type grain;
+		Func& func;
+		std::exception_ptr error;
+		std::atomic<bool> done {false};
+	};
+
+public:
+	explicit thread_pool(size_type thread_count = default_thread_count());
+
+	// Runs the tasks that are still queued, then joins the workers.
+	~thread_pool();
+
+	thread_pool(const thread_pool& other) = delete;
+	thread_pool& operator=(const thread_pool& other) = delete;
+
+	[[nodiscard]] static size_type default_thread_count() noexcept;
+
+	[[nodiscard]] size_type thread_count() const noexcept { return m_workers.size(); }
+
+	// Queues func() and returns a future for its result. The callable is
+	// stored inline in the future's shared state, which comes from a slab
+	// pool, so submitting does not call malloc. Throws std::runtime_error
+	// once the pool is shut down.
+	template <class F>
+	future<std::invoke_result_t<std::decay_t<F>&>> submit(F&& func)
+	{
+		using result_type = std::invoke_result_t<std::decay_t<F>&>;
+
+		auto* state = new future_state<result_type>(*this, std::forward<F>(func));
+
+		try
+		{
+			schedule(state);
+		}
+
+		catch (...)
+		{
+			delete state;
+			throw;
+		}
+
+		return future<result_type>(state);
+	}
+
+	// Calls func(i) for every i in [first, last). The range is split in
+	// halves down to grain indices, the halves are forked onto the calling
+	// worker's deque for others to steal. Returns once every index is done
+	// and rethrows the first exception thrown by func.
+	template <class Func>
+	void parallel_for(size_type first, size_type last, size_type grain, Func&& func)
+	{
+		if (first >= last)
+			return;
+
+		if (grain == 0)
+			grain = 1;
+
+		if (current_worker())
+		{
+			split_range(first, last, grain, func);
+			return;
+		}
+
+		// Other threads hand the whole range to the pool and block.
+		range_task<std::remove_reference_t<Func>> root(*this, first, last, grain, func);
+		schedule(&root);
+		wait_for(root.done);
+
+		if (root.error)
+			std::rethrow_exception(root.error);
+	}
+
+	// Stops accepting submissions, runs the queued tasks and joins the
+	// workers. Must not be called from a task of this pool.
+	void shutdown();
+
+	// Runs one queued task on the calling thread, returns false if there was
+	// none.
+	bool run_pending_task();
+
+private:
+	template <class Func>
+	void split_range(size_type first, size_type last, size_type grain, Func& func)
+	{
+		if (last - first <= grain)
+		{
+			for (; first < last; ++first)
+				func(first);
+
+			return;
+		}
+
+		size_type middle = first + (last - first) / 2;
+
+		range_task<Func> upper(*this, middle, last, grain, func);
+		schedule(&upper);
+
+		std::exception_ptr error;
+
+		try
+		{
+			split_range(first, middle, grain, func);
+		}
+
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+
+		// The upper half lives in this frame, it must finish even if the
+		// lower half threw.
+		wait_for(upper.done);
+
+		if (error)
+			std::rethrow_exception(error);
+
+		if (upper.error)
+			std::rethrow_exception(upper.error);
+	}
+
+	// Throws std::runtime_error when called from another thread once the
+	// pool is shut down. Workers may still schedule, they drain their own
+	// deques before they exit.
+	void schedule(pool_task* task);
+
+	// Pool threads run other tasks until done is set, other threads block.
+	void wait_for(const std::atomic<bool>& done);
+
+	// Sets done and wakes the threads blocked in wait_for.
+	void complete(std::atomic<bool>& done);
+
+	[[nodiscard]] bool take_task(pool_task*& task);
+
+	// The worker running on the calling thread, null on other threads.
+	[[nodiscard]] worker* current_worker() const noexcept;
+
+	void worker_loop(worker* self);
+
+	vector<unique_ptr<worker>> m_workers;
+
+	std::mutex m_injection_mutex;
+	list<pool_task*> m_injected;
+
+	// Tasks scheduled but not yet taken, incremented before a task is queued.
+	std::atomic<std::ptrdiff_t> m_queued {0};
+
+	std::mutex m_sleep_mutex;
+	std::condition_variable m_wake;
+	std::atomic<size_type> m_sleepers {0};
+	std::atomic<bool> m_stopping {false};
+
+	std::mutex m_done_mutex;
+	std::condition_variable m_done;
+	std::atomic<size_type> m_external_waiters {0};
+};
+
+template <class R>
+void future_state<R>::execute(pool_task* task)
+{
+	auto* state = static_cast<future_state*>(task);
+
+	try
+	{
+		if constexpr (std::is_void_v<R>)
+			state->m_function();
+
+		else if constexpr (std::is_reference_v<R>)
+			new (state->m_result) result_type(&state->m_function());
+
+		else
+			new (state->m_result) R(state->m_function());
+
+		state->m_has_result = !std::is_void_v<R>;
+	}
+
+	catch (...)
+	{
+		state->m_error = std::current_exception();
+	}
+
+	state->m_function = nullptr;
+	state->m_pool.complete(state->m_ready);
+	state->release();
+}
+
+template <class R>
+void future<R>::wait() const
+{
+	m_state->m_pool.wait_for(m_state->m_ready);
+}
+
+template <class R>
+R future<R>::get()
+{
+	wait();
+
+	if (m_state->m_error)
+	{
+		std::exception_ptr error = m_state->m_error;
+		reset();
+		std::rethrow_exception(error);
+	}
+
+	if constexpr (std::is_void_v<R>)
+		reset();
+
+	else if constexpr (std::is_reference_v<R>)
+	{
+		R value = **m_state->result();
+		reset();
+		return value;
+	}
+
+	else
+	{
+		R value = std::move(*m_state->result());
+		reset();
+		return value;
+	}
+}
+
+} // namespace simple
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,32 @@
+#ifndef TRAITS_H
+#define TRAITS_H
+
+#include <type_traits>
+
+namespace simple
+{
+
+// A type is trivially relocatable when moving an object to a new address and
+// destroying the original can be done with a plain memcpy of its bytes, with
+// the original then simply forgotten. This holds for trivially copyable
+// types and for most types that only own heap memory, but not for types that
+// point into themselves. Specialize it for such user types to let the
+// containers relocate them with memcpy/memmove/realloc.
+template <class T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+{
+};
+
+template <class T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Types whose value-initialized state is all zero bytes, so that containers
+// can value-initialize them with memset. Not every trivial type: a null
+// pointer to data member is -1 on the Itanium ABI.
+template <class T>
+constexpr bool is_zero_initialized_by_memset_v =
+	std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+} // namespace simple
+
+#endif // TRAITS_H
@@ -3,6 +3,8 @@
 
 #include <utility>
 
+#include "traits.h"
+
 namespace simple
 {
 
@@ -109,6 +111,11 @@ unique_ptr<T> make_unique(Args&&... args)
 	return unique_ptr<T>(new T(std::forward<Args>(args)...));
 }
 
+template <class T>
+struct is_trivially_relocatable<unique_ptr<T>> : std::true_type
+{
+};
+
 } // namespace simple
 
 #endif // UNIQUE_PTR_H
@@ -0,0 +1,460 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "node_pool.h"
+#include "unique_ptr.h"
+
+namespace simple
+{
+
+using size_type = std::size_t;
+
+// Default number of elements per node, chosen so that a node spans about
+// four cache lines.
+template <class T>
+constexpr size_type unrolled_list_default_capacity =
+	(256 - 3 * sizeof(void*)) / sizeof(T) > 4 ? (256 - 3 * sizeof(void*)) / sizeof(T) : 4;
+
+template <class T, size_type N>
+struct unrolled_list_node
+{
+	static_assert(std::is_nothrow_move_constructible_v<T>,
+				  "Elements are shifted within and between nodes by moving them");
+
+	explicit unrolled_list_node(unrolled_list_node* t_prev,
+								unique_ptr<unrolled_list_node>&& t_next) :
+		prev(t_prev), next(std::move(t_next))
+	{
+	}
+
+	~unrolled_list_node()
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			for (size_type i = 0; i < count; ++i)
+				element(i)->~T();
+		}
+	}
+
+	unrolled_list_node(const unrolled_list_node& other) = delete;
+	unrolled_list_node& operator=(const unrolled_list_node& other) = delete;
+
+	static void* operator new(std::size_t /*size*/)
+	{
+		return node_pool<unrolled_list_node>::instance().allocate();
+	}
+
+	static void operator delete(void* ptr) noexcept
+	{
+		node_pool<unrolled_list_node>::instance().deallocate(ptr);
+	}
+
+	[[nodiscard]] T* element(size_type index) noexcept
+	{
+		return std::launder(reinterpret_cast<T*>(m_storage + index * sizeof(T)));
+	}
+
+	// Constructs the element in place when it goes at the end. Otherwise it
+	// is built before the elements are shifted, since the arguments may refer
+	// to one of them, and a throwing constructor then leaves the node as is.
+	template <typename... Args>
+	T& emplace_at(size_type index, Args&&... args)
+	{
+		if (index == count)
+		{
+			new (element(index)) T(std::forward<Args>(args)...);
+			++count;
+
+			return *element(index);
+		}
+
+		T value(std::forward<Args>(args)...);
+		return insert_at(index, std::move(value));
+	}
+
+	// value must not be an element of this node.
+	T& insert_at(size_type index, T&& value) noexcept
+	{
+		for (size_type i = count; i > index; --i)
+			relocate(element(i - 1), element(i));
+
+		new (element(index)) T(std::move(value));
+		++count;
+
+		return *element(index);
+	}
+
+	void erase_at(size_type index) noexcept
+	{
+		element(index)->~T();
+
+		for (size_type i = index + 1; i < count; ++i)
+			relocate(element(i), element(i - 1));
+
+		--count;
+	}
+
+	// Moves the elements from index onwards to the end of other.
+	void move_elements_to(unrolled_list_node& other, size_type index) noexcept
+	{
+		for (size_type i = index; i < count; ++i)
+			relocate(element(i), other.element(other.count++));
+
+		count = index;
+	}
+
+	unrolled_list_node* prev;
+	unique_ptr<unrolled_list_node> next;
+	size_type count = 0;
+
+private:
+	static void relocate(T* from, T* to) noexcept
+	{
+		new (to) T(std::move(*from));
+		from->~T();
+	}
+
+	alignas(T) unsigned char m_storage[sizeof(T) * N];
+};
+
+template <typename T, size_type N, bool Const = false>
+class unrolled_list_iterator
+{
+public:
+	using value_type = T;
+	using reference = typename std::conditional_t<Const, value_type const&, value_type&>;
+	using pointer = typename std::conditional_t<Const, value_type const*, value_type*>;
+	using iterator_category = std::bidirectional_iterator_tag;
+	using difference_type = std::ptrdiff_t;
+
+	using node = unrolled_list_node<T, N>;
+	using node_pointer = node*;
+
+	friend class unrolled_list_iterator<T, N, true>;
+
+	template <typename U, size_type M>
+	friend class unrolled_list;
+
+	unrolled_list_iterator() = default;
+
+	explicit unrolled_list_iterator(node_pointer ptr, size_type index, node_pointer tail) :
+		m_ptr(ptr), m_index(index), m_tail(tail)
+	{
+	}
+
+	template <bool Const_ = Const, class = std::enable_if_t<Const_>>
+	unrolled_list_iterator(const unrolled_list_iterator<T, N, false>& rhs) :
+		m_ptr(rhs.m_ptr), m_index(rhs.m_index), m_tail(rhs.m_tail)
+	{
+	}
+
+	unrolled_list_iterator& operator++()
+	{
+		if (++m_index == m_ptr->count)
+		{
+			m_ptr = m_ptr->next.get();
+			m_index = 0;
+		}
+
+		return *this;
+	}
+
+	unrolled_list_iterator operator++(int)
+	{
+		unrolled_list_iterator it(*this);
+		++*this;
+		return it;
+	}
+
+	unrolled_list_iterator& operator--()
+	{
+		if (!m_ptr)
+		{
+			m_ptr = m_tail;
+			m_index = m_ptr->count - 1;
+		}
+
+		else if (m_index == 0)
+		{
+			m_ptr = m_ptr->prev;
+			m_index = m_ptr->count - 1;
+		}
+
+		else
+			--m_index;
+
+		return *this;
+	}
+
+	unrolled_list_iterator operator--(int)
+	{
+		unrolled_list_iterator it(*this);
+		--*this;
+		return it;
+	}
+
+	reference operator*() const { return *m_ptr->element(m_index); }
+
+	pointer operator->() const { return m_ptr->element(m_index); }
+
+	friend bool operator==(const unrolled_list_iterator& lhs, const unrolled_list_iterator& rhs)
+	{
+		return lhs.m_ptr == rhs.m_ptr && lhs.m_index == rhs.m_index;
+	}
+
+	friend bool operator!=(const unrolled_list_iterator& lhs, const unrolled_list_iterator& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+private:
+	node_pointer m_ptr = nullptr;
+	size_type m_index = 0;
+	node_pointer m_tail = nullptr;
+};
+
+// Linked list of nodes holding up to N elements each. Traversal touches one
+// node per N elements, while insertion and erasure only shift the elements
+// of a single node. Full nodes are split in half on insertion and sparse
+// neighbours are merged on erasure. Inserting or erasing invalidates
+// iterators to the elements of the affected nodes.
+template <class T, size_type N = unrolled_list_default_capacity<T>>
+class unrolled_list
+{
+	static_assert(N >= 2, "An unrolled_list node must hold at least two elements");
+
+public:
+	using value_type = T;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using node = unrolled_list_node<T, N>;
+	using iterator = unrolled_list_iterator<T, N>;
+	using const_iterator = unrolled_list_iterator<T, N, true>;
+
+	constexpr static size_type node_capacity = N;
+
+	unrolled_list() = default;
+	~unrolled_list() { clear(); }
+
+	unrolled_list(unrolled_list&& other) noexcept :
+		m_head(std::move(other.m_head)), m_tail(std::exchange(other.m_tail, nullptr)),
+		m_size(std::exchange(other.m_size, 0))
+	{
+	}
+
+	unrolled_list(const unrolled_list& other) = delete;
+	unrolled_list& operator=(const unrolled_list& other) = delete;
+
+	void clear() noexcept
+	{
+		while (m_head)
+			m_head = std::move(m_head->next);
+
+		m_size = 0;
+		m_tail = nullptr;
+	}
+
+	[[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+	[[nodiscard]] size_type size() const noexcept { return m_size; }
+
+	void push_front(const_reference item) { emplace_front(item); }
+
+	void push_front(T&& item) { emplace_front(std::move(item)); }
+
+	template <typename... Args>
+	reference emplace_front(Args&&... args)
+	{
+		if (m_head && m_head->count < N)
+		{
+			reference result = m_head->emplace_at(0, std::forward<Args>(args)...);
+			++m_size;
+
+			return result;
+		}
+
+		// Built before the node is linked, so that a throwing constructor
+		// leaves no empty node behind.
+		T value(std::forward<Args>(args)...);
+		insert_node_after(nullptr);
+		++m_size;
+
+		return m_head->insert_at(0, std::move(value));
+	}
+
+	void pop_front() { erase(begin()); }
+
+	void push_back(const_reference item) { emplace_back(item); }
+
+	void push_back(T&& item) { emplace_back(std::move(item)); }
+
+	template <typename... Args>
+	reference emplace_back(Args&&... args)
+	{
+		if (m_tail && m_tail->count < N)
+		{
+			reference result = m_tail->emplace_at(m_tail->count, std::forward<Args>(args)...);
+			++m_size;
+
+			return result;
+		}
+
+		// Built before the node is linked, so that a throwing constructor
+		// leaves no empty node behind.
+		T value(std::forward<Args>(args)...);
+		insert_node_after(m_tail);
+		++m_size;
+
+		return m_tail->insert_at(0, std::move(value));
+	}
+
+	void pop_back()
+	{
+		m_tail->erase_at(m_tail->count - 1);
+		--m_size;
+
+		if (m_tail->count == 0)
+			remove_node(m_tail);
+	}
+
+	iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+
+	iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+	template <class... Args>
+	iterator emplace(const_iterator pos, Args&&... args)
+	{
+		if (!pos.m_ptr)
+		{
+			emplace_back(std::forward<Args>(args)...);
+			return iterator(m_tail, m_tail->count - 1, m_tail);
+		}
+
+		node* target = pos.m_ptr;
+		size_type index = pos.m_index;
+
+		if (target->count < N)
+		{
+			target->emplace_at(index, std::forward<Args>(args)...);
+			++m_size;
+
+			return iterator(target, index, m_tail);
+		}
+
+		// The arguments may refer to elements that the split moves.
+		T value(std::forward<Args>(args)...);
+
+		node* upper = insert_node_after(target);
+		target->move_elements_to(*upper, (N + 1) / 2);
+
+		if (index > target->count)
+		{
+			index -= target->count;
+			target = upper;
+		}
+
+		target->insert_at(index, std::move(value));
+		++m_size;
+
+		return iterator(target, index, m_tail);
+	}
+
+	iterator erase(const_iterator pos)
+	{
+		node* target = pos.m_ptr;
+		size_type index = pos.m_index;
+
+		target->erase_at(index);
+		--m_size;
+
+		if (target->count == 0)
+		{
+			node* next = target->next.get();
+			remove_node(target);
+
+			return iterator(next, 0, m_tail);
+		}
+
+		if (target->prev && target->prev->count + target->count <= N / 2)
+		{
+			node* prev = target->prev;
+			index += prev->count;
+
+			target->move_elements_to(*prev, 0);
+			remove_node(target);
+			target = prev;
+		}
+
+		else if (target->next && target->count + target->next->count <= N / 2)
+		{
+			target->next->move_elements_to(*target, 0);
+			remove_node(target->next.get());
+		}
+
+		if (index < target->count)
+			return iterator(target, index, m_tail);
+
+		return iterator(target->next.get(), 0, m_tail);
+	}
+
+	[[nodiscard]] reference front() { return *m_head->element(0); }
+	[[nodiscard]] const_reference front() const { return *m_head->element(0); }
+
+	[[nodiscard]] reference back() { return *m_tail->element(m_tail->count - 1); }
+	[[nodiscard]] const_reference back() const { return *m_tail->element(m_tail->count - 1); }
+
+	[[nodiscard]] iterator begin() const noexcept { return iterator(m_head.get(), 0, m_tail); }
+	[[nodiscard]] const_iterator cbegin() const noexcept
+	{
+		return const_iterator(m_head.get(), 0, m_tail);
+	}
+
+	[[nodiscard]] iterator end() const noexcept { return iterator(nullptr, 0, m_tail); }
+	[[nodiscard]] const_iterator cend() const noexcept
+	{
+		return const_iterator(nullptr, 0, m_tail);
+	}
+
+private:
+	// Links a new empty node after pos, or at the front when pos is null.
+	node* insert_node_after(node* pos)
+	{
+		unique_ptr<node>& owner = pos ? pos->next : m_head;
+		owner = make_unique<node>(pos, std::move(owner));
+
+		node* new_node = owner.get();
+
+		if (new_node->next)
+			new_node->next->prev = new_node;
+		else
+			m_tail = new_node;
+
+		return new_node;
+	}
+
+	void remove_node(node* pos) noexcept
+	{
+		unique_ptr<node>& owner = pos->prev ? pos->prev->next : m_head;
+
+		if (pos->next)
+			pos->next->prev = pos->prev;
+		else
+			m_tail = pos->prev;
+
+		owner = std::move(pos->next);
+	}
+
+	unique_ptr<node> m_head = nullptr;
+	node* m_tail = nullptr;
+	size_type m_size = 0;
+};
+
+} // namespace simple
+
+#endif // UNROLLED_LIST_H
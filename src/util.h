@@ -1,6 +1,14 @@
 #ifndef UTIL_H
 #define UTIL_H
 
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "iterator.h"
+#include "pair.h"
+#include "simd.h"
+
 template <typename T>
 [[nodiscard]] bool compare_values(const T &first, const T &second)
 {
@@ -15,9 +23,134 @@ template <typename T>
 
 namespace simple
 {
+	namespace detail
+	{
+		// Element type of iterators over contiguous memory, void for others.
+		template <class It>
+		struct contiguous_element
+		{
+			using type = void;
+		};
+
+		template <class T>
+		struct contiguous_element<T *>
+		{
+			using type = std::remove_cv_t<T>;
+		};
+
+		template <class T, bool Const>
+		struct contiguous_element<random_access_iterator<T, Const>>
+		{
+			using type = std::remove_cv_t<T>;
+		};
+
+		template <class It>
+		using contiguous_element_t = typename contiguous_element<It>::type;
+
+		// Elements that are equal exactly when their bytes are, so integers,
+		// enums and pointers, but not floating point.
+		template <class T>
+		constexpr bool is_bitwise_comparable_v =
+			std::is_scalar_v<T> && std::has_unique_object_representations_v<T>;
+
+		template <class T, class = void>
+		struct is_vectorizable_element : std::false_type
+		{
+		};
+
+		template <class T>
+		struct is_vectorizable_element<T, std::enable_if_t<is_bitwise_comparable_v<T>>>
+			: std::bool_constant<sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+								 sizeof(T) == 8>
+		{
+		};
+
+		template <class It>
+		constexpr bool is_vectorizable_v =
+			is_vectorizable_element<contiguous_element_t<It>>::value;
+
+		template <std::size_t Size>
+		using unsigned_of_size = std::conditional_t<
+			Size == 1, std::uint8_t,
+			std::conditional_t<Size == 2, std::uint16_t,
+							   std::conditional_t<Size == 4, std::uint32_t, std::uint64_t>>>;
+
+		template <class T>
+		constexpr bool is_integer_v = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+		// Converts value to the element type E when every element compares
+		// equal to value exactly when it equals the converted value, so that
+		// the comparison can be done on the bytes.
+		template <class E, class T>
+		bool to_element(const T &value, E &element)
+		{
+			if constexpr (std::is_same_v<E, std::remove_cv_t<T>>)
+			{
+				element = value;
+				return true;
+			}
+
+			else if constexpr (is_integer_v<E> && is_integer_v<T>)
+			{
+				element = static_cast<E>(value);
+
+				if (static_cast<T>(element) != value)
+					return false;
+
+				if constexpr (std::is_signed_v<E> != std::is_signed_v<T>)
+				{
+					bool element_negative = std::is_signed_v<E> && element < E {};
+					bool value_negative = std::is_signed_v<T> && value < T {};
+
+					return element_negative == value_negative;
+				}
+
+				return true;
+			}
+
+			else
+				return false;
+		}
+
+		template <class E>
+		unsigned_of_size<sizeof(E)> element_bits(const E &element)
+		{
+			unsigned_of_size<sizeof(E)> bits;
+			std::memcpy(&bits, &element, sizeof(E));
+			return bits;
+		}
+
+		template <class It>
+		const void *address_of(It it)
+		{
+			return static_cast<const void *>(&*it);
+		}
+
+		// The vector kernels, memcpy and memcmp cannot run in a constant
+		// expression, so the algorithms below fall back to their loops there.
+		constexpr bool is_constant_evaluated() noexcept
+		{
+			return __builtin_is_constant_evaluated();
+		}
+	} // namespace detail
+
+	// find, count, contains, mismatch and equal compare 16 to 32 elements per
+	// instruction when they run over contiguous integers, enums or pointers,
+	// e.g. a simple::vector<int>, simple::array or simple::string.
+
 	template <class InputIt, class T>
 	constexpr InputIt find(InputIt first, InputIt last, const T &value)
 	{
+		if constexpr (detail::is_vectorizable_v<InputIt>)
+		{
+			detail::contiguous_element_t<InputIt> element {};
+			auto length = static_cast<size_type>(last - first);
+
+			if (!detail::is_constant_evaluated() && length && detail::to_element(value, element))
+				return first + simd::find(detail::address_of(first), length,
+										  detail::element_bits(element));
+		}
+
 		for (; first != last; ++first)
 		{
 			if (*first == value)
@@ -26,6 +159,8 @@ namespace simple
 		return last;
 	}
 
+	// A predicate is opaque to the vector kernels, so find_if stays a scalar
+	// loop.
 	template <class InputIt, class UnaryPredicate>
 	constexpr InputIt find_if(InputIt first, InputIt last, UnaryPredicate p)
 	{
@@ -37,6 +172,100 @@ namespace simple
 
 		return last;
 	}
+
+	template <class InputIt, class T>
+	constexpr size_type count(InputIt first, InputIt last, const T &value)
+	{
+		if constexpr (detail::is_vectorizable_v<InputIt>)
+		{
+			detail::contiguous_element_t<InputIt> element {};
+			auto length = static_cast<size_type>(last - first);
+
+			if (!detail::is_constant_evaluated() && length && detail::to_element(value, element))
+				return simd::count(detail::address_of(first), length,
+								   detail::element_bits(element));
+		}
+
+		size_type matches = 0;
+
+		for (; first != last; ++first)
+		{
+			if (*first == value)
+				++matches;
+		}
+
+		return matches;
+	}
+
+	template <class InputIt, class T>
+	constexpr bool contains(InputIt first, InputIt last, const T &value)
+	{
+		return simple::find(first, last, value) != last;
+	}
+
+	// Returns the first positions where the ranges differ, the second range
+	// must be at least as long as the first.
+	template <class InputIt1, class InputIt2>
+	constexpr pair<InputIt1, InputIt2> mismatch(InputIt1 first1, InputIt1 last1, InputIt2 first2)
+	{
+		using element = detail::contiguous_element_t<InputIt1>;
+
+		if constexpr (detail::is_vectorizable_v<InputIt1> &&
+					  std::is_same_v<element, detail::contiguous_element_t<InputIt2>>)
+		{
+			auto length = static_cast<size_type>(last1 - first1);
+
+			if (!detail::is_constant_evaluated() && length)
+			{
+				const void *lhs = detail::address_of(first1);
+				const void *rhs = detail::address_of(first2);
+
+				size_type bytes = simd::mismatch(lhs, rhs, length * sizeof(element));
+				size_type index = bytes / sizeof(element);
+
+				return pair<InputIt1, InputIt2>(first1 + index, first2 + index);
+			}
+		}
+
+		while (first1 != last1 && *first1 == *first2)
+		{
+			++first1;
+			++first2;
+		}
+
+		return pair<InputIt1, InputIt2>(first1, first2);
+	}
+
+	template <class InputIt1, class InputIt2>
+	constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2)
+	{
+		using element = detail::contiguous_element_t<InputIt1>;
+
+		if constexpr (detail::is_bitwise_comparable_v<element> &&
+					  std::is_same_v<element, detail::contiguous_element_t<InputIt2>>)
+		{
+			if (!detail::is_constant_evaluated())
+			{
+				auto length = static_cast<size_type>(last1 - first1);
+
+				if (length == 0)
+					return true;
+
+				const void *lhs = detail::address_of(first1);
+				const void *rhs = detail::address_of(first2);
+
+				return !std::memcmp(lhs, rhs, length * sizeof(element));
+			}
+		}
+
+		for (; first1 != last1; ++first1, ++first2)
+		{
+			if (!(*first1 == *first2))
+				return false;
+		}
+
+		return true;
+	}
 } // namespace simple
 
 #endif // UTIL_H
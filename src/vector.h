@@ -1,19 +1,37 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
 #include <type_traits>
 #include <utility>
 #include <exception>
 
+#include "block_storage.h"
+#include "growth_policy.h"
 #include "iterator.h"
+#include "traits.h"
 
 namespace simple
 {
 
-template <class T>
+// Growth picks the capacity to grow to, see growth_policy.h, and Storage
+// provides the blocks holding the elements, see block_storage.h.
+template <class T, class Growth = default_growth, class Storage = default_storage>
 class vector
 {
-	constexpr static std::size_t CAPACITY_INCREASE_FACTOR = 2;
+	constexpr static std::size_t block_alignment =
+		Storage::alignment > alignof(T) ? Storage::alignment : alignof(T);
+
+	// Scalars without padding bits or multiple representations of a value
+	// (so not floating point) compare equal exactly when their bytes do.
+	constexpr static bool is_bitwise_comparable =
+		std::is_scalar_v<T> && std::has_unique_object_representations_v<T>;
 
 public:
 	using value_type = T;
@@ -24,21 +42,35 @@ public:
 	using reference = value_type&;
 	using const_reference = value_type const&;
 	using size_type = std::size_t;
+	using growth_policy = Growth;
+	using storage_policy = Storage;
 
 	vector() = default;
 
 	vector(size_type num_of_elements, const T& value)
 	{
 		fit(num_of_elements);
-		for (size_type i = 0; i < num_of_elements; ++i)
-			emplace_back(value);
+		std::uninitialized_fill_n(m_elements, num_of_elements, value);
+		m_size = num_of_elements;
 	}
 
 	explicit vector(size_type num_of_elements)
 	{
 		fit(num_of_elements);
-		for (size_type i = 0; i < num_of_elements; ++i)
-			emplace_back(T());
+
+		if constexpr (is_zero_initialized_by_memset_v<T>)
+		{
+			if (num_of_elements)
+				std::memset(static_cast<void*>(m_elements), 0, sizeof(T) * num_of_elements);
+
+			m_size = num_of_elements;
+		}
+
+		else
+		{
+			for (size_type i = 0; i < num_of_elements; ++i)
+				emplace_back();
+		}
 	}
 
 	vector(vector&& other) noexcept :
@@ -51,14 +83,23 @@ public:
 		m_elements(allocate_new_blocks(other.m_size)), m_capacity(other.m_size),
 		m_size(other.m_size)
 	{
-		for (size_type i = 0; i < m_size; ++i)
-			new (&m_elements[i]) T(other.m_elements[i]);
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (m_size)
+				std::memcpy(static_cast<void*>(m_elements), other.m_elements, sizeof(T) * m_size);
+		}
+
+		else
+		{
+			for (size_type i = 0; i < m_size; ++i)
+				new (&m_elements[i]) T(other.m_elements[i]);
+		}
 	}
 
 	~vector()
 	{
 		destruct_elements();
-		::operator delete(m_elements);
+		deallocate_blocks(m_elements, m_capacity);
 	}
 
 	vector& operator=(vector other)
@@ -72,6 +113,9 @@ public:
 		if (m_size != other.m_size)
 			return false;
 
+		if constexpr (is_bitwise_comparable)
+			return m_size == 0 || !std::memcmp(m_elements, other.m_elements, sizeof(T) * m_size);
+
 		auto this_it = this->begin();
 		auto other_it = other.begin();
 
@@ -122,6 +166,23 @@ public:
 
 	friend void swap(vector& a, vector& b) noexcept { a.swap(b); }
 
+	// Gives the unused capacity back to the allocator.
+	void shrink_to_fit()
+	{
+		if (m_capacity == m_size)
+			return;
+
+		if (m_size == 0)
+		{
+			deallocate_blocks(m_elements, m_capacity);
+			m_elements = nullptr;
+			m_capacity = 0;
+			return;
+		}
+
+		reallocate(m_size);
+	}
+
 	void reserve(size_type new_cap)
 	{
 		if (m_capacity < new_cap)
@@ -136,21 +197,167 @@ public:
 	reference emplace_back(Args&&... args)
 	{
 		if (m_size == m_capacity)
-			reallocate(get_increased_capacity());
+			reallocate(get_increased_capacity(m_size + 1));
 
 		new (&m_elements[m_size]) T(std::forward<Args>(args)...);
 
 		return m_elements[m_size++];
 	}
 
-	void insert(iterator first, iterator last)
+	void insert(iterator first, iterator last) { append_range(first, last); }
+
+	iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+
+	iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+	iterator insert(const_iterator pos, size_type count, const T& value)
+	{
+		auto offset = static_cast<size_type>(pos - cbegin());
+
+		if (count == 0)
+			return begin() + offset;
+
+		T copy(value);
+		T* gap = open_gap(offset, count);
+		std::uninitialized_fill_n(gap, count, copy);
+		m_size += count;
+
+		return begin() + offset;
+	}
+
+	// Inserts the elements of the random access range [first, last), which
+	// must not belong to this vector.
+	template <class RandomIt, class = std::enable_if_t<!std::is_integral_v<RandomIt>>>
+	iterator insert(const_iterator pos, RandomIt first, RandomIt last)
+	{
+		auto offset = static_cast<size_type>(pos - cbegin());
+		auto count = static_cast<size_type>(last - first);
+
+		if (count == 0)
+			return begin() + offset;
+
+		copy_construct_range(open_gap(offset, count), first, count);
+		m_size += count;
+
+		return begin() + offset;
+	}
+
+	template <class... Args>
+	iterator emplace(const_iterator pos, Args&&... args)
 	{
-		size_type new_capacity = static_cast<size_type>(last - first) + m_size;
+		auto offset = static_cast<size_type>(pos - cbegin());
+
+		if (offset == m_size)
+		{
+			emplace_back(std::forward<Args>(args)...);
+			return begin() + offset;
+		}
+
+		// The arguments may refer to elements that are about to be shifted.
+		T value(std::forward<Args>(args)...);
+		new (open_gap(offset, 1)) T(std::move(value));
+		++m_size;
 
-		reserve(new_capacity);
+		return begin() + offset;
+	}
 
-		for (; first != last; first++)
-			emplace_back(*first);
+	template <class RandomIt>
+	void append_range(RandomIt first, RandomIt last)
+	{
+		insert(cend(), first, last);
+	}
+
+	template <class RandomIt>
+	void assign(RandomIt first, RandomIt last)
+	{
+		clear();
+
+		auto count = static_cast<size_type>(last - first);
+		reserve(count);
+
+		copy_construct_range(m_elements, first, count);
+		m_size = count;
+	}
+
+	void resize(size_type count)
+	{
+		if (count <= m_size)
+		{
+			shrink_size_to(count);
+			return;
+		}
+
+		grow_capacity_to(count);
+
+		if constexpr (is_zero_initialized_by_memset_v<T>)
+		{
+			std::memset(static_cast<void*>(m_elements + m_size), 0, sizeof(T) * (count - m_size));
+			m_size = count;
+		}
+
+		else
+		{
+			while (m_size < count)
+				emplace_back();
+		}
+	}
+
+	void resize(size_type count, const T& value)
+	{
+		if (count <= m_size)
+		{
+			shrink_size_to(count);
+			return;
+		}
+
+		insert(cend(), count - m_size, value);
+	}
+
+	// Grows or shrinks to count elements, new elements are default-initialized,
+	// so trivial types are left indeterminate instead of being zeroed.
+	void resize_default_init(size_type count)
+	{
+		if (count <= m_size)
+		{
+			shrink_size_to(count);
+			return;
+		}
+
+		grow_capacity_to(count);
+
+		if constexpr (!std::is_trivially_default_constructible_v<T>)
+		{
+			for (; m_size < count; ++m_size)
+				new (&m_elements[m_size]) T;
+		}
+
+		m_size = count;
+	}
+
+	// Like resize_default_init, for buffers whose new elements are about to be
+	// overwritten, e.g. by read() or recv().
+	void resize_uninitialized(size_type count)
+	{
+		static_assert(std::is_trivial_v<T>, "Only trivial elements may be left uninitialized");
+
+		resize_default_init(count);
+	}
+
+	// Makes room for count elements and calls op(data(), count), which writes
+	// the elements it wants to keep and returns how many there are, at most
+	// count. The elements past the current size are indeterminate when op is
+	// called.
+	template <class Operation>
+	void resize_and_overwrite(size_type count, Operation op)
+	{
+		static_assert(std::is_trivial_v<T>, "Only trivial elements may be left uninitialized");
+
+		grow_capacity_to(count);
+
+		size_type new_size = std::move(op)(m_elements, count);
+		assert(new_size <= count);
+
+		m_size = new_size;
 	}
 
 	void pop_back() noexcept
@@ -169,9 +376,48 @@ public:
 	{
 		auto offset = static_cast<size_t>(pos - begin());
 
-		move_items_in_block(offset, m_size - 1);
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			m_elements[offset].~T();
+			relocate_items_in_block(offset + 1, m_size, offset);
+			--m_size;
+		}
+
+		else
+		{
+			move_items_in_block(offset, m_size - 1);
+			pop_back();
+		}
+
+		return begin() + offset;
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		auto offset = static_cast<size_type>(first - cbegin());
+		auto count = static_cast<size_type>(last - first);
 
-		pop_back();
+		if (count == 0)
+			return begin() + offset;
+
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			destruct_range(offset, offset + count);
+			relocate_items_in_block(offset + count, m_size, offset);
+		}
+
+		else
+		{
+			for (size_type i = offset; i + count < m_size; ++i)
+			{
+				m_elements[i].~T();
+				new (&m_elements[i]) T(std::move(m_elements[i + count]));
+			}
+
+			destruct_range(m_size - count, m_size);
+		}
+
+		m_size -= count;
 
 		return begin() + offset;
 	}
@@ -198,14 +444,37 @@ public:
 	[[nodiscard]] size_type capacity() const noexcept { return m_capacity; }
 	[[nodiscard]] size_type empty() const noexcept { return m_size == 0; }
 
+	[[nodiscard]] constexpr static size_type max_size() noexcept
+	{
+		return static_cast<size_type>(std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(T);
+	}
+
 private:
+	// Trivially relocatable elements are moved by the storage policy, which
+	// can grow the block in place with realloc or remap its pages.
 	void reallocate(size_type new_cap)
 	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			void* resized_block =
+				Storage::reallocate(static_cast<void*>(m_elements), sizeof(T) * m_capacity,
+									sizeof(T) * new_cap, block_alignment);
+
+			if (resized_block)
+			{
+				m_elements = static_cast<T*>(resized_block);
+				m_capacity = new_cap;
+				return;
+			}
+		}
+
 		T* new_block = allocate_new_blocks(new_cap);
 		transfer_items_to_new_block(new_block);
 
-		destruct_elements();
-		::operator delete(m_elements);
+		if constexpr (!is_trivially_relocatable_v<T>)
+			destruct_elements();
+
+		deallocate_blocks(m_elements, m_capacity);
 
 		m_elements = new_block;
 		m_capacity = new_cap;
@@ -219,7 +488,14 @@ private:
 
 	void transfer_items_to_new_block(T* new_block)
 	{
-		if constexpr (std::is_nothrow_move_constructible_v<T>)
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (m_size)
+				std::memcpy(static_cast<void*>(new_block), static_cast<void*>(m_elements),
+							sizeof(T) * m_size);
+		}
+
+		else if constexpr (std::is_nothrow_move_constructible_v<T>)
 		{
 			for (size_type i = 0; i < m_size; ++i)
 				new (&new_block[i]) T(std::move(m_elements[i]));
@@ -232,6 +508,114 @@ private:
 		}
 	}
 
+	// Makes room for count elements at offset, shifting the tail once and
+	// allocating at most once. Returns the uninitialized gap, m_size is left
+	// for the caller to update.
+	T* open_gap(size_type offset, size_type count)
+	{
+		if (m_size + count <= m_capacity)
+		{
+			if constexpr (is_trivially_relocatable_v<T>)
+				relocate_items_in_block(offset, m_size, offset + count);
+
+			else
+			{
+				for (size_type i = m_size; i > offset; --i)
+				{
+					new (&m_elements[i - 1 + count]) T(std::move_if_noexcept(m_elements[i - 1]));
+					m_elements[i - 1].~T();
+				}
+			}
+
+			return m_elements + offset;
+		}
+
+		size_type new_cap = get_increased_capacity(m_size + count);
+
+		T* new_block = allocate_new_blocks(new_cap);
+
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (offset)
+				std::memcpy(static_cast<void*>(new_block), static_cast<void*>(m_elements),
+							sizeof(T) * offset);
+
+			if (offset < m_size)
+				std::memcpy(static_cast<void*>(new_block + offset + count),
+							static_cast<void*>(m_elements + offset), sizeof(T) * (m_size - offset));
+		}
+
+		else
+		{
+			for (size_type i = 0; i < m_size; ++i)
+			{
+				size_type target = i < offset ? i : i + count;
+				new (&new_block[target]) T(std::move_if_noexcept(m_elements[i]));
+			}
+
+			destruct_elements();
+		}
+
+		deallocate_blocks(m_elements, m_capacity);
+
+		m_elements = new_block;
+		m_capacity = new_cap;
+
+		return m_elements + offset;
+	}
+
+	template <class RandomIt>
+	static void copy_construct_range(T* destination, RandomIt first, size_type count)
+	{
+		constexpr bool is_contiguous =
+			std::is_same_v<RandomIt, iterator> || std::is_same_v<RandomIt, const_iterator> ||
+			std::is_same_v<RandomIt, T*> || std::is_same_v<RandomIt, const T*>;
+
+		if constexpr (is_contiguous && std::is_trivially_copyable_v<T>)
+		{
+			if (count)
+				std::memcpy(static_cast<void*>(destination), &*first, sizeof(T) * count);
+		}
+
+		else
+		{
+			for (size_type i = 0; i < count; ++i, ++first)
+				new (&destination[i]) T(*first);
+		}
+	}
+
+	void grow_capacity_to(size_type min_cap)
+	{
+		if (min_cap <= m_capacity)
+			return;
+
+		reallocate(get_increased_capacity(min_cap));
+	}
+
+	void shrink_size_to(size_type count) noexcept
+	{
+		destruct_range(count, m_size);
+		m_size = count;
+	}
+
+	void destruct_range(size_type first, size_type last) noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			for (size_type i = first; i < last; ++i)
+				m_elements[i].~T();
+		}
+	}
+
+	// Moves the relocatable elements in [first, last) to start at dest, the
+	// source slots are left without live objects.
+	void relocate_items_in_block(size_type first, size_type last, size_type dest)
+	{
+		if (first < last)
+			std::memmove(static_cast<void*>(m_elements + dest),
+						 static_cast<void*>(m_elements + first), sizeof(T) * (last - first));
+	}
+
 	void move_items_in_block(size_type start, size_type end)
 	{
 		if constexpr (std::is_nothrow_move_constructible_v<T>)
@@ -262,14 +646,19 @@ private:
 		}
 	}
 
-	[[nodiscard]] size_type get_increased_capacity() const
+	[[nodiscard]] size_type get_increased_capacity(size_type required) const noexcept
+	{
+		return Growth::next_capacity(m_capacity, required, sizeof(T));
+	}
+
+	[[nodiscard]] static T* allocate_new_blocks(size_type size)
 	{
-		return m_capacity * CAPACITY_INCREASE_FACTOR + 1;
+		return static_cast<T*>(Storage::allocate(sizeof(T) * size, block_alignment));
 	}
 
-	[[nodiscard]] T* allocate_new_blocks(size_type size) const
+	static void deallocate_blocks(T* block, size_type capacity) noexcept
 	{
-		return static_cast<T*>(::operator new(sizeof(T) * size));
+		Storage::deallocate(static_cast<void*>(block), sizeof(T) * capacity, block_alignment);
 	}
 
 	T* m_elements = nullptr;
@@ -277,6 +666,15 @@ private:
 	size_type m_size = 0;
 };
 
+template <class T, class Growth, class Storage>
+struct is_trivially_relocatable<vector<T, Growth, Storage>> : std::true_type
+{
+};
+
+// Vector whose data() is aligned to Alignment bytes, e.g. 64 for SIMD loads.
+template <class T, size_type Alignment>
+using aligned_vector = vector<T, default_growth, heap_storage<Alignment>>;
+
 } // namespace simple
 
 #endif // VECTOR_H
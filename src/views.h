@@ -0,0 +1,790 @@
+#ifndef VIEWS_H
+#define VIEWS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "pair.h"
+#include "vector.h"
+
+// Lazy views over simple containers, composed with |:
+//
+//   auto names = people | views::filter(is_adult) | views::transform(name_of)
+//			   | simple::to<simple::vector>();
+//
+// A view holds its source and the functions, not elements. Iterating the
+// final view pulls every element through the whole pipeline in one pass,
+// nothing in between is materialized. Views over lvalue containers refer to
+// them, temporaries are moved into the view. Iterators point into their view,
+// so a view must outlive its iterators and not be moved while iterating.
+
+namespace simple
+{
+
+namespace detail
+{
+
+template <class R>
+using range_iterator_t = decltype(std::declval<const R&>().begin());
+
+template <class R>
+using range_reference_t = decltype(*std::declval<range_iterator_t<R>&>());
+
+template <class R>
+using range_value_t = std::remove_cv_t<std::remove_reference_t<range_reference_t<R>>>;
+
+template <class R, class = void>
+struct has_size : std::false_type
+{
+};
+
+template <class R>
+struct has_size<R, std::void_t<decltype(std::declval<const R&>().size())>> : std::true_type
+{
+};
+
+template <class R>
+constexpr bool has_size_v = has_size<R>::value;
+
+template <class C, class = void>
+struct has_reserve : std::false_type
+{
+};
+
+template <class C>
+struct has_reserve<C, std::void_t<decltype(std::declval<C&>().reserve(size_type()))>>
+	: std::true_type
+{
+};
+
+template <class It, class = void>
+struct is_random_access : std::false_type
+{
+};
+
+template <class It>
+struct is_random_access<It, std::void_t<decltype(std::declval<It&>() - std::declval<It&>()),
+										decltype(std::declval<It&>() += std::ptrdiff_t())>>
+	: std::true_type
+{
+};
+
+// Advances it by up to count elements without passing last.
+template <class It>
+It advance_bounded(It it, const It& last, size_type count)
+{
+	if constexpr (is_random_access<It>::value)
+	{
+		auto remaining = static_cast<size_type>(last - it);
+		it += static_cast<std::ptrdiff_t>(std::min(count, remaining));
+	}
+
+	else
+	{
+		for (; count && it != last; --count)
+			++it;
+	}
+
+	return it;
+}
+
+} // namespace detail
+
+// A begin and end pair as a range, the elements of chunk.
+template <class It>
+class subrange
+{
+public:
+	subrange() = default;
+	subrange(It first, It last) : m_first(first), m_last(last) {}
+
+	[[nodiscard]] It begin() const { return m_first; }
+	[[nodiscard]] It end() const { return m_last; }
+	[[nodiscard]] bool empty() const { return !(m_first != m_last); }
+
+private:
+	It m_first;
+	It m_last;
+};
+
+// Refers to an lvalue range.
+template <class R>
+class ref_view
+{
+public:
+	explicit ref_view(R& range) noexcept : m_range(&range) {}
+
+	[[nodiscard]] auto begin() const { return m_range->begin(); }
+	[[nodiscard]] auto end() const { return m_range->end(); }
+
+	template <class Base = R, class = std::enable_if_t<detail::has_size_v<Base>>>
+	[[nodiscard]] size_type size() const
+	{
+		return m_range->size();
+	}
+
+private:
+	R* m_range;
+};
+
+namespace views
+{
+
+// Views refer to lvalue ranges and take ownership of rvalue ones.
+template <class R>
+auto all(R&& range)
+{
+	if constexpr (std::is_lvalue_reference_v<R>)
+		return ref_view<std::remove_reference_t<R>>(range);
+
+	else
+		return std::decay_t<R>(std::move(range));
+}
+
+template <class R>
+using all_t = decltype(views::all(std::declval<R>()));
+
+} // namespace views
+
+template <class V, class F>
+class transform_view
+{
+public:
+	class iterator
+	{
+		using base_iterator = detail::range_iterator_t<V>;
+
+	public:
+		using reference = decltype(std::declval<const F&>()(*std::declval<base_iterator&>()));
+		using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::input_iterator_tag;
+
+		iterator() = default;
+		iterator(base_iterator current, const F* func) : m_current(current), m_func(func) {}
+
+		reference operator*() { return (*m_func)(*m_current); }
+
+		iterator& operator++()
+		{
+			++m_current;
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator it(*this);
+			++m_current;
+			return it;
+		}
+
+		friend bool operator==(const iterator& lhs, const iterator& rhs)
+		{
+			return lhs.m_current == rhs.m_current;
+		}
+
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) { return !(lhs == rhs); }
+
+	private:
+		base_iterator m_current;
+		const F* m_func = nullptr;
+	};
+
+	transform_view(V base, F func) : m_base(std::move(base)), m_func(std::move(func)) {}
+
+	[[nodiscard]] iterator begin() const { return iterator(m_base.begin(), &m_func); }
+	[[nodiscard]] iterator end() const { return iterator(m_base.end(), &m_func); }
+
+	template <class Base = V, class = std::enable_if_t<detail::has_size_v<Base>>>
+	[[nodiscard]] size_type size() const
+	{
+		return m_base.size();
+	}
+
+private:
+	V m_base;
+	F m_func;
+};
+
+// Skips the elements for which the predicate is false. Unlike std::views,
+// begin() is not cached, every call searches for the first match.
+template <class V, class P>
+class filter_view
+{
+public:
+	class iterator
+	{
+		using base_iterator = detail::range_iterator_t<V>;
+
+	public:
+		using reference = detail::range_reference_t<V>;
+		using value_type = detail::range_value_t<V>;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::input_iterator_tag;
+
+		iterator() = default;
+
+		iterator(base_iterator current, base_iterator last, const P* pred) :
+			m_current(current), m_last(last), m_pred(pred)
+		{
+			skip_rejected();
+		}
+
+		reference operator*() { return *m_current; }
+
+		iterator& operator++()
+		{
+			++m_current;
+			skip_rejected();
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator it(*this);
+			++*this;
+			return it;
+		}
+
+		friend bool operator==(const iterator& lhs, const iterator& rhs)
+		{
+			return lhs.m_current == rhs.m_current;
+		}
+
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) { return !(lhs == rhs); }
+
+	private:
+		void skip_rejected()
+		{
+			while (m_current != m_last && !(*m_pred)(*m_current))
+				++m_current;
+		}
+
+		base_iterator m_current;
+		base_iterator m_last;
+		const P* m_pred = nullptr;
+	};
+
+	filter_view(V base, P pred) : m_base(std::move(base)), m_pred(std::move(pred)) {}
+
+	[[nodiscard]] iterator begin() const { return iterator(m_base.begin(), m_base.end(), &m_pred); }
+	[[nodiscard]] iterator end() const { return iterator(m_base.end(), m_base.end(), &m_pred); }
+
+private:
+	V m_base;
+	P m_pred;
+};
+
+// The first count elements, or fewer if the range is shorter.
+template <class V>
+class take_view
+{
+public:
+	class iterator
+	{
+		using base_iterator = detail::range_iterator_t<V>;
+
+	public:
+		using reference = detail::range_reference_t<V>;
+		using value_type = detail::range_value_t<V>;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::input_iterator_tag;
+
+		iterator() = default;
+
+		iterator(base_iterator current, base_iterator last, size_type remaining) :
+			m_current(current), m_last(last), m_remaining(remaining)
+		{
+		}
+
+		reference operator*() { return *m_current; }
+
+		// The last step does not advance the base, a filter below would
+		// otherwise search past the elements that are taken.
+		iterator& operator++()
+		{
+			if (--m_remaining)
+				++m_current;
+
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator it(*this);
+			++*this;
+			return it;
+		}
+
+		// Every iterator that ran out of elements or of count is the end.
+		friend bool operator==(const iterator& lhs, const iterator& rhs)
+		{
+			bool lhs_done = lhs.is_done();
+			bool rhs_done = rhs.is_done();
+
+			if (lhs_done || rhs_done)
+				return lhs_done == rhs_done;
+
+			return lhs.m_current == rhs.m_current;
+		}
+
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) { return !(lhs == rhs); }
+
+	private:
+		[[nodiscard]] bool is_done() const { return m_remaining == 0 || !(m_current != m_last); }
+
+		base_iterator m_current;
+		base_iterator m_last;
+		size_type m_remaining = 0;
+	};
+
+	take_view(V base, size_type count) : m_base(std::move(base)), m_count(count) {}
+
+	[[nodiscard]] iterator begin() const { return iterator(m_base.begin(), m_base.end(), m_count); }
+	[[nodiscard]] iterator end() const { return iterator(m_base.end(), m_base.end(), 0); }
+
+	template <class Base = V, class = std::enable_if_t<detail::has_size_v<Base>>>
+	[[nodiscard]] size_type size() const
+	{
+		return std::min(m_count, static_cast<size_type>(m_base.size()));
+	}
+
+private:
+	V m_base;
+	size_type m_count;
+};
+
+// All but the first count elements.
+template <class V>
+class drop_view
+{
+public:
+	drop_view(V base, size_type count) : m_base(std::move(base)), m_count(count) {}
+
+	[[nodiscard]] auto begin() const
+	{
+		return detail::advance_bounded(m_base.begin(), m_base.end(), m_count);
+	}
+
+	[[nodiscard]] auto end() const { return m_base.end(); }
+
+	template <class Base = V, class = std::enable_if_t<detail::has_size_v<Base>>>
+	[[nodiscard]] size_type size() const
+	{
+		auto size = static_cast<size_type>(m_base.size());
+		return size > m_count ? size - m_count : 0;
+	}
+
+private:
+	V m_base;
+	size_type m_count;
+};
+
+// Pairs every element with its index, for (auto [index, value] : ...).
+template <class V>
+class enumerate_view
+{
+public:
+	class iterator
+	{
+		using base_iterator = detail::range_iterator_t<V>;
+
+	public:
+		using reference = pair<size_type, detail::range_reference_t<V>>;
+		using value_type = reference;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::input_iterator_tag;
+
+		iterator() = default;
+		iterator(base_iterator current, size_type index) : m_current(current), m_index(index) {}
+
+		reference operator*() { return reference(m_index, *m_current); }
+
+		iterator& operator++()
+		{
+			++m_current;
+			++m_index;
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator it(*this);
+			++*this;
+			return it;
+		}
+
+		friend bool operator==(const iterator& lhs, const iterator& rhs)
+		{
+			return lhs.m_current == rhs.m_current;
+		}
+
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) { return !(lhs == rhs); }
+
+	private:
+		base_iterator m_current;
+		size_type m_index = 0;
+	};
+
+	explicit enumerate_view(V base) : m_base(std::move(base)) {}
+
+	[[nodiscard]] iterator begin() const { return iterator(m_base.begin(), 0); }
+	[[nodiscard]] iterator end() const { return iterator(m_base.end(), 0); }
+
+	template <class Base = V, class = std::enable_if_t<detail::has_size_v<Base>>>
+	[[nodiscard]] size_type size() const
+	{
+		return m_base.size();
+	}
+
+private:
+	V m_base;
+};
+
+// Pairs up the elements of two ranges, ends with the shorter one.
+template <class V1, class V2>
+class zip_view
+{
+public:
+	class iterator
+	{
+		using first_iterator = detail::range_iterator_t<V1>;
+		using second_iterator = detail::range_iterator_t<V2>;
+
+	public:
+		using reference = pair<detail::range_reference_t<V1>, detail::range_reference_t<V2>>;
+		using value_type = reference;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::input_iterator_tag;
+
+		iterator() = default;
+		iterator(first_iterator first, second_iterator second) : m_first(first), m_second(second)
+		{
+		}
+
+		reference operator*() { return reference(*m_first, *m_second); }
+
+		iterator& operator++()
+		{
+			++m_first;
+			++m_second;
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator it(*this);
+			++*this;
+			return it;
+		}
+
+		// Equal as soon as either side is, so that the end of the shorter
+		// range ends the zip.
+		friend bool operator==(const iterator& lhs, const iterator& rhs)
+		{
+			return lhs.m_first == rhs.m_first || lhs.m_second == rhs.m_second;
+		}
+
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) { return !(lhs == rhs); }
+
+	private:
+		first_iterator m_first;
+		second_iterator m_second;
+	};
+
+	zip_view(V1 first, V2 second) : m_first(std::move(first)), m_second(std::move(second)) {}
+
+	[[nodiscard]] iterator begin() const { return iterator(m_first.begin(), m_second.begin()); }
+	[[nodiscard]] iterator end() const { return iterator(m_first.end(), m_second.end()); }
+
+	template <class Base1 = V1, class Base2 = V2,
+			  class = std::enable_if_t<detail::has_size_v<Base1> && detail::has_size_v<Base2>>>
+	[[nodiscard]] size_type size() const
+	{
+		return std::min(static_cast<size_type>(m_first.size()),
+						static_cast<size_type>(m_second.size()));
+	}
+
+private:
+	V1 m_first;
+	V2 m_second;
+};
+
+// Consecutive subranges of count elements, the last one may be shorter.
+template <class V>
+class chunk_view
+{
+public:
+	class iterator
+	{
+		using base_iterator = detail::range_iterator_t<V>;
+
+	public:
+		using reference = subrange<base_iterator>;
+		using value_type = reference;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::input_iterator_tag;
+
+		iterator() = default;
+
+		iterator(base_iterator current, base_iterator last, size_type count) :
+			m_current(current), m_next(detail::advance_bounded(current, last, count)),
+			m_last(last), m_count(count)
+		{
+		}
+
+		reference operator*() { return reference(m_current, m_next); }
+
+		iterator& operator++()
+		{
+			m_current = m_next;
+			m_next = detail::advance_bounded(m_current, m_last, m_count);
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator it(*this);
+			++*this;
+			return it;
+		}
+
+		friend bool operator==(const iterator& lhs, const iterator& rhs)
+		{
+			return lhs.m_current == rhs.m_current;
+		}
+
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) { return !(lhs == rhs); }
+
+	private:
+		base_iterator m_current;
+		base_iterator m_next;
+		base_iterator m_last;
+		size_type m_count = 0;
+	};
+
+	chunk_view(V base, size_type count) : m_base(std::move(base)), m_count(count ? count : 1) {}
+
+	[[nodiscard]] iterator begin() const { return iterator(m_base.begin(), m_base.end(), m_count); }
+	[[nodiscard]] iterator end() const { return iterator(m_base.end(), m_base.end(), m_count); }
+
+	template <class Base = V, class = std::enable_if_t<detail::has_size_v<Base>>>
+	[[nodiscard]] size_type size() const
+	{
+		return (static_cast<size_type>(m_base.size()) + m_count - 1) / m_count;
+	}
+
+private:
+	V m_base;
+	size_type m_count;
+};
+
+namespace views
+{
+
+// A function from a range to a view that can be applied with |, and
+// composed with | into a new adaptor before it is given a range.
+template <class F>
+class adaptor;
+
+template <class T>
+struct is_adaptor : std::false_type
+{
+};
+
+template <class F>
+struct is_adaptor<adaptor<F>> : std::true_type
+{
+};
+
+template <class F>
+class adaptor
+{
+public:
+	constexpr explicit adaptor(F func) : m_func(std::move(func)) {}
+
+	template <class R>
+	auto operator()(R&& range) const
+	{
+		return m_func(std::forward<R>(range));
+	}
+
+	template <class R, class = std::enable_if_t<!is_adaptor<std::decay_t<R>>::value>>
+	friend auto operator|(R&& range, const adaptor& self)
+	{
+		return self(std::forward<R>(range));
+	}
+
+	template <class G>
+	friend auto operator|(const adaptor& first, const adaptor<G>& second)
+	{
+		return views::adaptor([first, second](auto&& range) {
+			return second(first(std::forward<decltype(range)>(range)));
+		});
+	}
+
+private:
+	F m_func;
+};
+
+// Projects pair-like elements, e.g. of an unordered_map, on their first or
+// second member. Elements that are lvalues give references to the member;
+// temporaries, like zip and enumerate produce, give the member by value
+// unless it is a reference itself.
+template <bool First>
+struct pair_member
+{
+	template <class P>
+	decltype(auto) operator()(P&& element) const
+	{
+		using pair_type = std::decay_t<P>;
+		using member_type =
+			std::conditional_t<First, decltype(pair_type::first), decltype(pair_type::second)>;
+
+		if constexpr (std::is_lvalue_reference_v<P>)
+		{
+			if constexpr (First)
+				return (element.first);
+
+			else
+				return (element.second);
+		}
+
+		else if constexpr (First)
+			return static_cast<member_type>(std::forward<P>(element).first);
+
+		else
+			return static_cast<member_type>(std::forward<P>(element).second);
+	}
+};
+
+template <class F>
+auto transform(F func)
+{
+	return adaptor([func](auto&& range) {
+		using range_type = decltype(range);
+		return transform_view<all_t<range_type>, F>(views::all(std::forward<range_type>(range)),
+													func);
+	});
+}
+
+template <class P>
+auto filter(P pred)
+{
+	return adaptor([pred](auto&& range) {
+		using range_type = decltype(range);
+		return filter_view<all_t<range_type>, P>(views::all(std::forward<range_type>(range)), pred);
+	});
+}
+
+inline auto take(size_type count)
+{
+	return adaptor([count](auto&& range) {
+		using range_type = decltype(range);
+		return take_view<all_t<range_type>>(views::all(std::forward<range_type>(range)), count);
+	});
+}
+
+inline auto drop(size_type count)
+{
+	return adaptor([count](auto&& range) {
+		using range_type = decltype(range);
+		return drop_view<all_t<range_type>>(views::all(std::forward<range_type>(range)), count);
+	});
+}
+
+inline auto chunk(size_type count)
+{
+	return adaptor([count](auto&& range) {
+		using range_type = decltype(range);
+		return chunk_view<all_t<range_type>>(views::all(std::forward<range_type>(range)), count);
+	});
+}
+
+struct enumerate_function
+{
+	template <class R>
+	auto operator()(R&& range) const
+	{
+		return enumerate_view<all_t<R>>(views::all(std::forward<R>(range)));
+	}
+};
+
+template <bool First>
+struct pair_member_function
+{
+	template <class R>
+	auto operator()(R&& range) const
+	{
+		return transform_view<all_t<R>, pair_member<First>>(views::all(std::forward<R>(range)),
+															pair_member<First>());
+	}
+};
+
+inline const adaptor<enumerate_function> enumerate {enumerate_function()};
+inline const adaptor<pair_member_function<true>> keys {pair_member_function<true>()};
+inline const adaptor<pair_member_function<false>> values {pair_member_function<false>()};
+
+template <class R1, class R2>
+auto zip(R1&& first, R2&& second)
+{
+	return zip_view<all_t<R1>, all_t<R2>>(views::all(std::forward<R1>(first)),
+										  views::all(std::forward<R2>(second)));
+}
+
+} // namespace views
+
+// Copies the elements of a range into a new Container, reserving first when
+// both the range knows its size and the container can reserve.
+template <class Container, class R>
+Container to(R&& range)
+{
+	Container result;
+
+	if constexpr (detail::has_size_v<std::remove_reference_t<R>> &&
+				  detail::has_reserve<Container>::value)
+		result.reserve(static_cast<size_type>(range.size()));
+
+	for (auto it = range.begin(), last = range.end(); it != last; ++it)
+		result.push_back(*it);
+
+	return result;
+}
+
+// Container is a template like simple::vector, instantiated with the
+// range's value type.
+template <template <class...> class Container, class R>
+auto to(R&& range)
+{
+	return simple::to<Container<detail::range_value_t<std::remove_reference_t<R>>>>(
+		std::forward<R>(range));
+}
+
+template <class Container>
+auto to()
+{
+	return views::adaptor([](auto&& range) {
+		return simple::to<Container>(std::forward<decltype(range)>(range));
+	});
+}
+
+template <template <class...> class Container>
+auto to()
+{
+	return views::adaptor([](auto&& range) {
+		return simple::to<Container>(std::forward<decltype(range)>(range));
+	});
+}
+
+} // namespace simple
+
+#endif // VIEWS_H
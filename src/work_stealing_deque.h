@@ -0,0 +1,176 @@
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace simple
+{
+
+using size_type = std::size_t;
+
+// Chase-Lev deque, with the memory orderings of Le et al., "Correct and
+// Efficient Work-Stealing for Weak Memory Models". One owner thread pushes
+// and pops at the bottom, any number of thieves steal from the top. The ring
+// buffer grows when full; replaced rings stay allocated until the deque is
+// destroyed, since a thief may still be reading from one. The elements are
+// copied through atomics, so T must be trivially copyable, usually a
+// pointer.
+template <class T>
+class work_stealing_deque
+{
+	static_assert(std::is_trivially_copyable_v<T>, "Stolen elements are copied bitwise");
+
+	struct ring
+	{
+		ring(size_type t_capacity, ring* t_previous) :
+			capacity(t_capacity), items(new std::atomic<T>[t_capacity]), previous(t_previous)
+		{
+		}
+
+		~ring() { delete[] items; }
+
+		ring(const ring& other) = delete;
+		ring& operator=(const ring& other) = delete;
+
+		[[nodiscard]] T get(std::int64_t index) const noexcept
+		{
+			return items[static_cast<size_type>(index) & (capacity - 1)].load(
+				std::memory_order_relaxed);
+		}
+
+		void put(std::int64_t index, T item) noexcept
+		{
+			items[static_cast<size_type>(index) & (capacity - 1)].store(item,
+																		std::memory_order_relaxed);
+		}
+
+		size_type capacity;
+		std::atomic<T>* items;
+		ring* previous;
+	};
+
+public:
+	using value_type = T;
+
+	constexpr static size_type INITIAL_CAPACITY = 64;
+
+	work_stealing_deque() : m_ring(new ring(INITIAL_CAPACITY, nullptr)) {}
+
+	~work_stealing_deque()
+	{
+		ring* current = m_ring.load(std::memory_order_relaxed);
+
+		while (current)
+			delete std::exchange(current, current->previous);
+	}
+
+	work_stealing_deque(const work_stealing_deque& other) = delete;
+	work_stealing_deque& operator=(const work_stealing_deque& other) = delete;
+
+	// Owner only.
+	void push(T item)
+	{
+		std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		std::int64_t top = m_top.load(std::memory_order_acquire);
+		ring* current = m_ring.load(std::memory_order_relaxed);
+
+		if (bottom - top > static_cast<std::int64_t>(current->capacity) - 1)
+			current = grow(current, top, bottom);
+
+		current->put(bottom, item);
+
+		// A release store rather than a release fence and a relaxed store:
+		// the same instructions, but ThreadSanitizer does not model fences.
+		m_bottom.store(bottom + 1, std::memory_order_release);
+	}
+
+	// Owner only. Takes the most recently pushed element, returns false if
+	// the deque is empty.
+	bool pop(T& item) noexcept
+	{
+		std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		ring* current = m_ring.load(std::memory_order_relaxed);
+
+		// Every store to m_bottom releases, so that a thief which reads any of
+		// them also sees the elements pushed before it.
+		m_bottom.store(bottom, std::memory_order_release);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		std::int64_t top = m_top.load(std::memory_order_relaxed);
+
+		if (top > bottom)
+		{
+			m_bottom.store(bottom + 1, std::memory_order_release);
+			return false;
+		}
+
+		item = current->get(bottom);
+
+		if (top == bottom)
+		{
+			// Last element, race the thieves for it.
+			bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+													 std::memory_order_relaxed);
+
+			m_bottom.store(bottom + 1, std::memory_order_release);
+			return won;
+		}
+
+		return true;
+	}
+
+	// Any thread. Takes the least recently pushed element, returns false if
+	// the deque is empty or another thread took the element first.
+	bool steal(T& item) noexcept
+	{
+		std::int64_t top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return false;
+
+		item = m_ring.load(std::memory_order_acquire)->get(top);
+
+		return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+											 std::memory_order_relaxed);
+	}
+
+	// Only a snapshot when other threads steal concurrently.
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] size_type capacity() const noexcept
+	{
+		return m_ring.load(std::memory_order_relaxed)->capacity;
+	}
+
+private:
+	ring* grow(ring* current, std::int64_t top, std::int64_t bottom)
+	{
+		auto* bigger = new ring(current->capacity * 2, current);
+
+		for (std::int64_t i = top; i < bottom; ++i)
+			bigger->put(i, current->get(i));
+
+		m_ring.store(bigger, std::memory_order_release);
+
+		return bigger;
+	}
+
+	constexpr static std::size_t CACHE_LINE_SIZE = 64;
+
+	alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> m_top {0};
+	alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> m_bottom {0};
+	alignas(CACHE_LINE_SIZE) std::atomic<ring*> m_ring;
+};
+
+} // namespace simple
+
+#endif // WORK_STEALING_DEQUE_H
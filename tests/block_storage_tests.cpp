@@ -0,0 +1,116 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/block_storage.h"
+#include "../src/vector.h"
+
+#include <cstdint>
+
+using simple::aligned_vector;
+using simple::default_growth;
+using simple::heap_storage;
+using simple::huge_page_storage;
+using simple::vector;
+
+namespace
+{
+
+bool is_aligned(const void* ptr, std::size_t alignment)
+{
+	return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+} // namespace
+
+TEST_CASE("Aligned vector storage", "[aligned_vector]")
+{
+	aligned_vector<float, 64> floats;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		floats.push_back(static_cast<float>(i));
+		REQUIRE(is_aligned(floats.data(), 64));
+	}
+
+	REQUIRE(floats[999] == 999.0f);
+
+	floats.shrink_to_fit();
+	REQUIRE(is_aligned(floats.data(), 64));
+
+	aligned_vector<float, 64> copy = floats;
+	REQUIRE(is_aligned(copy.data(), 64));
+	REQUIRE(copy == floats);
+
+	aligned_vector<char, 4096> page(10, 'x');
+	REQUIRE(is_aligned(page.data(), 4096));
+	REQUIRE(page[9] == 'x');
+}
+
+TEST_CASE("Heap storage falls back from realloc for over-aligned blocks",
+		  "[heap_storage_fallback]")
+{
+	void* block = heap_storage<64>::allocate(128, 64);
+	REQUIRE(is_aligned(block, 64));
+	REQUIRE(heap_storage<64>::reallocate(block, 128, 256, 64) == nullptr);
+	heap_storage<64>::deallocate(block, 128, 64);
+
+	block = heap_storage<>::allocate(128, alignof(int));
+	block = heap_storage<>::reallocate(block, 128, 256, alignof(int));
+	REQUIRE(block != nullptr);
+	heap_storage<>::deallocate(block, 256, alignof(int));
+}
+
+TEST_CASE("Huge page storage threshold", "[huge_page_storage_threshold]")
+{
+	using storage = huge_page_storage<64, 1 << 20>;
+
+	REQUIRE_FALSE(storage::is_mapped(1000));
+
+	void* small = storage::allocate(1000, 64);
+	REQUIRE(is_aligned(small, 64));
+	storage::deallocate(small, 1000, 64);
+
+#if defined(__linux__)
+	REQUIRE(storage::is_mapped(1 << 20));
+
+	// Whether or not explicit huge pages are reserved, a mapped block starts
+	// on a huge page boundary.
+	void* large = storage::allocate(3 << 20, 64);
+	REQUIRE(is_aligned(large, storage::HUGE_PAGE_SIZE));
+	static_cast<char*>(large)[(3 << 20) - 1] = 1;
+
+	// Crossing the threshold cannot be done in place.
+	REQUIRE(storage::reallocate(small, 1000, 4 << 20, 64) == nullptr);
+
+	large = storage::reallocate(large, 3 << 20, 8 << 20, 64);
+	REQUIRE(large != nullptr);
+	REQUIRE(static_cast<char*>(large)[(3 << 20) - 1] == 1);
+
+	storage::deallocate(large, 8 << 20, 64);
+#endif
+}
+
+TEST_CASE("Vector backed by huge pages", "[huge_page_vector]")
+{
+	vector<int, default_growth, huge_page_storage<64, 1 << 16>> vec;
+
+	for (int i = 0; i < 200000; ++i)
+		vec.push_back(i);
+
+	REQUIRE(is_aligned(vec.data(), 64));
+
+	for (int i = 0; i < 200000; i += 1000)
+		REQUIRE(vec[static_cast<std::size_t>(i)] == i);
+
+	vec.erase(vec.begin(), vec.begin() + 100000);
+	vec.shrink_to_fit();
+	REQUIRE(vec.size() == 100000);
+	REQUIRE(vec.front() == 100000);
+
+	vec.resize(10);
+	vec.shrink_to_fit();
+	REQUIRE(vec.capacity() == 10);
+	REQUIRE(vec.back() == 100009);
+
+	vector<vector<int, default_growth, huge_page_storage<>>> nested(3);
+	nested[1].resize(1 << 20, 7);
+	REQUIRE(nested[1][12345] == 7);
+}
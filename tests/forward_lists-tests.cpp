@@ -1,9 +1,26 @@
 #include "../lib/include/catch2/catch.hpp"
 
+#include "../src/array.h"
 #include "../src/forward_list.h"
 
 using simple::forward_list;
 
+template <class T, class... Params>
+void check_forward_list(const forward_list<T>& t_list, Params... t_params)
+{
+	simple::array<T, sizeof...(t_params)> params = {t_params...};
+
+	REQUIRE(t_list.size() == params.size());
+
+	auto list_it = t_list.begin();
+	auto param_it = params.begin();
+
+	for (; list_it != t_list.end(); ++list_it, ++param_it)
+		REQUIRE(*list_it == *param_it);
+
+	REQUIRE(param_it == params.end());
+}
+
 TEST_CASE("Check if a new forward_list is empty.", "[empty_forward_list]")
 {
 	forward_list<int> empty_forward_list;
@@ -74,3 +91,181 @@ TEST_CASE("Test iterators to forward_list.", "[test_iterators_forward_list]")
 
 	REQUIRE(sum == 21);
 }
+
+TEST_CASE("Destroy long forward_list.", "[destroy_long_forward_list]")
+{
+	constexpr int num_of_items = 1000000;
+
+	{
+		forward_list<int> list;
+
+		for (int i = 0; i < num_of_items; ++i)
+			list.emplace_front(i);
+
+		REQUIRE(list.front() == num_of_items - 1);
+	}
+
+	forward_list<int> list;
+	forward_list<int> other_list;
+
+	for (int i = 0; i < num_of_items; ++i)
+	{
+		list.emplace_front(i);
+		other_list.emplace_front(i);
+	}
+
+	list = std::move(other_list);
+	list.clear();
+
+	REQUIRE(list.empty());
+}
+
+TEST_CASE("Pop front forward_list.", "[pop_front_forward_list]")
+{
+	forward_list<int> list;
+
+	list.push_front(1);
+	list.push_front(2);
+
+	list.pop_front();
+	check_forward_list(list, 1);
+
+	list.pop_front();
+	REQUIRE(list.empty());
+	REQUIRE(list.size() == 0);
+}
+
+TEST_CASE("Insert after forward_list.", "[insert_after_forward_list]")
+{
+	forward_list<int> list;
+
+	auto it = list.insert_after(list.before_begin(), 1);
+	it = list.insert_after(it, 3);
+	list.emplace_after(list.begin(), 2);
+	list.insert_after(list.before_begin(), 0);
+
+	REQUIRE(*it == 3);
+	check_forward_list(list, 0, 1, 2, 3);
+}
+
+TEST_CASE("Erase after forward_list.", "[erase_after_forward_list]")
+{
+	forward_list<int> list;
+
+	for (int i : {5, 4, 3, 2, 1, 0})
+		list.push_front(i);
+
+	auto it = list.erase_after(list.begin());
+	REQUIRE(*it == 2);
+	check_forward_list(list, 0, 2, 3, 4, 5);
+
+	it = list.erase_after(list.before_begin());
+	REQUIRE(*it == 2);
+	check_forward_list(list, 2, 3, 4, 5);
+
+	auto last = list.begin();
+	++++++last;
+
+	it = list.erase_after(list.begin(), last);
+	REQUIRE(*it == 5);
+	check_forward_list(list, 2, 5);
+
+	list.erase_after(list.before_begin(), list.end());
+	REQUIRE(list.empty());
+}
+
+TEST_CASE("Splice after forward_list.", "[splice_after_forward_list]")
+{
+	forward_list<int> list_1;
+	forward_list<int> list_2;
+
+	for (int i : {3, 2, 1})
+		list_1.push_front(i);
+
+	for (int i : {7, 6, 5, 4})
+		list_2.push_front(i);
+
+	list_1.splice_after(list_1.begin(), list_2, list_2.begin());
+	check_forward_list(list_1, 1, 5, 2, 3);
+	check_forward_list(list_2, 4, 6, 7);
+
+	list_1.splice_after(list_1.before_begin(), list_2, list_2.before_begin(), list_2.end());
+	check_forward_list(list_1, 4, 6, 7, 1, 5, 2, 3);
+	REQUIRE(list_2.empty());
+
+	list_2.splice_after(list_2.before_begin(), list_1);
+	check_forward_list(list_2, 4, 6, 7, 1, 5, 2, 3);
+	REQUIRE(list_1.empty());
+
+	list_2.splice_after(list_2.before_begin(), list_2, ++++list_2.begin());
+	check_forward_list(list_2, 1, 4, 6, 7, 5, 2, 3);
+}
+
+TEST_CASE("Reverse forward_list.", "[reverse_forward_list]")
+{
+	forward_list<int> list;
+
+	list.reverse();
+	REQUIRE(list.empty());
+
+	for (int i : {1, 2, 3, 4})
+		list.push_front(i);
+
+	list.reverse();
+	check_forward_list(list, 1, 2, 3, 4);
+}
+
+TEST_CASE("Merge forward_lists.", "[merge_forward_lists]")
+{
+	forward_list<int> list_1;
+	forward_list<int> list_2;
+
+	for (int i : {8, 3, 3, 1})
+		list_1.push_front(i);
+
+	for (int i : {10, 9, 3, 2, 0})
+		list_2.push_front(i);
+
+	list_1.merge(list_2);
+
+	check_forward_list(list_1, 0, 1, 2, 3, 3, 3, 8, 9, 10);
+	REQUIRE(list_2.empty());
+}
+
+TEST_CASE("Sort forward_list.", "[sort_forward_list]")
+{
+	forward_list<int> list;
+
+	for (int i : {5, 3, 9, 1, 1, 7, 0, 4, 8, 2, 6})
+		list.push_front(i);
+
+	list.sort();
+	check_forward_list(list, 0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+
+	list.sort([](int lhs, int rhs) { return lhs > rhs; });
+	check_forward_list(list, 9, 8, 7, 6, 5, 4, 3, 2, 1, 1, 0);
+
+	struct job
+	{
+		int deadline;
+		int id;
+	};
+
+	forward_list<job> jobs;
+
+	for (int i = 0; i < 1000; ++i)
+		jobs.push_front({(i * 37) % 10, i});
+
+	jobs.sort([](const job& lhs, const job& rhs) { return lhs.deadline < rhs.deadline; });
+
+	REQUIRE(jobs.size() == 1000);
+
+	auto prev = jobs.begin();
+	for (auto it = ++jobs.begin(); it != jobs.end(); ++it, ++prev)
+	{
+		REQUIRE(prev->deadline <= it->deadline);
+
+		if (prev->deadline == it->deadline)
+			REQUIRE(prev->id > it->id);
+	}
+}
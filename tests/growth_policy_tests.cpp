@@ -0,0 +1,72 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/growth_policy.h"
+#include "../src/vector.h"
+
+using simple::capped_growth;
+using simple::double_growth;
+using simple::one_and_a_half_growth;
+using simple::size_class_growth;
+using simple::vector;
+
+TEST_CASE("Geometric growth policies", "[geometric_growth]")
+{
+	REQUIRE(double_growth::next_capacity(0, 1, 4) == 1);
+	REQUIRE(double_growth::next_capacity(8, 9, 4) == 17);
+	REQUIRE(double_growth::next_capacity(8, 100, 4) == 100);
+
+	REQUIRE(one_and_a_half_growth::next_capacity(4, 5, 4) == 7);
+	REQUIRE(one_and_a_half_growth::next_capacity(5, 6, 4) == 8);
+	REQUIRE(one_and_a_half_growth::next_capacity(1000, 1001, 4) == 1501);
+}
+
+TEST_CASE("Size class growth policy", "[size_class_growth]")
+{
+	using policy = size_class_growth<>;
+
+	REQUIRE(policy::size_class(1) == 16);
+	REQUIRE(policy::size_class(100) == 112);
+	REQUIRE(policy::size_class(129) == 160);
+	REQUIRE(policy::size_class(256) == 256);
+	REQUIRE(policy::size_class(257) == 320);
+	REQUIRE(policy::size_class(5000) == 5120);
+
+	// 2 * 8 + 1 = 17 ints need 68 bytes, the 80 byte class holds 20.
+	REQUIRE(policy::next_capacity(8, 9, 4) == 20);
+	REQUIRE(policy::next_capacity(0, 1, 1) == 16);
+}
+
+TEST_CASE("Capped growth policy", "[capped_growth]")
+{
+	using policy = capped_growth<double_growth, 1024>;
+
+	REQUIRE(policy::next_capacity(10, 11, 8) == 21);
+	REQUIRE(policy::next_capacity(1000, 1001, 8) == 1128);
+	REQUIRE(policy::next_capacity(1000, 5000, 8) == 5000);
+	REQUIRE(policy::next_capacity(10, 11, 4096) == 11);
+}
+
+TEST_CASE("Vector with a growth policy", "[vector_growth_policy]")
+{
+	vector<int, one_and_a_half_growth> vec;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		simple::size_type capacity = vec.capacity();
+		vec.push_back(i);
+
+		if (vec.capacity() != capacity)
+			REQUIRE(vec.capacity() ==
+					one_and_a_half_growth::next_capacity(capacity, vec.size(), 4));
+	}
+
+	REQUIRE(vec.size() == 100);
+	REQUIRE(vec[99] == 99);
+
+	vector<int, capped_growth<double_growth, 64>> capped;
+	capped.reserve(100);
+
+	for (int i = 0; i < 101; ++i)
+		capped.push_back(i);
+
+	REQUIRE(capped.capacity() == 116);
+}
@@ -0,0 +1,214 @@
+#include "../lib/include/catch2/catch.hpp"
+
+#include "../src/array.h"
+#include "../src/intrusive_list.h"
+
+using simple::intrusive_list;
+using simple::intrusive_list_hook;
+using simple::link_mode;
+
+namespace
+{
+
+struct task
+{
+	explicit task(int t_id) : id(t_id) {}
+
+	int id;
+	intrusive_list_hook<> ready_hook;
+	intrusive_list_hook<link_mode::auto_unlink> timeout_hook;
+};
+
+// A hook in a base class, and a class that is not standard layout.
+struct job_base
+{
+	virtual ~job_base() = default;
+
+	double priority = 0;
+	intrusive_list_hook<> job_hook;
+};
+
+struct job : job_base
+{
+	explicit job(int t_id) : id(t_id) {}
+
+	int id;
+};
+
+using ready_list = intrusive_list<task, &task::ready_hook>;
+using timeout_list = intrusive_list<task, &task::timeout_hook>;
+
+template <class List, class... Params>
+void check_intrusive_list(const List& t_list, Params... t_params)
+{
+	simple::array<int, sizeof...(t_params)> params = {t_params...};
+
+	REQUIRE(t_list.size() == params.size());
+
+	auto list_it = t_list.begin();
+	auto param_it = params.begin();
+
+	for (; list_it != t_list.end(); ++list_it, ++param_it)
+		REQUIRE(list_it->id == *param_it);
+
+	list_it = t_list.end();
+	param_it = params.end();
+
+	while (list_it != t_list.begin())
+		REQUIRE((--list_it)->id == *(--param_it));
+}
+
+} // namespace
+
+TEST_CASE("Check if a new intrusive list is empty.", "[empty_intrusive_list]")
+{
+	ready_list my_list;
+
+	REQUIRE(my_list.empty());
+	REQUIRE(my_list.size() == 0);
+	REQUIRE(my_list.begin() == my_list.end());
+}
+
+TEST_CASE("Push and pop intrusive list.", "[push_pop_intrusive_list]")
+{
+	task task_1(1);
+	task task_2(2);
+	task task_3(3);
+
+	ready_list my_list;
+
+	my_list.push_back(task_2);
+	my_list.push_front(task_1);
+	my_list.push_back(task_3);
+
+	REQUIRE(&my_list.front() == &task_1);
+	REQUIRE(&my_list.back() == &task_3);
+
+	check_intrusive_list(my_list, 1, 2, 3);
+
+	my_list.pop_front();
+	check_intrusive_list(my_list, 2, 3);
+	REQUIRE_FALSE(task_1.ready_hook.is_linked());
+
+	my_list.pop_back();
+	check_intrusive_list(my_list, 2);
+
+	my_list.pop_back();
+	REQUIRE(my_list.empty());
+	REQUIRE_FALSE(task_2.ready_hook.is_linked());
+}
+
+TEST_CASE("Insert and erase intrusive list.", "[insert_erase_intrusive_list]")
+{
+	task task_1(1);
+	task task_2(2);
+	task task_3(3);
+
+	ready_list my_list;
+
+	my_list.insert(my_list.end(), task_3);
+	auto it = my_list.insert(my_list.begin(), task_1);
+	my_list.insert(++it, task_2);
+
+	check_intrusive_list(my_list, 1, 2, 3);
+
+	it = my_list.erase(my_list.iterator_to(task_2));
+	REQUIRE(&*it == &task_3);
+	check_intrusive_list(my_list, 1, 3);
+
+	it = my_list.erase(task_3);
+	REQUIRE(it == my_list.end());
+	check_intrusive_list(my_list, 1);
+
+	my_list.clear();
+	REQUIRE_FALSE(task_1.ready_hook.is_linked());
+}
+
+TEST_CASE("Object on several intrusive lists.", "[several_intrusive_lists]")
+{
+	task task_1(1);
+	task task_2(2);
+	task task_3(3);
+
+	ready_list ready;
+	timeout_list timeouts;
+
+	ready.push_back(task_1);
+	ready.push_back(task_2);
+	ready.push_back(task_3);
+
+	timeouts.push_back(task_3);
+	timeouts.push_back(task_1);
+
+	check_intrusive_list(ready, 1, 2, 3);
+	check_intrusive_list(timeouts, 3, 1);
+
+	task_3.ready_hook.unlink();
+
+	check_intrusive_list(ready, 1, 2);
+	check_intrusive_list(timeouts, 3, 1);
+
+	ready.clear();
+	timeouts.clear();
+}
+
+TEST_CASE("Auto unlink hook leaves the list when destroyed.", "[auto_unlink_intrusive_list]")
+{
+	task task_1(1);
+	task task_3(3);
+
+	timeout_list timeouts;
+
+	timeouts.push_back(task_1);
+
+	{
+		task task_2(2);
+		timeouts.push_back(task_2);
+		timeouts.push_back(task_3);
+
+		check_intrusive_list(timeouts, 1, 2, 3);
+	}
+
+	check_intrusive_list(timeouts, 1, 3);
+}
+
+TEST_CASE("Move intrusive list.", "[move_intrusive_list]")
+{
+	task task_1(1);
+	task task_2(2);
+
+	ready_list my_list;
+	my_list.push_back(task_1);
+	my_list.push_back(task_2);
+
+	ready_list other_list(std::move(my_list));
+
+	REQUIRE(my_list.empty());
+	check_intrusive_list(other_list, 1, 2);
+
+	my_list = std::move(other_list);
+
+	REQUIRE(other_list.empty());
+	check_intrusive_list(my_list, 1, 2);
+
+	task copy(task_1);
+	REQUIRE_FALSE(copy.ready_hook.is_linked());
+
+	my_list.clear();
+}
+
+TEST_CASE("Hooks in a base class of a polymorphic type.", "[base_hook_intrusive_list]")
+{
+	job job_1(1);
+	job job_2(2);
+
+	intrusive_list<job, &job::job_hook> jobs;
+	jobs.push_back(job_1);
+	jobs.push_back(job_2);
+
+	check_intrusive_list(jobs, 1, 2);
+	REQUIRE(&jobs.front() == &job_1);
+	REQUIRE(&jobs.back() == &job_2);
+
+	jobs.clear();
+}
@@ -0,0 +1,137 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/array.h"
+#include "../src/my_string.h"
+#include "../src/small_vector.h"
+#include "../src/vector.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+
+using simple::random_access_iterator;
+using simple::vector;
+
+namespace
+{
+
+using iterator = vector<int>::iterator;
+using const_iterator = vector<int>::const_iterator;
+
+template <class It>
+using traits = std::iterator_traits<It>;
+
+static_assert(std::is_same_v<traits<iterator>::iterator_category, std::random_access_iterator_tag>);
+static_assert(std::is_same_v<traits<iterator>::value_type, int>);
+static_assert(std::is_same_v<traits<iterator>::reference, int&>);
+static_assert(std::is_same_v<traits<iterator>::pointer, int*>);
+static_assert(std::is_same_v<traits<iterator>::difference_type, std::ptrdiff_t>);
+
+static_assert(std::is_same_v<traits<const_iterator>::value_type, int>);
+static_assert(std::is_same_v<traits<const_iterator>::reference, const int&>);
+static_assert(std::is_same_v<traits<const_iterator>::pointer, const int*>);
+
+static_assert(std::is_same_v<traits<simple::string::iterator>::iterator_category,
+							 std::random_access_iterator_tag>);
+
+static_assert(std::is_convertible_v<iterator, const_iterator>);
+static_assert(!std::is_convertible_v<const_iterator, iterator>);
+
+#if __cplusplus >= 202002L
+static_assert(std::contiguous_iterator<iterator>);
+static_assert(std::contiguous_iterator<const_iterator>);
+static_assert(std::contiguous_iterator<simple::string::iterator>);
+static_assert(std::contiguous_iterator<simple::small_vector<int, 4>::iterator>);
+#endif
+
+} // namespace
+
+TEST_CASE("Iterator arithmetic with signed and unsigned offsets", "[iterator_arithmetic]")
+{
+	vector<int> values(10);
+	std::iota(values.begin(), values.end(), 0);
+
+	iterator it = values.begin();
+	std::ptrdiff_t forward = 7;
+	std::ptrdiff_t backward = -3;
+	simple::size_type index = 2;
+
+	it += forward;
+	REQUIRE(*it == 7);
+
+	it += backward;
+	REQUIRE(*it == 4);
+
+	it -= backward;
+	REQUIRE(*it == 7);
+
+	it -= index;
+	REQUIRE(*it == 5);
+
+	REQUIRE(*(values.begin() + forward) == 7);
+	REQUIRE(*(forward + values.begin()) == 7);
+	REQUIRE(*(values.end() - 1) == 9);
+	REQUIRE(*(values.end() + backward) == 7);
+	REQUIRE(values.begin()[index] == 2);
+	REQUIRE(it[backward] == 2);
+	REQUIRE(values.end() - values.begin() == 10);
+
+	// Dereferencing a const iterator object still gives mutable elements.
+	const iterator fixed = values.begin();
+	*fixed = 42;
+	REQUIRE(values[0] == 42);
+	REQUIRE(fixed.operator->() == values.data());
+}
+
+TEST_CASE("Iterators compare across constness", "[iterator_const_comparisons]")
+{
+	vector<int> values(4);
+
+	const_iterator first = values.cbegin();
+	iterator last = values.end();
+
+	REQUIRE(first != last);
+	REQUIRE(first < last);
+	REQUIRE(last > first);
+	REQUIRE(first <= last);
+	REQUIRE(last >= first);
+	REQUIRE(first + 4 == last);
+	REQUIRE(last - first == 4);
+}
+
+TEST_CASE("Standard algorithms on simple containers", "[iterator_std_algorithms]")
+{
+	vector<int> values(100);
+	std::iota(values.begin(), values.end(), 0);
+
+	vector<int> copy(100);
+	REQUIRE(std::copy(values.begin(), values.end(), copy.begin()) == copy.end());
+	REQUIRE(copy == values);
+
+	std::fill(copy.begin(), copy.end(), 7);
+	REQUIRE(std::count(copy.begin(), copy.end(), 7) == 100);
+
+	REQUIRE(std::lower_bound(values.begin(), values.end(), 42) - values.begin() == 42);
+	REQUIRE(std::upper_bound(values.cbegin(), values.cend(), 42) - values.cbegin() == 43);
+	REQUIRE(std::binary_search(values.begin(), values.end(), 99));
+
+	std::reverse(values.begin(), values.end());
+	std::sort(values.begin(), values.end());
+	REQUIRE(std::is_sorted(values.begin(), values.end()));
+
+	std::copy_backward(values.begin(), values.begin() + 50, values.end());
+	REQUIRE(values[50] == 0);
+	REQUIRE(values[99] == 49);
+
+	REQUIRE(std::distance(values.begin(), values.end()) == 100);
+	REQUIRE(std::next(values.begin(), 10) - values.begin() == 10);
+
+	auto reversed = std::make_reverse_iterator(values.end());
+	REQUIRE(*reversed == 49);
+
+	simple::string text("hello");
+	std::transform(text.begin(), text.end(), text.begin(),
+				   [](char c) { return static_cast<char>(c - 'a' + 'A'); });
+	REQUIRE(text == "HELLO");
+	REQUIRE(std::find(text.begin(), text.end(), 'L') - text.begin() == 2);
+}
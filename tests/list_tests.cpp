@@ -303,3 +303,200 @@ TEST_CASE("Erase list last item", "erase_list_last_item")
 
 	// REQUIRE(my_list.begin() == my_list.end());
 }
+
+TEST_CASE("Destroy long list", "destroy_long_list")
+{
+	constexpr int num_of_items = 1000000;
+
+	{
+		list<int> my_list;
+
+		for (int i = 0; i < num_of_items; ++i)
+			my_list.emplace_back(i);
+
+		REQUIRE(my_list.size() == num_of_items);
+	}
+
+	list<int> my_list;
+
+	for (int i = 0; i < num_of_items; ++i)
+		my_list.emplace_front(i);
+
+	my_list.clear();
+
+	REQUIRE(my_list.empty());
+	REQUIRE(my_list.begin() == my_list.end());
+}
+
+TEST_CASE("Splice whole list", "splice_whole_list")
+{
+	list<int> list_1;
+	list<int> list_2;
+
+	for (int i : {1, 2, 3})
+		list_1.push_back(i);
+
+	for (int i : {4, 5})
+		list_2.push_back(i);
+
+	list_1.splice(++list_1.begin(), list_2);
+
+	check_list_iterators(list_1, 1, 4, 5, 2, 3);
+	REQUIRE(list_2.empty());
+	REQUIRE(list_2.begin() == list_2.end());
+
+	list_2.splice(list_2.end(), list_1);
+
+	check_list_iterators(list_2, 1, 4, 5, 2, 3);
+	REQUIRE(list_1.empty());
+	REQUIRE(list_2.back() == 3);
+}
+
+TEST_CASE("Splice single element", "splice_single_element")
+{
+	list<int> list_1;
+	list<int> list_2;
+
+	for (int i : {1, 2, 3})
+		list_1.push_back(i);
+
+	for (int i : {4, 5})
+		list_2.push_back(i);
+
+	list_1.splice(list_1.end(), list_2, list_2.begin());
+
+	check_list_iterators(list_1, 1, 2, 3, 4);
+	check_list_iterators(list_2, 5);
+
+	list_1.splice(list_1.begin(), list_1, ++++list_1.begin());
+
+	check_list_iterators(list_1, 3, 1, 2, 4);
+
+	list_1.splice(list_1.end(), list_1, list_1.begin());
+
+	check_list_iterators(list_1, 1, 2, 4, 3);
+	REQUIRE(list_1.back() == 3);
+}
+
+TEST_CASE("Splice range", "splice_range")
+{
+	list<int> list_1;
+	list<int> list_2;
+
+	for (int i : {1, 2})
+		list_1.push_back(i);
+
+	for (int i : {3, 4, 5, 6})
+		list_2.push_back(i);
+
+	list_1.splice(list_1.end(), list_2, ++list_2.begin(), list_2.end());
+
+	check_list_iterators(list_1, 1, 2, 4, 5, 6);
+	check_list_iterators(list_2, 3);
+
+	list_1.splice(list_1.begin(), list_1, ++++list_1.begin(), list_1.end());
+
+	check_list_iterators(list_1, 4, 5, 6, 1, 2);
+	REQUIRE(list_1.back() == 2);
+}
+
+TEST_CASE("Merge lists", "merge_lists")
+{
+	list<int> list_1;
+	list<int> list_2;
+
+	for (int i : {1, 3, 3, 8})
+		list_1.push_back(i);
+
+	for (int i : {0, 2, 3, 9, 10})
+		list_2.push_back(i);
+
+	list_1.merge(list_2);
+
+	check_list_iterators(list_1, 0, 1, 2, 3, 3, 3, 8, 9, 10);
+	REQUIRE(list_2.empty());
+	REQUIRE(list_1.back() == 10);
+}
+
+TEST_CASE("Sort list", "sort_list")
+{
+	list<int> my_list;
+
+	for (int i : {5, 3, 9, 1, 1, 7, 0, 4, 8, 2, 6})
+		my_list.push_back(i);
+
+	my_list.sort();
+
+	check_list_iterators(my_list, 0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+	REQUIRE(my_list.back() == 9);
+
+	my_list.sort([](int lhs, int rhs) { return lhs > rhs; });
+
+	check_list_iterators(my_list, 9, 8, 7, 6, 5, 4, 3, 2, 1, 1, 0);
+}
+
+TEST_CASE("Sort list is stable", "sort_list_stable")
+{
+	struct job
+	{
+		int deadline;
+		int id;
+	};
+
+	list<job> my_list;
+
+	const int num_of_items = 1000;
+
+	for (int i = 0; i < num_of_items; ++i)
+		my_list.push_back({(i * 37) % 10, i});
+
+	const job* first_node = &my_list.front();
+
+	my_list.sort([](const job& lhs, const job& rhs) { return lhs.deadline < rhs.deadline; });
+
+	REQUIRE(my_list.size() == num_of_items);
+
+	auto prev = my_list.begin();
+	for (auto it = ++my_list.begin(); it != my_list.end(); ++it, ++prev)
+	{
+		REQUIRE(prev->deadline <= it->deadline);
+
+		if (prev->deadline == it->deadline)
+			REQUIRE(prev->id < it->id);
+	}
+
+	REQUIRE(&my_list.front() == first_node);
+	REQUIRE(my_list.back().deadline == 9);
+}
+
+TEST_CASE("Reverse list", "reverse_list")
+{
+	list<int> my_list;
+
+	my_list.reverse();
+	REQUIRE(my_list.empty());
+
+	for (int i : {1, 2, 3, 4})
+		my_list.push_back(i);
+
+	my_list.reverse();
+
+	check_list_iterators(my_list, 4, 3, 2, 1);
+	REQUIRE(my_list.back() == 1);
+
+	my_list.push_back(0);
+	check_list_iterators(my_list, 4, 3, 2, 1, 0);
+}
+
+TEST_CASE("Unique list", "unique_list")
+{
+	list<int> my_list;
+
+	for (int i : {1, 1, 2, 3, 3, 3, 1, 4, 4})
+		my_list.push_back(i);
+
+	REQUIRE(my_list.unique() == 4);
+
+	check_list_iterators(my_list, 1, 2, 3, 1, 4);
+	REQUIRE(my_list.back() == 4);
+}
@@ -0,0 +1,205 @@
+#include "../lib/include/catch2/catch.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "../src/lockfree_stack.h"
+#include "../src/my_string.h"
+#include "../src/vector.h"
+
+using simple::lockfree_stack;
+using simple::string;
+using simple::vector;
+
+TEST_CASE("Check if a new lockfree stack is empty.", "[empty_lockfree_stack]")
+{
+	lockfree_stack<int> stack;
+
+	int value = 0;
+
+	REQUIRE(stack.empty());
+	REQUIRE_FALSE(stack.pop(value));
+}
+
+TEST_CASE("Push and pop lockfree stack.", "[push_pop_lockfree_stack]")
+{
+	lockfree_stack<string> stack;
+
+	stack.push("1");
+	stack.emplace("2");
+	stack.push(string("3"));
+
+	string value;
+
+	REQUIRE(stack.pop(value));
+	REQUIRE(value == "3");
+
+	REQUIRE(stack.pop(value));
+	REQUIRE(value == "2");
+
+	stack.push("4");
+
+	REQUIRE(stack.pop(value));
+	REQUIRE(value == "4");
+
+	REQUIRE(stack.pop(value));
+	REQUIRE(value == "1");
+
+	REQUIRE_FALSE(stack.pop(value));
+	REQUIRE(stack.empty());
+}
+
+TEST_CASE("Push range and pop all lockfree stack.", "[push_range_pop_all_lockfree_stack]")
+{
+	lockfree_stack<int> stack;
+
+	vector<int> items;
+	for (int i = 1; i <= 4; ++i)
+		items.push_back(i);
+
+	stack.push(0);
+	stack.push_range(items.begin(), items.end());
+
+	vector<int> popped;
+	REQUIRE(stack.pop_all([&popped](int&& value) { popped.push_back(value); }) == 5);
+
+	REQUIRE(popped.size() == 5);
+	for (int i = 0; i < 5; ++i)
+		REQUIRE(popped[static_cast<std::size_t>(i)] == 4 - i);
+
+	REQUIRE(stack.empty());
+	REQUIRE(stack.pop_all([](int&& /*value*/) {}) == 0);
+
+	stack.push_range(items.begin(), items.end());
+
+	int value = 0;
+	REQUIRE(stack.pop(value));
+	REQUIRE(value == 4);
+}
+
+TEST_CASE("Lockfree stack with many producers and consumers.", "[mpmc_lockfree_stack]")
+{
+	constexpr int num_of_producers = 4;
+	constexpr int num_of_consumers = 4;
+	constexpr int items_per_producer = 20000;
+	constexpr int num_of_items = num_of_producers * items_per_producer;
+
+	lockfree_stack<int> stack;
+
+	std::atomic<int> consumed {0};
+	std::atomic<long long> sum {0};
+
+	vector<std::thread> threads;
+
+	for (int p = 0; p < num_of_producers; ++p)
+	{
+		threads.emplace_back([&stack, p]() {
+			for (int i = 0; i < items_per_producer; ++i)
+			{
+				int value = p * items_per_producer + i;
+
+				if (i % 4 == 0)
+				{
+					int range[] = {value};
+					stack.push_range(range, range + 1);
+				}
+
+				else
+					stack.push(value);
+			}
+		});
+	}
+
+	for (int c = 0; c < num_of_consumers; ++c)
+	{
+		threads.emplace_back([&stack, &consumed, &sum, c]() {
+			while (consumed.load() < num_of_items)
+			{
+				if (c == 0)
+				{
+					long long local_sum = 0;
+					int count = static_cast<int>(
+						stack.pop_all([&local_sum](int&& value) { local_sum += value; }));
+
+					sum += local_sum;
+					consumed += count;
+					continue;
+				}
+
+				int value = 0;
+				if (stack.pop(value))
+				{
+					sum += value;
+					++consumed;
+				}
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	const long long expected_sum =
+		static_cast<long long>(num_of_items) * (num_of_items - 1) / 2;
+
+	REQUIRE(consumed.load() == num_of_items);
+	REQUIRE(sum.load() == expected_sum);
+	REQUIRE(stack.empty());
+}
+
+namespace
+{
+
+// Counts live instances, and throws when copied from a negative value.
+struct counted_item
+{
+	explicit counted_item(int t_value) : value(t_value) { ++live; }
+
+	counted_item(const counted_item& other) : value(other.value)
+	{
+		if (other.value < 0)
+			throw std::invalid_argument("negative");
+
+		++live;
+	}
+
+	~counted_item() { --live; }
+
+	counted_item& operator=(const counted_item& other) = default;
+
+	static inline int live = 0;
+
+	int value;
+};
+
+} // namespace
+
+TEST_CASE("Throwing pushes leak no nodes or values.", "[lockfree_stack_throw]")
+{
+	{
+		lockfree_stack<counted_item> stack;
+
+		const counted_item bad(-1);
+		REQUIRE_THROWS_AS(stack.push(bad), std::invalid_argument);
+		REQUIRE(stack.empty());
+
+		vector<counted_item> items;
+		items.reserve(4);
+
+		for (int i : {1, 2, -3, 4})
+			items.emplace_back(i);
+
+		REQUIRE_THROWS_AS(stack.push_range(items.begin(), items.end()), std::invalid_argument);
+		REQUIRE(stack.empty());
+		REQUIRE(counted_item::live == 5);
+
+		stack.push_range(items.begin(), items.begin() + 2);
+
+		counted_item top(0);
+		REQUIRE(stack.pop(top));
+		REQUIRE(top.value == 2);
+	}
+
+	REQUIRE(counted_item::live == 0);
+}
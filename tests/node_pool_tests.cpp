@@ -0,0 +1,153 @@
+#include "../lib/include/catch2/catch.hpp"
+
+#include "../src/forward_list.h"
+#include "../src/list.h"
+#include "../src/node_pool.h"
+
+#include <thread>
+
+using simple::forward_list;
+using simple::list;
+using simple::node_pool;
+
+namespace
+{
+
+struct pooled_item
+{
+	explicit pooled_item(int t_value) : value(t_value) {}
+
+	int value;
+	char padding[20] = {};
+};
+
+struct forward_pooled_item
+{
+	explicit forward_pooled_item(int t_value) : value(t_value) {}
+
+	int value;
+};
+
+} // namespace
+
+TEST_CASE("Node pool hands out distinct aligned slots.", "[node_pool_distinct_slots]")
+{
+	using pool_type = node_pool<simple::list_node<pooled_item>>;
+
+	pool_type& pool = pool_type::instance();
+
+	void* first = pool.allocate();
+	void* second = pool.allocate();
+
+	REQUIRE(first != second);
+	REQUIRE(reinterpret_cast<std::uintptr_t>(first) % alignof(simple::list_node<pooled_item>) == 0);
+	REQUIRE(reinterpret_cast<std::uintptr_t>(second) % alignof(simple::list_node<pooled_item>) ==
+			0);
+
+	pool.deallocate(second);
+
+	void* third = pool.allocate();
+	REQUIRE(third == second);
+
+	pool.deallocate(first);
+	pool.deallocate(third);
+}
+
+TEST_CASE("List nodes are recycled after erase.", "[list_nodes_recycled]")
+{
+	using pool_type = node_pool<simple::list_node<pooled_item>>;
+
+	const auto chunks_before = pool_type::instance().chunk_count();
+
+	list<pooled_item> my_list;
+
+	my_list.emplace_back(1);
+	my_list.emplace_back(2);
+
+	const pooled_item* erased = &my_list.front();
+	my_list.pop_front();
+
+	REQUIRE(&my_list.emplace_back(3) == erased);
+	REQUIRE(pool_type::instance().chunk_count() <= chunks_before + 1);
+}
+
+// The chunk counts are compared with the count at the start, since other
+// tests may still hold nodes, and the lists are filled and cleared on their
+// own thread, whose cached slots go back to the chunks when it exits.
+TEST_CASE("Clearing a list releases whole chunks.", "[list_clear_releases_chunks]")
+{
+	using pool_type = node_pool<simple::list_node<pooled_item>>;
+
+	const auto chunks_before = pool_type::instance().chunk_count();
+	pool_type::size_type chunks_filled = 0;
+	int sum = 0;
+
+	std::thread worker([&]() {
+		list<pooled_item> my_list;
+
+		const auto num_of_items = static_cast<int>(pool_type::SLOTS_PER_CHUNK * 4);
+
+		for (int i = 0; i < num_of_items; ++i)
+			my_list.emplace_back(i);
+
+		chunks_filled = pool_type::instance().chunk_count();
+
+		my_list.clear();
+
+		for (int i = 0; i < 10; ++i)
+			sum += my_list.emplace_back(i).value;
+	});
+
+	worker.join();
+
+	REQUIRE(chunks_filled >= chunks_before + 3);
+	REQUIRE(sum == 45);
+	REQUIRE(pool_type::instance().chunk_count() <= chunks_before + 1);
+}
+
+TEST_CASE("Forward list nodes come from the pool.", "[forward_list_nodes_pooled]")
+{
+	using pool_type = node_pool<simple::forward_list_node<forward_pooled_item>>;
+
+	const auto chunks_before = pool_type::instance().chunk_count();
+	pool_type::size_type chunks_filled = 0;
+	int front = 0;
+
+	const auto num_of_items = static_cast<int>(pool_type::SLOTS_PER_CHUNK * 2 + 1);
+
+	std::thread worker([&]() {
+		forward_list<forward_pooled_item> my_list;
+
+		for (int i = 0; i < num_of_items; ++i)
+			my_list.emplace_front(i);
+
+		chunks_filled = pool_type::instance().chunk_count();
+		front = my_list.front().value;
+	});
+
+	worker.join();
+
+	REQUIRE(chunks_filled >= chunks_before + 2);
+	REQUIRE(front == num_of_items - 1);
+	REQUIRE(pool_type::instance().chunk_count() <= chunks_before + 1);
+}
+
+TEST_CASE("Nodes freed on another thread are reused.", "[node_pool_cross_thread]")
+{
+	using pool_type = node_pool<simple::list_node<pooled_item>>;
+
+	const auto chunks_before = pool_type::instance().chunk_count();
+
+	for (int round = 0; round < 100; ++round)
+	{
+		list<pooled_item> my_list;
+
+		for (int i = 0; i < 1000; ++i)
+			my_list.emplace_back(i);
+
+		std::thread consumer([&my_list]() noexcept { my_list.clear(); });
+		consumer.join();
+	}
+
+	REQUIRE(pool_type::instance().chunk_count() <= chunks_before + 1);
+}
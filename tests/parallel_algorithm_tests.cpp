@@ -0,0 +1,351 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/my_string.h"
+#include "../src/parallel_algorithm.h"
+#include "../src/vector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using simple::parallel_policy;
+using simple::size_type;
+using simple::thread_pool;
+using simple::vector;
+
+namespace
+{
+
+vector<int> random_ints(size_type count, int max_value, unsigned seed)
+{
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> distribution(0, max_value);
+
+	vector<int> values;
+	values.reserve(count);
+
+	for (size_type i = 0; i < count; ++i)
+		values.push_back(distribution(generator));
+
+	return values;
+}
+
+std::vector<int> to_std(const vector<int>& values)
+{
+	return {values.data(), values.data() + values.size()};
+}
+
+} // namespace
+
+TEST_CASE("Parallel policy chunking", "[parallel_policy]")
+{
+	thread_pool pool(4);
+	parallel_policy policy(pool, 100);
+
+	REQUIRE(policy.serial_threshold() == 100);
+	REQUIRE(policy.is_serial(100));
+	REQUIRE_FALSE(policy.is_serial(101));
+
+	// Never below the threshold, otherwise a few chunks per thread.
+	REQUIRE(policy.chunk_size(101) == 100);
+	REQUIRE(policy.chunk_size(16000) == 1000);
+
+	REQUIRE(parallel_policy(pool, 0).serial_threshold() == 1);
+	REQUIRE(parallel_policy(pool).serial_threshold() == parallel_policy::DEFAULT_SERIAL_THRESHOLD);
+}
+
+TEST_CASE("Parallel for_each and transform", "[parallel_for_each_transform]")
+{
+	thread_pool pool(4);
+
+	for (size_type threshold : {size_type(16), size_type(1) << 20})
+	{
+		parallel_policy policy(pool, threshold);
+
+		for (size_type count : {size_type(0), size_type(1), size_type(16), size_type(10007)})
+		{
+			vector<int> values(count);
+			simple::for_each(policy, values.begin(), values.end(), [](int& value) { value += 3; });
+
+			REQUIRE(std::count(values.data(), values.data() + count, 3) ==
+					static_cast<std::ptrdiff_t>(count));
+
+			std::iota(values.data(), values.data() + count, 0);
+
+			vector<long long> squares(count);
+			auto end = simple::transform(policy, values.begin(), values.end(), squares.begin(),
+										 [](int value) { return 1LL * value * value; });
+			REQUIRE(end == squares.end());
+
+			for (size_type i = 0; i < count; ++i)
+				REQUIRE(squares[i] == static_cast<long long>(i * i));
+
+			vector<long long> sums(count);
+			simple::transform(policy, values.begin(), values.end(), squares.begin(), sums.begin(),
+							  [](int value, long long square) { return value + square; });
+
+			for (size_type i = 0; i < count; ++i)
+				REQUIRE(sums[i] == static_cast<long long>(i * i + i));
+
+			// In place.
+			simple::transform(policy, values.begin(), values.end(), values.begin(),
+							  [](int value) { return -value; });
+
+			for (size_type i = 0; i < count; ++i)
+				REQUIRE(values[i] == -static_cast<int>(i));
+		}
+	}
+}
+
+TEST_CASE("Parallel reduce", "[parallel_reduce]")
+{
+	thread_pool pool(3);
+	parallel_policy policy(pool, 64);
+
+	vector<int> values = random_ints(100003, 1000, 1);
+	std::vector<int> expected = to_std(values);
+
+	long long sum = std::accumulate(expected.begin(), expected.end(), 0LL);
+	REQUIRE(simple::reduce(policy, values.begin(), values.end(), 0LL) == sum);
+	REQUIRE(simple::reduce(policy, values.begin(), values.end(), 10LL) == sum + 10);
+	REQUIRE(simple::reduce(policy, values.begin(), values.begin() + 10) ==
+			std::accumulate(expected.begin(), expected.begin() + 10, 0));
+
+	int maximum = simple::reduce(policy, values.begin(), values.end(), -1,
+								 [](int lhs, int rhs) { return std::max(lhs, rhs); });
+	REQUIRE(maximum == *std::max_element(expected.begin(), expected.end()));
+
+	REQUIRE(simple::reduce(policy, values.begin(), values.begin(), 5) == 5);
+
+	// Strings are reduced in chunk order, so concatenation keeps its order.
+	vector<simple::string> words;
+	std::string joined;
+
+	for (int i = 0; i < 500; ++i)
+	{
+		words.push_back(simple::string(std::to_string(i % 10).c_str()));
+		joined += std::to_string(i % 10);
+	}
+
+	simple::string concatenated =
+		simple::reduce(parallel_policy(pool, 8), words.begin(), words.end(), simple::string(""),
+					   [](const simple::string& lhs, const simple::string& rhs) {
+						   return simple::string((std::string(lhs.c_str()) + rhs.c_str()).c_str());
+					   });
+	REQUIRE(concatenated == joined.c_str());
+}
+
+TEST_CASE("Parallel inclusive and exclusive scan", "[parallel_scan]")
+{
+	thread_pool pool(4);
+
+	for (size_type threshold : {size_type(1), size_type(37), size_type(1) << 20})
+	{
+		parallel_policy policy(pool, threshold);
+
+		for (size_type count : {size_type(0), size_type(1), size_type(2), size_type(5000)})
+		{
+			vector<int> values = random_ints(count, 100, static_cast<unsigned>(count));
+			std::vector<int> input = to_std(values);
+
+			std::vector<long long> expected(count);
+			std::partial_sum(input.begin(), input.end(), expected.begin(),
+							 [](long long lhs, long long rhs) { return lhs + rhs; });
+
+			vector<long long> inclusive(count);
+			auto end =
+				simple::inclusive_scan(policy, values.begin(), values.end(), inclusive.begin(),
+									   [](long long lhs, long long rhs) { return lhs + rhs; });
+			REQUIRE(end == inclusive.end());
+			REQUIRE(std::equal(expected.begin(), expected.end(), inclusive.data()));
+
+			simple::inclusive_scan(policy, values.begin(), values.end(), inclusive.begin(),
+								   [](long long lhs, long long rhs) { return lhs + rhs; }, 100LL);
+
+			for (size_type i = 0; i < count; ++i)
+				REQUIRE(inclusive[i] == expected[i] + 100);
+
+			vector<long long> exclusive(count);
+			simple::exclusive_scan(policy, values.begin(), values.end(), exclusive.begin(), 7LL);
+
+			for (size_type i = 0; i < count; ++i)
+				REQUIRE(exclusive[i] == 7 + (i ? expected[i - 1] : 0));
+
+			// In place.
+			vector<int> in_place = values;
+			simple::inclusive_scan(policy, in_place.begin(), in_place.end(), in_place.begin());
+
+			for (size_type i = 0; i < count; ++i)
+				REQUIRE(in_place[i] == expected[i]);
+
+			in_place = values;
+			simple::exclusive_scan(policy, in_place.begin(), in_place.end(), in_place.begin(), 0);
+
+			for (size_type i = 0; i < count; ++i)
+				REQUIRE(in_place[i] == (i ? expected[i - 1] : 0));
+		}
+	}
+}
+
+TEST_CASE("Parallel sort", "[parallel_sort]")
+{
+	thread_pool pool(4);
+
+	for (size_type threshold : {size_type(1), size_type(100), size_type(1) << 20})
+	{
+		parallel_policy policy(pool, threshold);
+
+		for (size_type count : {size_type(0), size_type(1), size_type(2), size_type(1000),
+								size_type(65537)})
+		{
+			// Few distinct values, so that the merges see long runs of ties.
+			for (int max_value : {3, 1 << 30})
+			{
+				vector<int> values = random_ints(count, max_value, static_cast<unsigned>(count));
+				std::vector<int> expected = to_std(values);
+				std::sort(expected.begin(), expected.end());
+
+				simple::sort(policy, values.begin(), values.end());
+				REQUIRE(to_std(values) == expected);
+
+				simple::sort(policy, values.begin(), values.end(), std::greater<>());
+				REQUIRE(std::equal(expected.rbegin(), expected.rend(), values.data()));
+			}
+		}
+	}
+}
+
+TEST_CASE("Parallel sort is stable", "[parallel_sort_stable]")
+{
+	thread_pool pool(4);
+	parallel_policy policy(pool, 50);
+
+	struct record
+	{
+		int key = 0;
+		size_type position = 0;
+	};
+
+	vector<int> keys = random_ints(20000, 20, 7);
+	vector<record> records;
+
+	for (size_type i = 0; i < keys.size(); ++i)
+		records.push_back(record {keys[i], i});
+
+	simple::sort(policy, records.begin(), records.end(),
+				 [](const record& lhs, const record& rhs) { return lhs.key < rhs.key; });
+
+	for (size_type i = 1; i < records.size(); ++i)
+	{
+		REQUIRE(records[i - 1].key <= records[i].key);
+
+		if (records[i - 1].key == records[i].key)
+			REQUIRE(records[i - 1].position < records[i].position);
+	}
+}
+
+TEST_CASE("Parallel sort of strings", "[parallel_sort_strings]")
+{
+	thread_pool pool(2);
+	parallel_policy policy(pool, 16);
+
+	vector<int> numbers = random_ints(3000, 100000, 3);
+	vector<simple::string> strings;
+	std::vector<std::string> expected;
+
+	for (int number : numbers)
+	{
+		strings.push_back(simple::string(std::to_string(number).c_str()));
+		expected.push_back(std::to_string(number));
+	}
+
+	std::sort(expected.begin(), expected.end());
+	simple::sort(policy, strings.begin(), strings.end(),
+				 [](const simple::string& lhs, const simple::string& rhs) {
+					 return std::string(lhs.c_str()) < rhs.c_str();
+				 });
+
+	for (size_type i = 0; i < strings.size(); ++i)
+		REQUIRE(strings[i] == expected[i].c_str());
+}
+
+TEST_CASE("Parallel partition", "[parallel_partition]")
+{
+	thread_pool pool(4);
+
+	for (size_type threshold : {size_type(1), size_type(100), size_type(1) << 20})
+	{
+		parallel_policy policy(pool, threshold);
+
+		for (size_type count : {size_type(0), size_type(1), size_type(1000), size_type(30011)})
+		{
+			vector<int> values = random_ints(count, 1000, static_cast<unsigned>(count) + 1);
+			std::vector<int> expected = to_std(values);
+
+			auto is_even = [](int value) { return value % 2 == 0; };
+			auto expected_point = std::stable_partition(expected.begin(), expected.end(), is_even);
+
+			auto point = simple::partition(policy, values.begin(), values.end(), is_even);
+
+			REQUIRE(point - values.begin() == expected_point - expected.begin());
+			REQUIRE(to_std(values) == expected);
+		}
+	}
+
+	vector<int> none(500, 1);
+	REQUIRE(simple::partition(parallel_policy(pool, 10), none.begin(), none.end(),
+							  [](int value) { return value == 0; }) == none.begin());
+}
+
+TEST_CASE("Parallel algorithms rethrow exceptions", "[parallel_algorithm_exception]")
+{
+	thread_pool pool(4);
+	parallel_policy policy(pool, 10);
+
+	vector<int> values(1000);
+	std::iota(values.data(), values.data() + values.size(), 0);
+
+	REQUIRE_THROWS_AS(simple::for_each(policy, values.begin(), values.end(),
+									   [](int value) {
+										   if (value == 777)
+											   throw std::runtime_error("777");
+									   }),
+					  std::runtime_error);
+}
+
+TEST_CASE("Parallel algorithms nest inside pool tasks", "[parallel_algorithm_nested]")
+{
+	thread_pool pool(4);
+	parallel_policy policy(pool, 32);
+
+	vector<vector<int>> rows;
+
+	for (unsigned row = 0; row < 16; ++row)
+		rows.push_back(random_ints(2000, 1 << 20, row));
+
+	simple::for_each(parallel_policy(pool, 1), rows.begin(), rows.end(),
+					 [&policy](vector<int>& row) { simple::sort(policy, row.begin(), row.end()); });
+
+	for (auto& row : rows)
+		REQUIRE(std::is_sorted(row.data(), row.data() + row.size()));
+}
+
+// Serial against parallel on all cores, standing in for a benchmark.
+TEST_CASE("Parallel algorithms match serial on a large vector", "[parallel_algorithm_large]")
+{
+	thread_pool pool;
+	parallel_policy parallel(pool);
+	parallel_policy serial(pool, size_type(1) << 30);
+
+	vector<int> values = random_ints(size_type(1) << 20, 1 << 30, 11);
+	vector<int> copy = values;
+
+	REQUIRE(simple::reduce(parallel, values.begin(), values.end(), 0LL) ==
+			simple::reduce(serial, values.begin(), values.end(), 0LL));
+
+	simple::sort(parallel, values.begin(), values.end());
+	simple::sort(serial, copy.begin(), copy.end());
+	REQUIRE(values == copy);
+}
@@ -0,0 +1,280 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/my_string.h"
+#include "../src/rope.h"
+#include "../src/string_view.h"
+#include "../src/vector.h"
+
+#include <random>
+#include <string>
+
+#if defined(__unix__)
+#include <cstdlib>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+using simple::rope;
+using simple::size_type;
+using simple::string;
+using simple::string_view;
+
+namespace
+{
+
+bool same_text(const rope& text, const std::string& expected)
+{
+	return text == string_view(expected.data(), expected.size());
+}
+
+std::string random_text(std::mt19937& engine, size_type size)
+{
+	std::uniform_int_distribution<int> letter('a', 'z');
+	std::string result;
+
+	for (size_type i = 0; i < size; ++i)
+		result.push_back(static_cast<char>(letter(engine)));
+
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("Build a rope by appending", "[rope_append]")
+{
+	rope text;
+	REQUIRE(text.empty());
+	REQUIRE(text.chunk_count() == 0);
+	REQUIRE(text == "");
+
+	text += "hello";
+	text.append(string(", "));
+	text.append(rope("world"));
+	text.prepend(rope(">> "));
+
+	REQUIRE(text.size() == 15);
+	REQUIRE(text == ">> hello, world");
+	REQUIRE(text != ">> hello, world!");
+	REQUIRE(text.to_string() == ">> hello, world");
+	REQUIRE(text[3] == 'h');
+	REQUIRE(text.at(14) == 'd');
+	REQUIRE_THROWS_AS(text.at(15), std::out_of_range);
+
+	// Small pieces are merged instead of getting a chunk each.
+	REQUIRE(text.chunk_count() == 1);
+
+	rope both = text + rope("!");
+	REQUIRE(both == ">> hello, world!");
+	REQUIRE(text == ">> hello, world");
+}
+
+TEST_CASE("Many small appends stay in few chunks", "[rope_small_appends]")
+{
+	rope text;
+	std::string expected;
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		string_view piece = i % 2 ? string_view("ab") : string_view("cde");
+		text += piece;
+		expected.append(piece.data(), piece.size());
+	}
+
+	REQUIRE(text.size() == 25000);
+	REQUIRE(same_text(text, expected));
+	REQUIRE(text.chunk_count() <= 25000 / 128 + 1);
+}
+
+TEST_CASE("Large strings are adopted as chunks", "[rope_adopt]")
+{
+	string large(1000, 'x');
+	const char* chars = large.data();
+
+	rope text(std::move(large));
+	text.append(string(1000, 'y'));
+
+	REQUIRE(text.chunk_count() == 2);
+	REQUIRE((*text.chunks().begin()).data() == chars);
+	REQUIRE(text[999] == 'x');
+	REQUIRE(text[1000] == 'y');
+}
+
+TEST_CASE("Substrings share the chunks", "[rope_substr]")
+{
+	rope text(string(1000, 'a'));
+	text.append(string(1000, 'b'));
+
+	rope middle = text.substr(500, 1000);
+	REQUIRE(middle.size() == 1000);
+	REQUIRE(middle.chunk_count() == 2);
+	REQUIRE(middle[499] == 'a');
+	REQUIRE(middle[500] == 'b');
+	REQUIRE((*middle.chunks().begin()).data() == (*text.chunks().begin()).data() + 500);
+
+	// Small pieces of chunks are merged again.
+	REQUIRE(text.substr(900, 200).chunk_count() == 1);
+
+	REQUIRE(text.substr(2000).empty());
+	REQUIRE(text.substr(1990, 100).size() == 10);
+	REQUIRE_THROWS_AS(text.substr(2001), std::out_of_range);
+}
+
+TEST_CASE("Insert into and erase from a rope", "[rope_insert_erase]")
+{
+	rope text("hello world");
+
+	text.insert(5, rope(","));
+	REQUIRE(text == "hello, world");
+
+	text.insert(0, rope("[")).insert(text.size(), rope("]"));
+	REQUIRE(text == "[hello, world]");
+
+	text.erase(6, 1);
+	REQUIRE(text == "[hello world]");
+
+	text.erase(6);
+	REQUIRE(text == "[hello");
+
+	REQUIRE_THROWS_AS(text.insert(7, rope("x")), std::out_of_range);
+	REQUIRE_THROWS_AS(text.erase(7), std::out_of_range);
+}
+
+TEST_CASE("Copies are not changed by appends in place", "[rope_sharing]")
+{
+	rope first("shared");
+	rope second = first;
+
+	first += " by the first";
+	second += " by the second";
+
+	REQUIRE(first == "shared by the first");
+	REQUIRE(second == "shared by the second");
+
+	rope prefix = first.substr(0, 6);
+	prefix += "!";
+	REQUIRE(prefix == "shared!");
+	REQUIRE(first == "shared by the first");
+
+	rope self("abc");
+	self.append(self);
+	self.append(self);
+	REQUIRE(self == "abcabcabcabc");
+}
+
+TEST_CASE("Iterate over the chunks of a rope", "[rope_chunks]")
+{
+	rope text;
+
+	for (int i = 0; i < 8; ++i)
+		text.append(string(300, static_cast<char>('a' + i)));
+
+	REQUIRE(text.chunk_count() == 8);
+	REQUIRE(text.chunks().size() == 8);
+
+	size_type total = 0;
+	char expected = 'a';
+
+	for (string_view chunk : text.chunks())
+	{
+		REQUIRE(chunk.size() == 300);
+		REQUIRE(chunk.front() == expected);
+		total += chunk.size();
+		++expected;
+	}
+
+	REQUIRE(total == text.size());
+
+	rope empty;
+	REQUIRE(empty.chunks().begin() == empty.chunks().end());
+}
+
+#if defined(__unix__)
+TEST_CASE("Write a rope with writev", "[rope_writev]")
+{
+	rope text(string(500, 'x'));
+	text.append(string_view("-middle-"));
+	text.append(string(500, 'y'));
+	text.insert(250, rope(string(400, 'z')));
+
+	simple::vector<iovec> buffers;
+	buffers.reserve(text.chunk_count());
+
+	for (string_view chunk : text.chunks())
+		buffers.push_back(iovec {const_cast<char*>(chunk.data()), chunk.size()});
+
+	char path[] = "/tmp/rope_tests_XXXXXX";
+	int file = mkstemp(path);
+	REQUIRE(file >= 0);
+
+	ssize_t written = writev(file, buffers.data(), static_cast<int>(buffers.size()));
+	REQUIRE(written == static_cast<ssize_t>(text.size()));
+
+	string contents(text.size(), '\0');
+	REQUIRE(pread(file, contents.data(), contents.size(), 0) == written);
+
+	close(file);
+	unlink(path);
+
+	REQUIRE(text == contents);
+}
+#endif
+
+TEST_CASE("Random edits match a std::string", "[rope_random]")
+{
+	std::mt19937 engine(42);
+	rope text;
+	std::string expected;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		std::uniform_int_distribution<size_type> position(0, expected.size());
+		size_type pos = position(engine);
+		std::uniform_int_distribution<size_type> length(0, expected.size() - pos);
+
+		switch (engine() % 4)
+		{
+		case 0:
+		{
+			std::string piece = random_text(engine, engine() % 2 ? engine() % 16 : engine() % 600);
+			text.append(string_view(piece.data(), piece.size()));
+			expected += piece;
+			break;
+		}
+		case 1:
+		{
+			std::string piece = random_text(engine, engine() % 40);
+			text.insert(pos, rope(string_view(piece.data(), piece.size())));
+			expected.insert(pos, piece);
+			break;
+		}
+		case 2:
+		{
+			size_type count = length(engine) / 4;
+			text.erase(pos, count);
+			expected.erase(pos, count);
+			break;
+		}
+		default:
+		{
+			size_type count = length(engine);
+			rope part = text.substr(pos, count);
+			REQUIRE(same_text(part, expected.substr(pos, count)));
+			text.append(part);
+			expected += expected.substr(pos, count);
+			break;
+		}
+		}
+
+		if (expected.size() > 20000)
+		{
+			text = text.substr(expected.size() - 5000);
+			expected = expected.substr(expected.size() - 5000);
+		}
+
+		REQUIRE(text.size() == expected.size());
+	}
+
+	REQUIRE(same_text(text, expected));
+
+	for (size_type i = 0; i < expected.size(); i += 97)
+		REQUIRE(text[i] == expected[i]);
+}
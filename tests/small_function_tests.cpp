@@ -0,0 +1,86 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/small_function.h"
+#include "../src/unique_ptr.h"
+
+#include <utility>
+
+using simple::small_function;
+
+namespace
+{
+
+struct counted
+{
+	explicit counted(int* t_live) : live(t_live) { ++*live; }
+	counted(counted&& other) noexcept : live(other.live) { ++*live; }
+	counted(const counted& other) : live(other.live) { ++*live; }
+	~counted() { --*live; }
+
+	int operator()(int value) const { return value * 2; }
+
+	int* live;
+};
+
+} // namespace
+
+TEST_CASE("Call a small function", "[small_function_call]")
+{
+	int base = 10;
+	small_function<int(int)> add([base](int value) { return base + value; });
+
+	REQUIRE(static_cast<bool>(add));
+	REQUIRE(add(5) == 15);
+
+	small_function<int(int)> empty;
+	REQUIRE_FALSE(static_cast<bool>(empty));
+
+	empty = std::move(add);
+	REQUIRE_FALSE(static_cast<bool>(add));
+	REQUIRE(empty(1) == 11);
+
+	small_function<void()> move_only([ptr = simple::make_unique<int>(3)] { *ptr += 1; });
+	move_only();
+}
+
+TEST_CASE("Small function storage", "[small_function_storage]")
+{
+	struct big
+	{
+		char bytes[128];
+		int operator()() const { return bytes[0]; }
+	};
+
+	using function = small_function<int()>;
+
+	REQUIRE(function::stores_inline<int (*)()>());
+	REQUIRE_FALSE(function::stores_inline<big>());
+
+	big value {};
+	value.bytes[0] = 7;
+
+	function from_heap(value);
+	function moved(std::move(from_heap));
+	REQUIRE(moved() == 7);
+}
+
+TEST_CASE("Small function destroys its callable", "[small_function_lifetime]")
+{
+	int live = 0;
+
+	{
+		small_function<int(int)> function {counted(&live)};
+		REQUIRE(live == 1);
+		REQUIRE(function(4) == 8);
+
+		small_function<int(int)> moved(std::move(function));
+		REQUIRE(live == 1);
+
+		moved = nullptr;
+		REQUIRE(live == 0);
+
+		moved = counted(&live);
+		REQUIRE(live == 1);
+	}
+
+	REQUIRE(live == 0);
+}
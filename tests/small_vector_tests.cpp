@@ -0,0 +1,167 @@
+#include "../lib/include/catch2/catch.hpp"
+
+#include "../src/my_string.h"
+#include "../src/small_vector.h"
+
+using simple::small_vector;
+using simple::string;
+
+TEST_CASE("Check if a new small_vector is empty.", "[empty_small_vector]")
+{
+	small_vector<int, 8> vec;
+
+	REQUIRE(vec.empty());
+	REQUIRE(vec.capacity() == 8);
+	REQUIRE(vec.is_inline());
+}
+
+TEST_CASE("Small vector stays inline up to N elements.", "[small_vector_inline]")
+{
+	small_vector<int, 4> vec;
+
+	for (int i = 0; i < 4; ++i)
+		vec.push_back(i);
+
+	REQUIRE(vec.is_inline());
+	REQUIRE(vec.size() == 4);
+
+	const auto* object_begin = reinterpret_cast<const unsigned char*>(&vec);
+	const auto* data = reinterpret_cast<const unsigned char*>(vec.data());
+	REQUIRE(data >= object_begin);
+	REQUIRE(data < object_begin + sizeof(vec));
+
+	vec.push_back(4);
+
+	REQUIRE_FALSE(vec.is_inline());
+	REQUIRE(vec.capacity() > 4);
+
+	for (int i = 0; i < 5; ++i)
+		REQUIRE(vec[static_cast<std::size_t>(i)] == i);
+}
+
+TEST_CASE("Small vector spills strings to the heap.", "[small_vector_spill_strings]")
+{
+	small_vector<string, 2> vec;
+
+	vec.emplace_back("1");
+	vec.emplace_back("2");
+	vec.emplace_back("3");
+	vec.push_back("4");
+
+	REQUIRE(vec.size() == 4);
+	REQUIRE(vec.front() == "1");
+	REQUIRE(vec.back() == "4");
+	REQUIRE(vec.at(2) == "3");
+	REQUIRE_THROWS_AS(vec.at(4), std::out_of_range);
+
+	auto it = vec.erase(vec.begin() + 1);
+	REQUIRE(*it == "3");
+	REQUIRE(vec.size() == 3);
+
+	vec.pop_back();
+	REQUIRE(vec.back() == "3");
+
+	vec.clear();
+	REQUIRE(vec.empty());
+}
+
+TEST_CASE("Copy and move small vectors.", "[copy_move_small_vector]")
+{
+	small_vector<string, 3> inline_vec;
+	inline_vec.emplace_back("a");
+	inline_vec.emplace_back("b");
+
+	small_vector<string, 3> heap_vec;
+	for (const char* item : {"1", "2", "3", "4"})
+		heap_vec.emplace_back(item);
+
+	small_vector<string, 3> inline_copy(inline_vec);
+	small_vector<string, 3> heap_copy(heap_vec);
+
+	REQUIRE(inline_copy == inline_vec);
+	REQUIRE(heap_copy == heap_vec);
+	REQUIRE(inline_copy != heap_copy);
+
+	small_vector<string, 3> inline_moved(std::move(inline_copy));
+	REQUIRE(inline_moved.is_inline());
+	REQUIRE(inline_moved == inline_vec);
+	REQUIRE(inline_copy.empty());
+
+	const string* heap_data = heap_copy.data();
+	small_vector<string, 3> heap_moved(std::move(heap_copy));
+	REQUIRE(heap_moved.data() == heap_data);
+	REQUIRE(heap_moved == heap_vec);
+	REQUIRE(heap_copy.empty());
+	REQUIRE(heap_copy.is_inline());
+
+	inline_moved.swap(heap_moved);
+	REQUIRE(inline_moved == heap_vec);
+	REQUIRE(heap_moved == inline_vec);
+
+	heap_moved = inline_moved;
+	REQUIRE(heap_moved == heap_vec);
+
+	inline_moved = std::move(inline_vec);
+	REQUIRE(inline_moved.size() == 2);
+	REQUIRE(inline_moved[1] == "b");
+}
+
+TEST_CASE("Fill constructed small vectors.", "[fill_small_vector]")
+{
+	small_vector<int, 8> zeros(5);
+	REQUIRE(zeros.is_inline());
+	for (int item : zeros)
+		REQUIRE(item == 0);
+
+	small_vector<int, 2> sevens(10, 7);
+	REQUIRE_FALSE(sevens.is_inline());
+	REQUIRE(sevens.size() == 10);
+	for (int item : sevens)
+		REQUIRE(item == 7);
+
+	small_vector<int, 2> other;
+	other.insert(sevens.begin(), sevens.end());
+	REQUIRE(other == sevens);
+}
+
+namespace
+{
+
+struct member_holder
+{
+	int value;
+};
+
+} // namespace
+
+TEST_CASE("Value initialize small vectors of member pointers.", "[small_vector_member_pointer]")
+{
+	small_vector<int member_holder::*, 4> inline_pointers(3);
+	small_vector<int member_holder::*, 2> heap_pointers(5);
+
+	REQUIRE(heap_pointers.size() == 5);
+
+	for (auto pointer : inline_pointers)
+		REQUIRE(pointer == nullptr);
+
+	for (auto pointer : heap_pointers)
+		REQUIRE(pointer == nullptr);
+}
+
+TEST_CASE("Small vector grows by its growth policy.", "[small_vector_growth_policy]")
+{
+	using growth = simple::size_class_growth<>;
+	small_vector<int, 2, growth> vec;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		vec.push_back(i);
+
+		if (!vec.is_inline())
+			REQUIRE(growth::size_class(vec.capacity() * sizeof(int)) ==
+					vec.capacity() * sizeof(int));
+	}
+
+	for (int i = 0; i < 100; ++i)
+		REQUIRE(vec[static_cast<std::size_t>(i)] == i);
+}
@@ -0,0 +1,324 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/my_string.h"
+#include "../src/sort.h"
+#include "../src/vector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using simple::size_type;
+using simple::vector;
+
+namespace
+{
+
+enum class pattern
+{
+	random,
+	sorted,
+	reversed,
+	few_unique,
+	organ_pipe,
+	sorted_with_noise,
+};
+
+template <class T>
+vector<T> make_input(size_type count, pattern shape, unsigned seed)
+{
+	std::mt19937_64 generator(seed);
+	vector<T> values;
+
+	for (size_type i = 0; i < count; ++i)
+	{
+		switch (shape)
+		{
+		case pattern::random:
+			values.push_back(static_cast<T>(generator()));
+			break;
+		case pattern::sorted:
+			values.push_back(static_cast<T>(i));
+			break;
+		case pattern::reversed:
+			values.push_back(static_cast<T>(count - i));
+			break;
+		case pattern::few_unique:
+			values.push_back(static_cast<T>(generator() % 4));
+			break;
+		case pattern::organ_pipe:
+			values.push_back(static_cast<T>(i < count / 2 ? i : count - i));
+			break;
+		case pattern::sorted_with_noise:
+			values.push_back(static_cast<T>(i % 97 == 0 ? generator() % (count + 1) : i));
+			break;
+		default:
+			break;
+		}
+	}
+
+	return values;
+}
+
+template <class T>
+std::vector<T> to_std(const vector<T>& values)
+{
+	return {values.data(), values.data() + values.size()};
+}
+
+constexpr pattern PATTERNS[] = {
+	pattern::random,	 pattern::sorted,	  pattern::reversed,
+	pattern::few_unique, pattern::organ_pipe, pattern::sorted_with_noise,
+};
+
+constexpr size_type SIZES[] = {0, 1, 2, 3, 23, 24, 25, 129, 1000, 50000};
+
+simple::string random_string(std::mt19937& generator, size_type max_length, int alphabet)
+{
+	std::uniform_int_distribution<size_type> length(0, max_length);
+	std::uniform_int_distribution<int> letter(0, alphabet - 1);
+
+	std::string text(length(generator), 'a');
+
+	for (char& c : text)
+		c = static_cast<char>('a' + letter(generator));
+
+	return simple::string(text.c_str(), text.size());
+}
+
+std::string to_std_string(const simple::string& value) { return {value.data(), value.size()}; }
+
+} // namespace
+
+TEST_CASE("Random access iterator comparisons", "[iterator_comparisons]")
+{
+	int values[] = {1, 2};
+	simple::random_access_iterator<int> first(values);
+	simple::random_access_iterator<int> second(values + 1);
+
+	REQUIRE(first < second);
+	REQUIRE(first <= second);
+	REQUIRE(first <= first);
+	REQUIRE_FALSE(first > second);
+	REQUIRE(second > first);
+	REQUIRE(second >= first);
+	REQUIRE(second >= second);
+	REQUIRE_FALSE(first >= second);
+}
+
+TEST_CASE("pdqsort sorts integers in every pattern", "[sort_integers]")
+{
+	for (pattern shape : PATTERNS)
+	{
+		for (size_type count : SIZES)
+		{
+			vector<int> values = make_input<int>(count, shape, static_cast<unsigned>(count));
+			std::vector<int> expected = to_std(values);
+			std::sort(expected.begin(), expected.end());
+
+			simple::sort(values.begin(), values.end());
+			REQUIRE(to_std(values) == expected);
+
+			simple::sort(values.begin(), values.end(), std::greater<>());
+			REQUIRE(std::equal(expected.rbegin(), expected.rend(), values.data()));
+		}
+	}
+}
+
+TEST_CASE("pdqsort with a custom comparator", "[sort_comparator]")
+{
+	// Not one of the branchless comparators, so the branchy partition runs.
+	auto by_last_digit = [](long long lhs, long long rhs) {
+		return lhs % 10 < rhs % 10 || (lhs % 10 == rhs % 10 && lhs < rhs);
+	};
+
+	for (pattern shape : PATTERNS)
+	{
+		vector<long long> values = make_input<long long>(20000, shape, 5);
+
+		for (long long& value : values)
+			value = value < 0 ? -(value + 1) : value;
+
+		std::vector<long long> expected = to_std(values);
+		std::sort(expected.begin(), expected.end(), by_last_digit);
+
+		simple::sort(values.begin(), values.end(), by_last_digit);
+		REQUIRE(to_std(values) == expected);
+	}
+}
+
+TEST_CASE("pdqsort sorts doubles, strings and raw arrays", "[sort_types]")
+{
+	std::mt19937 generator(3);
+	std::uniform_real_distribution<double> real(-1e6, 1e6);
+
+	vector<double> doubles;
+
+	for (int i = 0; i < 10000; ++i)
+		doubles.push_back(real(generator));
+
+	simple::sort(doubles.begin(), doubles.end());
+	REQUIRE(std::is_sorted(doubles.data(), doubles.data() + doubles.size()));
+
+	vector<simple::string> strings;
+	std::vector<std::string> expected;
+
+	for (int i = 0; i < 3000; ++i)
+	{
+		strings.push_back(random_string(generator, 12, 3));
+		expected.push_back(to_std_string(strings.back()));
+	}
+
+	std::sort(expected.begin(), expected.end());
+	simple::sort(strings.begin(), strings.end(),
+				 [](const simple::string& lhs, const simple::string& rhs) {
+					 return to_std_string(lhs) < to_std_string(rhs);
+				 });
+
+	for (size_type i = 0; i < strings.size(); ++i)
+		REQUIRE(to_std_string(strings[i]) == expected[i]);
+
+	int raw[] = {5, 3, 9, 1, 7};
+	simple::sort(raw, raw + 5);
+	REQUIRE(std::is_sorted(raw, raw + 5));
+}
+
+TEST_CASE("pdqsort survives an adversarial comparator count", "[sort_adversarial]")
+{
+	// Sorted runs glued together defeat median-of-three quicksorts; the
+	// comparison count must stay close to n log n.
+	constexpr size_type COUNT = 1 << 16;
+
+	vector<int> values;
+
+	for (size_type i = 0; i < COUNT; ++i)
+		values.push_back(static_cast<int>(i % 2 ? i : COUNT - i));
+
+	size_type comparisons = 0;
+	simple::sort(values.begin(), values.end(), [&comparisons](int lhs, int rhs) {
+		++comparisons;
+		return lhs < rhs;
+	});
+
+	REQUIRE(std::is_sorted(values.data(), values.data() + values.size()));
+	REQUIRE(comparisons < 4 * COUNT * 16);
+}
+
+TEMPLATE_TEST_CASE("LSD radix sort of integers", "[radix_sort_integers]", std::uint8_t,
+				   std::int8_t, std::uint16_t, std::int16_t, std::uint32_t, std::int32_t,
+				   std::uint64_t, std::int64_t)
+{
+	for (pattern shape : PATTERNS)
+	{
+		for (size_type count : SIZES)
+		{
+			vector<TestType> values = make_input<TestType>(count, shape, 17);
+			std::vector<TestType> expected = to_std(values);
+			std::sort(expected.begin(), expected.end());
+
+			simple::radix_sort(values.begin(), values.end());
+			REQUIRE(to_std(values) == expected);
+		}
+	}
+
+	vector<TestType> extremes;
+	extremes.push_back(std::numeric_limits<TestType>::max());
+	extremes.push_back(std::numeric_limits<TestType>::min());
+	extremes.push_back(TestType(0));
+
+	for (int i = 0; i < 100; ++i)
+		extremes.push_back(static_cast<TestType>(i * 37));
+
+	std::vector<TestType> expected = to_std(extremes);
+	std::sort(expected.begin(), expected.end());
+
+	simple::radix_sort(extremes.begin(), extremes.end());
+	REQUIRE(to_std(extremes) == expected);
+}
+
+TEST_CASE("LSD radix sort by key is stable", "[radix_sort_key]")
+{
+	struct record
+	{
+		int key = 0;
+		size_type position = 0;
+	};
+
+	std::mt19937 generator(9);
+	std::uniform_int_distribution<int> key(-50, 50);
+
+	vector<record> records;
+
+	for (size_type i = 0; i < 10000; ++i)
+		records.push_back(record {key(generator), i});
+
+	simple::radix_sort(records.begin(), records.end(), [](const record& r) { return r.key; });
+
+	for (size_type i = 1; i < records.size(); ++i)
+	{
+		REQUIRE(records[i - 1].key <= records[i].key);
+
+		if (records[i - 1].key == records[i].key)
+			REQUIRE(records[i - 1].position < records[i].position);
+	}
+}
+
+TEST_CASE("MSD radix sort of strings", "[radix_sort_strings]")
+{
+	std::mt19937 generator(21);
+
+	for (int alphabet : {1, 2, 26})
+	{
+		for (size_type count : {size_type(0), size_type(1), size_type(63), size_type(5000)})
+		{
+			vector<simple::string> strings;
+			std::vector<std::string> expected;
+
+			for (size_type i = 0; i < count; ++i)
+			{
+				strings.push_back(random_string(generator, 20, alphabet));
+				expected.push_back(to_std_string(strings.back()));
+			}
+
+			// Bytes above 127 sort after ASCII, like memcmp.
+			if (count)
+			{
+				strings.push_back(simple::string("\xff", 1));
+				expected.push_back("\xff");
+				strings.push_back(simple::string("a\0b", 3));
+				expected.push_back(std::string("a\0b", 3));
+			}
+
+			std::sort(expected.begin(), expected.end(),
+					  [](const std::string& lhs, const std::string& rhs) {
+						  int result = std::memcmp(lhs.data(), rhs.data(),
+												   std::min(lhs.size(), rhs.size()));
+						  return result < 0 || (result == 0 && lhs.size() < rhs.size());
+					  });
+
+			simple::radix_sort(strings.begin(), strings.end());
+
+			for (size_type i = 0; i < strings.size(); ++i)
+				REQUIRE(to_std_string(strings[i]) == expected[i]);
+		}
+	}
+}
+
+TEST_CASE("MSD radix sort of strings with long common prefixes", "[radix_sort_string_prefixes]")
+{
+	// Every string is a prefix of the next, which needs one pass per byte.
+	vector<simple::string> strings;
+	std::string prefix(2000, 'x');
+
+	for (size_type i = 2000; i > 0; --i)
+		strings.push_back(simple::string(prefix.c_str(), i));
+
+	simple::radix_sort(strings.begin(), strings.end());
+
+	for (size_type i = 0; i < strings.size(); ++i)
+		REQUIRE(strings[i].size() == i + 1);
+}
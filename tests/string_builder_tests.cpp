@@ -0,0 +1,60 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/string_builder.h"
+
+#include <climits>
+
+using simple::size_type;
+using simple::string;
+using simple::string_builder;
+
+TEST_CASE("Build a string from pieces", "[string_builder]")
+{
+	string host("example.org");
+	string_builder builder;
+
+	builder << "GET /items/" << 1234 << ' ' << host << " status=" << -7 << 'u' << 8u;
+	REQUIRE(builder.size() == 39);
+
+	string line = builder.build();
+	REQUIRE(line == "GET /items/1234 example.org status=-7u8");
+	// Exactly one allocation of exactly the needed size.
+	REQUIRE(line.capacity() == line.size());
+}
+
+TEST_CASE("Builder formats integers and copies temporaries", "[string_builder_copies]")
+{
+	string_builder builder;
+
+	builder.append(LLONG_MIN).append(' ').append(ULLONG_MAX).append(' ').append(short(-3));
+
+	{
+		string temporary("gone soon");
+		builder.append_copy(temporary.data(), temporary.size());
+	}
+
+	REQUIRE(builder.build() == "-9223372036854775808 18446744073709551615 -3gone soon");
+}
+
+TEST_CASE("Builder appends into an existing string", "[string_builder_into]")
+{
+	string_builder builder;
+	REQUIRE(builder.empty());
+	REQUIRE(builder.build().empty());
+
+	string out("prefix:");
+	string piece(40, 'x');
+
+	for (int i = 0; i < 100; ++i)
+		builder.append(piece).append(i);
+
+	builder.build_into(out);
+	REQUIRE(out.size() == 7 + 100 * 40 + 10 + 90 * 2);
+	REQUIRE(out.c_str()[out.size()] == '\0');
+	REQUIRE(std::memcmp(out.data(), "prefix:xxx", 10) == 0);
+	REQUIRE(std::memcmp(out.data() + out.size() - 4, "xx99", 4) == 0);
+
+	builder.clear();
+	REQUIRE(builder.size() == 0);
+	builder << "again";
+	REQUIRE(builder.build() == "again");
+}
@@ -0,0 +1,129 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/string_pool.h"
+
+#include <string>
+#include <thread>
+
+using simple::interned_string;
+using simple::size_type;
+using simple::string;
+using simple::string_pool;
+using simple::string_view;
+
+TEST_CASE("Interning the same characters gives the same handle", "[string_pool_intern]")
+{
+	string_pool pool;
+
+	interned_string first = pool.intern("field_name");
+	interned_string second = pool.intern(string("field_name"));
+	interned_string other = pool.intern("other_field");
+
+	REQUIRE(first == second);
+	REQUIRE(first.c_str() == second.c_str());
+	REQUIRE(first != other);
+	REQUIRE(pool.size() == 2);
+
+	REQUIRE(first.view() == "field_name");
+	REQUIRE(first.size() == 10);
+	REQUIRE(first.c_str()[10] == '\0');
+	REQUIRE(first.hash() == simple::hash<string>()(string("field_name")));
+	REQUIRE(simple::hash<interned_string>()(first) == first.hash());
+
+	REQUIRE(pool[first.id()] == first);
+	REQUIRE(pool[other.id()] == other);
+	REQUIRE(pool.find("other_field") == other);
+	REQUIRE_FALSE(pool.find("missing"));
+	REQUIRE(pool.find("missing").id() == interned_string::NO_ID);
+
+	// A prefix or an embedded null is a different string.
+	REQUIRE(pool.intern("field") != first);
+	REQUIRE(pool.intern(string_view("field_name\0", 11)) != first);
+
+	interned_string empty = pool.intern("");
+	REQUIRE(empty);
+	REQUIRE(empty.empty());
+	REQUIRE(empty == pool.intern(string_view()));
+
+	interned_string none;
+	REQUIRE_FALSE(none);
+	REQUIRE(none.c_str()[0] == '\0');
+	REQUIRE(none != empty);
+}
+
+TEST_CASE("Handles stay valid while the pool grows", "[string_pool_growth]")
+{
+	string_pool pool;
+	simple::vector<interned_string> handles;
+
+	for (int i = 0; i < 50000; ++i)
+	{
+		std::string text = "tag_" + std::to_string(i);
+		handles.push_back(pool.intern(string_view(text.c_str(), text.size())));
+	}
+
+	string large(100000, 'x');
+	interned_string large_handle = pool.intern(large);
+
+	REQUIRE(pool.size() == 50001);
+	REQUIRE(large_handle.view() == large);
+
+	for (int i = 0; i < 50000; ++i)
+	{
+		std::string text = "tag_" + std::to_string(i);
+		string_view view(text.c_str(), text.size());
+		interned_string handle = handles[static_cast<size_type>(i)];
+
+		REQUIRE(handle.view() == view);
+		REQUIRE(pool.intern(view) == handle);
+		REQUIRE(pool[handle.id()] == handle);
+	}
+}
+
+TEST_CASE("Concurrent interning agrees on one copy", "[string_pool_concurrent]")
+{
+	constexpr int THREAD_COUNT = 8;
+	constexpr int DISTINCT = 2000;
+
+	string_pool pool;
+	simple::vector<simple::vector<interned_string>> results(THREAD_COUNT);
+	simple::vector<std::thread> threads;
+
+	for (int t = 0; t < THREAD_COUNT; ++t)
+	{
+		threads.push_back(std::thread([&pool, &results, t]() {
+			auto& handles = results[static_cast<size_type>(t)];
+
+			for (int round = 0; round < 3; ++round)
+			{
+				for (int i = 0; i < DISTINCT; ++i)
+				{
+					// Every thread walks the strings in a different order.
+					int value = (i * 7 + t * 131) % DISTINCT;
+					std::string text = "key_" + std::to_string(value);
+					interned_string handle =
+						pool.intern(string_view(text.c_str(), text.size()));
+
+					if (round == 0)
+						handles.push_back(handle);
+				}
+			}
+		}));
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	REQUIRE(pool.size() == DISTINCT);
+
+	for (int t = 0; t < THREAD_COUNT; ++t)
+	{
+		for (int i = 0; i < DISTINCT; ++i)
+		{
+			int value = (i * 7 + t * 131) % DISTINCT;
+			std::string text = "key_" + std::to_string(value);
+			interned_string handle = results[static_cast<size_type>(t)][static_cast<size_type>(i)];
+
+			REQUIRE(handle == pool.find(string_view(text.c_str(), text.size())));
+		}
+	}
+}
@@ -73,7 +73,11 @@ TEST_CASE("Reserve and capacity", "[reserve_and_capacity]")
 	string x = "nza";
 	x.reserve(19);
 
-	REQUIRE(x.capacity() == 19);
+	REQUIRE(x.capacity() == string::SHORT_CAPACITY);
+	REQUIRE(x == "nza");
+
+	x.reserve(40);
+	REQUIRE(x.capacity() == 40);
 	REQUIRE(x == "nza");
 }
 
@@ -138,3 +142,220 @@ TEST_CASE("string from char* and size", "string_from_char_pointer_and_size")
 
 	REQUIRE(a_str == a);
 }
+
+TEST_CASE("Resize string without initializing", "[resize_uninitialized_string]")
+{
+	string str("ab");
+
+	str.resize_uninitialized(5);
+	REQUIRE(str.size() == 5);
+	REQUIRE(str.capacity() >= 5);
+	std::memcpy(str.data() + 2, "cde", 3);
+	REQUIRE(str == "abcde");
+
+	str.resize_default_init(3);
+	REQUIRE(str.size() == 3);
+	REQUIRE(str == "abc");
+}
+
+TEST_CASE("Resize and overwrite string", "[resize_and_overwrite_string]")
+{
+	string str("id:");
+
+	str.resize_and_overwrite(32, [](char* data, std::size_t count) {
+		REQUIRE(count == 32);
+		REQUIRE(std::memcmp(data, "id:", 3) == 0);
+		std::memcpy(data + 3, "42", 2);
+		return std::size_t(5);
+	});
+
+	REQUIRE(str.size() == 5);
+	REQUIRE(str.capacity() >= 32);
+	REQUIRE(str == "id:42");
+	REQUIRE(str.c_str()[5] == '\0');
+}
+
+TEST_CASE("Shrink string to fit", "[shrink_to_fit_string]")
+{
+	string str("abc");
+	str.reserve(40);
+	REQUIRE(str.capacity() == 40);
+
+	// Short enough to move back inline.
+	str.shrink_to_fit();
+	REQUIRE(str.capacity() == string::SHORT_CAPACITY);
+	REQUIRE(str == "abc");
+
+	str.push_back('d');
+	REQUIRE(str.capacity() == string::SHORT_CAPACITY);
+	REQUIRE(str == "abcd");
+
+	string long_str(30, 'x');
+	long_str.reserve(100);
+	long_str.shrink_to_fit();
+	REQUIRE(long_str.capacity() == 30);
+	REQUIRE(long_str == string(30, 'x'));
+
+	REQUIRE(string::max_size() > str.size());
+}
+
+TEST_CASE("Short strings are stored inline", "[short_string]")
+{
+	static_assert(sizeof(string) == 3 * sizeof(std::size_t));
+	static_assert(simple::is_trivially_relocatable_v<string>);
+
+	string empty;
+	REQUIRE(empty.empty());
+	REQUIRE(empty.c_str()[0] == '\0');
+	REQUIRE(empty.capacity() == string::SHORT_CAPACITY);
+
+	// The characters live inside the object.
+	auto inside = [](const string& str) {
+		auto* object = reinterpret_cast<const char*>(&str);
+		return str.data() >= object && str.data() < object + sizeof(string);
+	};
+
+	REQUIRE(inside(empty));
+
+	string full(string::SHORT_CAPACITY, 'a');
+	REQUIRE(inside(full));
+	REQUIRE(full.size() == string::SHORT_CAPACITY);
+	REQUIRE(full.c_str()[string::SHORT_CAPACITY] == '\0');
+
+	full.push_back('b');
+	REQUIRE(!inside(full));
+	REQUIRE(full.size() == string::SHORT_CAPACITY + 1);
+	REQUIRE(full.back() == 'b');
+	REQUIRE(full.front() == 'a');
+
+	full.pop_back();
+	full.shrink_to_fit();
+	REQUIRE(inside(full));
+	REQUIRE(full == string(string::SHORT_CAPACITY, 'a'));
+}
+
+TEST_CASE("Moves and swaps between short and long strings", "[short_long_string_moves]")
+{
+	string short_str("key");
+	string long_str("a string that does not fit inline");
+
+	string moved_short = std::move(short_str);
+	string moved_long = std::move(long_str);
+
+	REQUIRE(moved_short == "key");
+	REQUIRE(moved_long == "a string that does not fit inline");
+
+	// Moved-from strings are empty and usable.
+	REQUIRE(short_str.empty());
+	REQUIRE(long_str.empty());
+	REQUIRE(long_str == "");
+	long_str.push_back('x');
+	REQUIRE(long_str == "x");
+
+	moved_short.swap(moved_long);
+	REQUIRE(moved_short == "a string that does not fit inline");
+	REQUIRE(moved_long == "key");
+
+	string copy = moved_short;
+	REQUIRE(copy == moved_short);
+	REQUIRE(copy.data() != moved_short.data());
+
+	// Assignment from a shorter C string reuses the heap buffer.
+	copy = "tiny";
+	REQUIRE(copy == "tiny");
+	REQUIRE(copy.size() == 4);
+
+	copy = moved_long;
+	REQUIRE(copy == "key");
+
+	// Assigning part of itself.
+	string self("0123456789012345678901234567890123456789");
+	self = self.c_str() + 30;
+	REQUIRE(self == "0123456789");
+}
+
+TEST_CASE("Append to a string", "[append_string]")
+{
+	string str("key");
+	str.append(":", 1).append(string("value")).append(3, '!');
+	REQUIRE(str == "key:value!!!");
+
+	str += string(" and");
+	str += " more";
+	str += '.';
+	REQUIRE(str == "key:value!!! and more.");
+	REQUIRE(str.size() == 22);
+
+	// Appending past the inline capacity and then from the string itself.
+	str.append(str);
+	REQUIRE(str == "key:value!!! and more.key:value!!! and more.");
+
+	str.append(str.c_str() + 4, 5);
+	REQUIRE(str.size() == 49);
+	REQUIRE(str.back() == 'e');
+
+	string many;
+
+	for (int i = 0; i < 1000; ++i)
+		many.append("0123456789", 10);
+
+	REQUIRE(many.size() == 10000);
+	REQUIRE(many.capacity() < 2 * 10000 + 32);
+	REQUIRE(many[9999] == '9');
+	REQUIRE(many.c_str()[10000] == '\0');
+}
+
+TEST_CASE("Insert into a string", "[insert_string]")
+{
+	string str("ad");
+	str.insert(1, "bc");
+	REQUIRE(str == "abcd");
+
+	str.insert(0, string(">>"));
+	str.insert(str.size(), 2, '<');
+	REQUIRE(str == ">>abcd<<");
+
+	str.insert(4, str);
+	REQUIRE(str == ">>ab>>abcd<<cd<<");
+
+	str.insert(2, "a long piece that does not fit inline ");
+	REQUIRE(str == ">>a long piece that does not fit inline ab>>abcd<<cd<<");
+
+	REQUIRE_THROWS_AS(str.insert(str.size() + 1, "x"), std::out_of_range);
+}
+
+TEST_CASE("Concatenate strings", "[concat_strings]")
+{
+	string key("user");
+	string id("42");
+
+	REQUIRE(key + ":" + id == "user:42");
+	REQUIRE("id=" + id == "id=42");
+	REQUIRE(key + id == "user42");
+	REQUIRE(key + '/' == "user/");
+	REQUIRE(string("a") + 'b' + 'c' == "abc");
+
+	char separator = '|';
+	string joined = simple::concat(key, separator, id, "|", "tail that is long enough to allocate");
+	REQUIRE(joined == "user|42|tail that is long enough to allocate");
+	REQUIRE(joined.capacity() == joined.size());
+
+	REQUIRE(simple::concat().empty());
+	REQUIRE(simple::concat(key) == key);
+}
+
+TEST_CASE("Concatenate only exact chars as characters", "[concat_chars]")
+{
+	static_assert(simple::detail::is_string_piece_v<char>);
+	static_assert(simple::detail::is_string_piece_v<string>);
+	static_assert(simple::detail::is_string_piece_v<const char*>);
+	static_assert(simple::detail::is_string_piece_v<char[4]>);
+
+	// These would bind to a temporary char that dies before it is copied.
+	static_assert(!simple::detail::is_string_piece_v<int>);
+	static_assert(!simple::detail::is_string_piece_v<signed char>);
+	static_assert(!simple::detail::is_string_piece_v<bool>);
+
+	const char letter = 'x';
+	REQUIRE(simple::concat(letter, string("yz"), 'w') == "xyzw");
+}
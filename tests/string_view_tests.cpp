@@ -0,0 +1,183 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/hash_function.h"
+#include "../src/my_string.h"
+#include "../src/string_view.h"
+#include "../src/vector.h"
+#include "../src/views.h"
+
+#include <sstream>
+
+using simple::size_type;
+using simple::string;
+using simple::string_view;
+
+namespace
+{
+
+simple::vector<string> pieces(string_view text, string_view delimiter)
+{
+	simple::vector<string> result;
+
+	for (string_view piece : text.split(delimiter))
+		result.push_back(string(piece));
+
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("Views of strings and C strings", "[string_view_basics]")
+{
+	string owner("hello, world");
+	string_view view = owner;
+
+	REQUIRE(view.data() == owner.data());
+	REQUIRE(view.size() == 12);
+	REQUIRE(view == "hello, world");
+	REQUIRE(view == owner);
+	REQUIRE(owner == view);
+	REQUIRE(view.front() == 'h');
+	REQUIRE(view.back() == 'd');
+	REQUIRE(view[4] == 'o');
+
+	string_view empty;
+	REQUIRE(empty.empty());
+	REQUIRE(empty == "");
+	REQUIRE(empty.substr(0).empty());
+
+	view.remove_prefix(7);
+	view.remove_suffix(1);
+	REQUIRE(view == "worl");
+
+	constexpr string_view literal("abc");
+	static_assert(literal.size() == 3);
+	static_assert(literal[1] == 'b');
+
+	std::ostringstream stream;
+	stream << string_view("a\0b", 3);
+	REQUIRE(stream.str().size() == 3);
+}
+
+TEST_CASE("Substrings share the characters", "[string_view_substr]")
+{
+	string_view text("key=value");
+
+	string_view key = text.substr(0, text.find('='));
+	string_view value = text.substr(text.find('=') + 1);
+
+	REQUIRE(key == "key");
+	REQUIRE(value == "value");
+	REQUIRE(value.data() == text.data() + 4);
+	REQUIRE(text.substr(9).empty());
+	REQUIRE(text.substr(3, 100) == "=value");
+	REQUIRE_THROWS_AS(text.substr(10), std::out_of_range);
+}
+
+TEST_CASE("Find and rfind in a string_view", "[string_view_find]")
+{
+	string_view text("abracadabra");
+	constexpr size_type npos = string_view::npos;
+
+	REQUIRE(text.find('a') == 0);
+	REQUIRE(text.find('a', 1) == 3);
+	REQUIRE(text.find('z') == npos);
+	REQUIRE(text.find('a', 11) == npos);
+
+	REQUIRE(text.find("bra") == 1);
+	REQUIRE(text.find("bra", 2) == 8);
+	REQUIRE(text.find("brax") == npos);
+	REQUIRE(text.find("") == 0);
+	REQUIRE(text.find("", 11) == 11);
+	REQUIRE(text.find("", 12) == npos);
+	REQUIRE(text.find("abracadabra!") == npos);
+
+	REQUIRE(text.rfind('a') == 10);
+	REQUIRE(text.rfind('a', 9) == 7);
+	REQUIRE(text.rfind('c', 3) == npos);
+	REQUIRE(text.rfind("abra") == 7);
+	REQUIRE(text.rfind("abra", 6) == 0);
+	REQUIRE(text.rfind("") == 11);
+	REQUIRE(string_view().rfind('a') == npos);
+	REQUIRE(string_view().find("") == 0);
+}
+
+TEST_CASE("Compare string_views", "[string_view_compare]")
+{
+	string_view text("prefix.body.suffix");
+
+	REQUIRE(text.starts_with("prefix."));
+	REQUIRE(text.starts_with('p'));
+	REQUIRE(text.starts_with(""));
+	REQUIRE_FALSE(text.starts_with("body"));
+	REQUIRE(text.ends_with(".suffix"));
+	REQUIRE(text.ends_with('x'));
+	REQUIRE_FALSE(text.ends_with("prefix.body.suffix!"));
+	REQUIRE_FALSE(string_view().ends_with('x'));
+
+	REQUIRE(string_view("abc").compare("abd") < 0);
+	REQUIRE(string_view("abc").compare("ab") > 0);
+	REQUIRE(string_view("abc").compare("abc") == 0);
+	REQUIRE(string_view("\xff").compare("a") > 0);
+	REQUIRE(string_view("a") < string_view("b"));
+	REQUIRE(string_view("b") >= "a");
+	REQUIRE(string_view("ab") != "abc");
+}
+
+TEST_CASE("Split a string_view lazily", "[string_view_split]")
+{
+	auto fields = pieces("a,b,,c", ",");
+	REQUIRE(fields.size() == 4);
+	REQUIRE(fields[0] == "a");
+	REQUIRE(fields[2] == "");
+	REQUIRE(fields[3] == "c");
+
+	REQUIRE(pieces(",a,", ",").size() == 3);
+	REQUIRE(pieces("", ",").empty());
+	REQUIRE(pieces("no delimiter", ",").size() == 1);
+	REQUIRE(pieces("abc", "").size() == 3);
+
+	auto words = pieces("one -> two -> three", " -> ");
+	REQUIRE(words.size() == 3);
+	REQUIRE(words[1] == "two");
+
+	string line("GET /index.html HTTP/1.1");
+	size_type count = 0;
+
+	for (string_view token : string_view(line).split(' '))
+	{
+		// Every token points into the line, nothing is copied.
+		REQUIRE(token.data() >= line.data());
+		REQUIRE(token.data() + token.size() <= line.data() + line.size());
+		++count;
+	}
+
+	REQUIRE(count == 3);
+
+	auto lengths = string_view("a bb ccc").split(' ') |
+				   simple::views::transform([](string_view token) { return token.size(); }) |
+				   simple::to<simple::vector>();
+	REQUIRE(lengths.size() == 3);
+	REQUIRE(lengths[2] == 3);
+}
+
+TEST_CASE("Strings and views work together", "[string_view_string]")
+{
+	string_view view("a view that is longer than the inline capacity");
+
+	string copy(view);
+	REQUIRE(copy == view);
+	REQUIRE(copy.data() != view.data());
+
+	string str("x");
+	str += string_view("yz");
+	str.append(string_view());
+	str.insert(0, string_view("w"));
+	REQUIRE(str == "wxyz");
+
+	REQUIRE(simple::concat(string_view("key"), '=', str) == "key=wxyz");
+
+	simple::hash<string> string_hash;
+	simple::hash<string_view> view_hash;
+	REQUIRE(string_hash(copy) == view_hash(view));
+	REQUIRE(view_hash(string_view(copy).substr(2, 4)) == string_hash(string("view")));
+}
@@ -3,6 +3,8 @@
 #include "../src/vector.h"
 #include "../src/my_string.h"
 
+#include <initializer_list>
+
 using simple::string;
 using simple::vector;
 
@@ -215,3 +217,398 @@ TEST_CASE("Erase element vector", "[erase_element_vector]")
 
 	REQUIRE(vec_1.empty());
 }
+
+TEST_CASE("Erase trivially copyable element vector", "[erase_trivial_element_vector]")
+{
+	struct point
+	{
+		int x;
+		int y;
+	};
+
+	vector<point> vec;
+	for (int i = 0; i < 5; ++i)
+		vec.push_back({i, -i});
+
+	auto result_it = vec.erase(vec.begin() + 1);
+	REQUIRE(result_it == vec.begin() + 1);
+	REQUIRE(vec.size() == 4);
+
+	REQUIRE(vec[0].x == 0);
+	REQUIRE(vec[1].x == 2);
+	REQUIRE(vec[3].y == -4);
+
+	result_it = vec.erase(vec.begin() + 3);
+	REQUIRE(result_it == vec.end());
+	REQUIRE(vec.size() == 3);
+	REQUIRE(vec.back().x == 3);
+
+	vector<point> vec_copy = vec;
+	REQUIRE(vec_copy.size() == 3);
+	REQUIRE(vec_copy[2].y == -3);
+}
+
+TEST_CASE("Compare vectors", "[compare_vectors]")
+{
+	vector<int> vec_1(3, 7);
+	vector<int> vec_2(3, 7);
+
+	REQUIRE(vec_1 == vec_2);
+
+	vec_2[2] = 8;
+	REQUIRE(vec_1 != vec_2);
+
+	vector<int> empty_1;
+	vector<int> empty_2;
+	REQUIRE(empty_1 == empty_2);
+
+	vector<double> doubles_1(2, 0.0);
+	vector<double> doubles_2(2, -0.0);
+	REQUIRE(doubles_1 == doubles_2);
+
+	vector<string> strings_1(2, "a");
+	vector<string> strings_2(2, "a");
+	REQUIRE(strings_1 == strings_2);
+
+	strings_2.push_back("b");
+	REQUIRE(strings_1 != strings_2);
+}
+
+TEST_CASE("Fill constructed vectors", "[fill_constructed_vectors]")
+{
+	vector<double> zeros(1000);
+	for (double item : zeros)
+		REQUIRE(item == 0.0);
+
+	vector<char> letters(100, 'x');
+	REQUIRE(letters.size() == 100);
+	REQUIRE(letters.front() == 'x');
+	REQUIRE(letters.back() == 'x');
+
+	vector<string> strings(3);
+	REQUIRE(strings.size() == 3);
+	REQUIRE(strings[2].empty());
+
+	vector<string> grown(2, "s");
+	grown.reserve(10);
+	REQUIRE(grown[1] == "s");
+}
+
+namespace
+{
+
+struct self_pointing
+{
+	self_pointing() : self(this) {}
+	self_pointing(const self_pointing& /*other*/) : self(this) {}
+	self_pointing& operator=(const self_pointing& /*other*/) { return *this; }
+
+	self_pointing* self;
+};
+
+struct relocatable_handle
+{
+	explicit relocatable_handle(int value) : data(new int(value)) {}
+	relocatable_handle(relocatable_handle&& other) noexcept :
+		data(std::exchange(other.data, nullptr))
+	{
+	}
+	relocatable_handle(const relocatable_handle& other) = delete;
+	relocatable_handle& operator=(const relocatable_handle& other) = delete;
+	~relocatable_handle() { delete data; }
+
+	int* data;
+};
+
+} // namespace
+
+template <>
+struct simple::is_trivially_relocatable<relocatable_handle> : std::true_type
+{
+};
+
+TEST_CASE("Trivially relocatable trait", "[trivially_relocatable_trait]")
+{
+	STATIC_REQUIRE(simple::is_trivially_relocatable_v<int>);
+	STATIC_REQUIRE(simple::is_trivially_relocatable_v<string>);
+	STATIC_REQUIRE(simple::is_trivially_relocatable_v<vector<string>>);
+	STATIC_REQUIRE(simple::is_trivially_relocatable_v<relocatable_handle>);
+	STATIC_REQUIRE_FALSE(simple::is_trivially_relocatable_v<self_pointing>);
+}
+
+TEST_CASE("Grow vector of relocatable elements", "[grow_relocatable_vector]")
+{
+	vector<string> strings;
+
+	for (int i = 0; i < 1000; ++i)
+		strings.emplace_back(string(static_cast<std::size_t>(i % 50 + 1), 'a'));
+
+	REQUIRE(strings.size() == 1000);
+	for (std::size_t i = 0; i < strings.size(); ++i)
+		REQUIRE(strings[i].size() == i % 50 + 1);
+
+	vector<relocatable_handle> handles;
+
+	for (int i = 0; i < 100; ++i)
+		handles.emplace_back(i);
+
+	handles.erase(handles.begin() + 10);
+
+	REQUIRE(handles.size() == 99);
+	REQUIRE(*handles[9].data == 9);
+	REQUIRE(*handles[10].data == 11);
+	REQUIRE(*handles.back().data == 99);
+}
+
+TEST_CASE("Grow vector of self pointing elements", "[grow_self_pointing_vector]")
+{
+	vector<self_pointing> items;
+
+	for (int i = 0; i < 100; ++i)
+		items.emplace_back();
+
+	for (const auto& item : items)
+		REQUIRE(item.self == &item);
+}
+
+template <class T>
+vector<T> make_vector(std::initializer_list<T> values)
+{
+	vector<T> result;
+	for (const T& value : values)
+		result.push_back(value);
+
+	return result;
+}
+
+TEST_CASE("Insert into vector at position", "[insert_position_vector]")
+{
+	vector<int> vec;
+	for (int i = 0; i < 4; ++i)
+		vec.push_back(i);
+
+	auto result_it = vec.insert(vec.begin() + 2, 10);
+	REQUIRE(result_it == vec.begin() + 2);
+	REQUIRE(vec == make_vector({0, 1, 10, 2, 3}));
+
+	vec.insert(vec.begin(), vec[4]);
+	REQUIRE(vec == make_vector({3, 0, 1, 10, 2, 3}));
+
+	result_it = vec.insert(vec.begin() + 1, 3, 7);
+	REQUIRE(result_it == vec.begin() + 1);
+	REQUIRE(vec == make_vector({3, 7, 7, 7, 0, 1, 10, 2, 3}));
+
+	auto other = make_vector({20, 21});
+	result_it = vec.insert(vec.end(), other.begin(), other.end());
+	REQUIRE(result_it == vec.begin() + 9);
+	REQUIRE(vec.size() == 11);
+	REQUIRE(vec.back() == 21);
+
+	vec.insert(vec.begin(), other.begin(), other.begin());
+	REQUIRE(vec.size() == 11);
+}
+
+TEST_CASE("Emplace strings into vector at position", "[emplace_position_vector]")
+{
+	vector<string> vec;
+	vec.emplace_back("b");
+	vec.emplace_back("d");
+
+	vec.emplace(vec.begin(), "a");
+	vec.emplace(vec.begin() + 2, "c");
+	vec.emplace(vec.end(), "e");
+
+	REQUIRE(vec.size() == 5);
+	REQUIRE(vec[0] == "a");
+	REQUIRE(vec[2] == "c");
+	REQUIRE(vec[4] == "e");
+
+	vec.insert(vec.begin() + 1, vec[4]);
+	REQUIRE(vec[1] == "e");
+	REQUIRE(vec[5] == "e");
+}
+
+TEST_CASE("Insert self pointing elements at position", "[insert_self_pointing_vector]")
+{
+	vector<self_pointing> items;
+
+	for (int i = 0; i < 10; ++i)
+		items.emplace(items.begin());
+
+	items.insert(items.begin() + 5, 20, self_pointing {});
+	REQUIRE(items.size() == 30);
+
+	items.erase(items.begin() + 3, items.begin() + 13);
+	REQUIRE(items.size() == 20);
+
+	for (const auto& item : items)
+		REQUIRE(item.self == &item);
+}
+
+TEST_CASE("Erase range from vector", "[erase_range_vector]")
+{
+	vector<string> vec;
+	for (const char* str : {"0", "1", "2", "3", "4", "5"})
+		vec.emplace_back(str);
+
+	auto result_it = vec.erase(vec.begin() + 1, vec.begin() + 3);
+	REQUIRE(result_it == vec.begin() + 1);
+	REQUIRE(vec.size() == 4);
+	REQUIRE(vec[1] == "3");
+	REQUIRE(vec[3] == "5");
+
+	result_it = vec.erase(vec.begin() + 2, vec.end());
+	REQUIRE(result_it == vec.end());
+	REQUIRE(vec.size() == 2);
+
+	vec.erase(vec.begin(), vec.begin());
+	REQUIRE(vec.size() == 2);
+
+	auto ints = make_vector({0, 1, 2, 3, 4});
+	ints.erase(ints.begin(), ints.begin() + 4);
+	REQUIRE(ints == make_vector({4}));
+}
+
+TEST_CASE("Assign and append ranges to vector", "[assign_append_vector]")
+{
+	auto source = make_vector({1, 2, 3});
+	auto vec = make_vector({9, 9, 9, 9, 9});
+
+	vec.assign(source.begin(), source.end());
+	REQUIRE(vec == source);
+
+	vec.append_range(source.begin() + 1, source.end());
+	REQUIRE(vec == make_vector({1, 2, 3, 2, 3}));
+
+	int raw[] = {7, 8};
+	vec.append_range(raw, raw + 2);
+	REQUIRE(vec.size() == 7);
+	REQUIRE(vec.back() == 8);
+
+	vector<string> strings;
+	strings.emplace_back("x");
+	vector<string> copies;
+	copies.assign(strings.begin(), strings.end());
+	REQUIRE(copies.size() == 1);
+	REQUIRE(copies[0] == "x");
+}
+
+TEST_CASE("Resize vector", "[resize_vector]")
+{
+	auto vec = make_vector({1, 2, 3});
+
+	vec.resize(5);
+	REQUIRE(vec == make_vector({1, 2, 3, 0, 0}));
+
+	vec.resize(2);
+	REQUIRE(vec == make_vector({1, 2}));
+
+	vec.resize(4, 8);
+	REQUIRE(vec == make_vector({1, 2, 8, 8}));
+
+	vector<string> strings;
+	strings.resize(3, string("s"));
+	REQUIRE(strings.size() == 3);
+	REQUIRE(strings[2] == "s");
+
+	strings.resize(1);
+	REQUIRE(strings.size() == 1);
+
+	strings.resize(2);
+	REQUIRE(strings[1].empty());
+}
+
+TEST_CASE("Value-initialize member pointers in vector", "[member_pointer_vector]")
+{
+	struct point
+	{
+		int x;
+		int y;
+	};
+
+	// A null pointer to data member is not all zero bytes on every ABI.
+	vector<int point::*> members(2);
+	REQUIRE(members[0] == nullptr);
+	REQUIRE(members[1] == nullptr);
+
+	members[0] = &point::y;
+	members.resize(4);
+	REQUIRE(members[0] == &point::y);
+	REQUIRE(members[2] == nullptr);
+	REQUIRE(members[3] == nullptr);
+}
+
+TEST_CASE("Resize vector without initializing", "[resize_uninitialized_vector]")
+{
+	vector<char> buffer;
+	buffer.push_back('a');
+
+	buffer.resize_uninitialized(4);
+	REQUIRE(buffer.size() == 4);
+	REQUIRE(buffer[0] == 'a');
+	std::memcpy(buffer.data() + 1, "bcd", 3);
+	REQUIRE(buffer[3] == 'd');
+
+	buffer.resize_default_init(2);
+	REQUIRE(buffer.size() == 2);
+	REQUIRE(buffer[1] == 'b');
+
+	vector<string> strings;
+	strings.resize_default_init(2);
+	REQUIRE(strings.size() == 2);
+	REQUIRE(strings[1].empty());
+}
+
+TEST_CASE("Resize and overwrite vector", "[resize_and_overwrite_vector]")
+{
+	vector<char> buffer;
+	buffer.push_back('>');
+
+	buffer.resize_and_overwrite(64, [](char* data, std::size_t count) {
+		REQUIRE(count == 64);
+		REQUIRE(data[0] == '>');
+		std::memcpy(data + 1, "hello", 5);
+		return std::size_t(6);
+	});
+
+	REQUIRE(buffer.size() == 6);
+	REQUIRE(buffer.capacity() >= 64);
+	REQUIRE(buffer[5] == 'o');
+
+	buffer.resize_and_overwrite(2, [](char* /*data*/, std::size_t count) { return count; });
+	REQUIRE(buffer.size() == 2);
+	REQUIRE(buffer[1] == 'h');
+}
+
+TEST_CASE("Shrink vector to fit", "[shrink_to_fit_vector]")
+{
+	vector<string> vec;
+	vec.reserve(10);
+	vec.emplace_back("a");
+	vec.emplace_back("b");
+
+	vec.shrink_to_fit();
+	REQUIRE(vec.capacity() == 2);
+	REQUIRE(vec[1] == "b");
+
+	vec.shrink_to_fit();
+	REQUIRE(vec.capacity() == 2);
+
+	vec.clear();
+	vec.shrink_to_fit();
+	REQUIRE(vec.capacity() == 0);
+	REQUIRE(vec.empty());
+
+	vec.emplace_back("c");
+	REQUIRE(vec[0] == "c");
+
+	vector<self_pointing> items(5);
+	items.reserve(20);
+	items.shrink_to_fit();
+	REQUIRE(items.capacity() == 5);
+
+	for (const auto& item : items)
+		REQUIRE(item.self == &item);
+
+	REQUIRE(vector<int>::max_size() >= 1000);
+}
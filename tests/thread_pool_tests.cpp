@@ -0,0 +1,247 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/my_string.h"
+#include "../src/thread_pool.h"
+#include "../src/vector.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using simple::future;
+using simple::thread_pool;
+using simple::vector;
+
+namespace
+{
+
+long long fork_join_fibonacci(thread_pool& pool, int n)
+{
+	if (n < 15)
+	{
+		long long a = 0;
+		long long b = 1;
+
+		for (int i = 0; i < n; ++i)
+			b = std::exchange(a, b) + b;
+
+		return a;
+	}
+
+	future<long long> left = pool.submit([&pool, n] { return fork_join_fibonacci(pool, n - 1); });
+	long long right = fork_join_fibonacci(pool, n - 2);
+
+	return left.get() + right;
+}
+
+} // namespace
+
+TEST_CASE("Submit tasks to a thread pool", "[thread_pool_submit]")
+{
+	thread_pool pool(4);
+	REQUIRE(pool.thread_count() == 4);
+
+	future<int> answer = pool.submit([] { return 42; });
+	future<simple::string> text = pool.submit([] { return simple::string("pool"); });
+
+	std::atomic<int> counter {0};
+	future<void> increment = pool.submit([&counter] { ++counter; });
+
+	REQUIRE(answer.valid());
+	REQUIRE(answer.get() == 42);
+	REQUIRE_FALSE(answer.valid());
+
+	REQUIRE(text.get() == "pool");
+
+	increment.wait();
+	REQUIRE(increment.is_ready());
+	increment.get();
+	REQUIRE(counter == 1);
+}
+
+TEST_CASE("Thread pool futures rethrow exceptions", "[thread_pool_exception]")
+{
+	thread_pool pool(2);
+
+	future<int> failing = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+	REQUIRE_THROWS_AS(failing.get(), std::runtime_error);
+
+	REQUIRE_THROWS_AS(pool.parallel_for(0, 100, 1,
+										[](simple::size_type i) {
+											if (i == 57)
+												throw std::logic_error("index 57");
+										}),
+					  std::logic_error);
+
+	REQUIRE(pool.submit([] { return 1; }).get() == 1);
+}
+
+TEST_CASE("Many submits from many threads", "[thread_pool_many_submits]")
+{
+	constexpr int PRODUCERS = 4;
+	constexpr int TASKS = 2000;
+
+	thread_pool pool(4);
+	std::atomic<long long> sum {0};
+
+	std::vector<std::thread> producers;
+	for (int p = 0; p < PRODUCERS; ++p)
+	{
+		producers.emplace_back([&pool, &sum] {
+			vector<future<void>> futures;
+
+			for (int i = 1; i <= TASKS; ++i)
+				futures.push_back(pool.submit([&sum, i] { sum += i; }));
+
+			for (auto& pending : futures)
+				pending.get();
+		});
+	}
+
+	for (auto& producer : producers)
+		producer.join();
+
+	REQUIRE(sum == PRODUCERS * (TASKS * (TASKS + 1LL) / 2));
+}
+
+TEST_CASE("Parallel for visits every index once", "[thread_pool_parallel_for]")
+{
+	thread_pool pool;
+
+	const simple::size_type grains[] = {1, 7, 1000, 100000};
+
+	for (simple::size_type grain : grains)
+	{
+		std::vector<std::atomic<int>> visits(100000);
+
+		pool.parallel_for(0, visits.size(), grain, [&visits](simple::size_type i) { ++visits[i]; });
+
+		for (auto& visit : visits)
+			REQUIRE(visit == 1);
+	}
+
+	bool called = false;
+	pool.parallel_for(5, 5, 1, [&called](simple::size_type) { called = true; });
+	REQUIRE_FALSE(called);
+}
+
+TEST_CASE("Nested fork-join on all cores", "[thread_pool_fork_join]")
+{
+	thread_pool pool;
+
+	REQUIRE(fork_join_fibonacci(pool, 27) == 196418);
+
+	// Parallel loops started from inside tasks run on the calling worker.
+	std::atomic<long long> total {0};
+	pool.parallel_for(0, 64, 1, [&pool, &total](simple::size_type outer) {
+		pool.parallel_for(0, 1000, 16, [&total, outer](simple::size_type inner) {
+			total += static_cast<long long>(outer * inner);
+		});
+	});
+
+	REQUIRE(total == (63 * 64 / 2) * (999 * 1000 / 2));
+}
+
+TEST_CASE("Shutting down a thread pool runs the queued tasks", "[thread_pool_shutdown]")
+{
+	std::atomic<int> finished {0};
+
+	{
+		thread_pool pool(2);
+
+		for (int i = 0; i < 100; ++i)
+		{
+			pool.submit([&finished] {
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+				++finished;
+			});
+		}
+	}
+
+	REQUIRE(finished == 100);
+
+	thread_pool pool(1);
+	pool.shutdown();
+	pool.shutdown();
+	REQUIRE_THROWS_AS(pool.submit([] {}), std::runtime_error);
+}
+
+TEST_CASE("Thread pool futures return references", "[thread_pool_reference]")
+{
+	thread_pool pool(2);
+	int value = 1;
+
+	future<int&> result = pool.submit([&value]() -> int& { return value; });
+	int& reference = result.get();
+
+	REQUIRE(&reference == &value);
+	REQUIRE_FALSE(result.valid());
+}
+
+namespace
+{
+
+// Counts the live instances, to check that a rejected task is released.
+struct counted_task
+{
+	explicit counted_task(std::atomic<int>& t_live) : live(t_live) { ++live; }
+
+	counted_task(counted_task&& other) noexcept : live(other.live) { ++live; }
+
+	counted_task(const counted_task& other) = delete;
+	counted_task& operator=(const counted_task& other) = delete;
+	counted_task& operator=(counted_task&& other) = delete;
+
+	~counted_task() { --live; }
+
+	void operator()() const {}
+
+	std::atomic<int>& live;
+};
+
+} // namespace
+
+TEST_CASE("Submits racing a shutdown either run or throw", "[thread_pool_submit_shutdown]")
+{
+	for (int round = 0; round < 50; ++round)
+	{
+		thread_pool pool(2);
+		std::atomic<int> finished {0};
+		int accepted = 0;
+
+		std::thread submitter([&pool, &finished, &accepted] {
+			vector<future<void>> futures;
+
+			try
+			{
+				while (true)
+				{
+					futures.push_back(pool.submit([&finished] { ++finished; }));
+					++accepted;
+				}
+			}
+
+			catch (const std::runtime_error&)
+			{
+			}
+
+			for (auto& item : futures)
+				item.wait();
+		});
+
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+		pool.shutdown();
+		submitter.join();
+
+		REQUIRE(finished == accepted);
+	}
+
+	std::atomic<int> live {0};
+
+	thread_pool pool(1);
+	pool.shutdown();
+
+	REQUIRE_THROWS_AS(pool.submit(counted_task(live)), std::runtime_error);
+	REQUIRE(live == 0);
+}
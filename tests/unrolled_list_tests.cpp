@@ -0,0 +1,261 @@
+#include "../lib/include/catch2/catch.hpp"
+
+#include "../src/array.h"
+#include "../src/my_string.h"
+#include "../src/unrolled_list.h"
+
+#include <stdexcept>
+
+using simple::string;
+using simple::unrolled_list;
+
+template <class T, simple::size_type N, class... Params>
+void check_unrolled_list(const unrolled_list<T, N>& t_list, Params... t_params)
+{
+	simple::array<T, sizeof...(t_params)> params = {t_params...};
+
+	REQUIRE(t_list.size() == params.size());
+
+	auto list_it = t_list.begin();
+	auto param_it = params.begin();
+
+	for (; list_it != t_list.end(); ++list_it, ++param_it)
+		REQUIRE(*list_it == *param_it);
+
+	list_it = t_list.end();
+	param_it = params.end();
+
+	while (list_it != t_list.begin())
+		REQUIRE(*(--list_it) == *(--param_it));
+}
+
+TEST_CASE("Check if a new unrolled list is empty.", "[empty_unrolled_list]")
+{
+	unrolled_list<string> my_list;
+
+	REQUIRE(my_list.empty());
+	REQUIRE(my_list.begin() == my_list.end());
+}
+
+TEST_CASE("Default unrolled list node spans a few cache lines.", "[unrolled_list_node_size]")
+{
+	REQUIRE(unrolled_list<int>::node_capacity > 16);
+	REQUIRE(sizeof(unrolled_list<int>::node) <= 256);
+}
+
+TEST_CASE("Emplace back and front unrolled list.", "[emplace_back_front_unrolled_list]")
+{
+	unrolled_list<string, 2> my_list;
+
+	my_list.emplace_back("3");
+	my_list.emplace_back("4");
+	my_list.emplace_back("5");
+	my_list.emplace_front("2");
+	my_list.push_front("1");
+
+	REQUIRE(my_list.front() == "1");
+	REQUIRE(my_list.back() == "5");
+
+	check_unrolled_list(my_list, "1", "2", "3", "4", "5");
+}
+
+TEST_CASE("Pop unrolled list.", "[pop_unrolled_list]")
+{
+	unrolled_list<string, 2> my_list;
+
+	for (const char* item : {"1", "2", "3", "4", "5"})
+		my_list.push_back(item);
+
+	my_list.pop_front();
+	check_unrolled_list(my_list, "2", "3", "4", "5");
+
+	my_list.pop_back();
+	check_unrolled_list(my_list, "2", "3", "4");
+
+	my_list.pop_back();
+	my_list.pop_front();
+	check_unrolled_list(my_list, "3");
+
+	my_list.pop_back();
+	REQUIRE(my_list.empty());
+	REQUIRE(my_list.begin() == my_list.end());
+}
+
+TEST_CASE("Emplace in full unrolled list node.", "[emplace_full_unrolled_list]")
+{
+	unrolled_list<int, 4> my_list;
+
+	for (int i : {1, 2, 4, 5})
+		my_list.push_back(i);
+
+	auto it = my_list.emplace(++++my_list.begin(), 3);
+	REQUIRE(*it == 3);
+	check_unrolled_list(my_list, 1, 2, 3, 4, 5);
+
+	it = my_list.insert(my_list.begin(), 0);
+	REQUIRE(*it == 0);
+	check_unrolled_list(my_list, 0, 1, 2, 3, 4, 5);
+
+	it = my_list.insert(my_list.end(), 6);
+	REQUIRE(*it == 6);
+	check_unrolled_list(my_list, 0, 1, 2, 3, 4, 5, 6);
+
+	auto last = my_list.end();
+	--last;
+	it = my_list.emplace(last, 55);
+	REQUIRE(*it == 55);
+	check_unrolled_list(my_list, 0, 1, 2, 3, 4, 5, 55, 6);
+}
+
+TEST_CASE("Erase unrolled list.", "[erase_unrolled_list]")
+{
+	unrolled_list<int, 4> my_list;
+
+	for (int i = 0; i < 10; ++i)
+		my_list.push_back(i);
+
+	auto it = my_list.erase(my_list.begin());
+	REQUIRE(*it == 1);
+	check_unrolled_list(my_list, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+
+	it = my_list.erase(++++++my_list.begin());
+	REQUIRE(*it == 5);
+	check_unrolled_list(my_list, 1, 2, 3, 5, 6, 7, 8, 9);
+
+	it = my_list.erase(it);
+	it = my_list.erase(it);
+	REQUIRE(*it == 7);
+	check_unrolled_list(my_list, 1, 2, 3, 7, 8, 9);
+
+	auto last = my_list.end();
+	it = my_list.erase(--last);
+	REQUIRE(it == my_list.end());
+	check_unrolled_list(my_list, 1, 2, 3, 7, 8);
+
+	while (!my_list.empty())
+		my_list.erase(my_list.begin());
+
+	REQUIRE(my_list.begin() == my_list.end());
+}
+
+TEST_CASE("Unrolled list against reference.", "[unrolled_list_against_reference]")
+{
+	unrolled_list<string, 3> my_list;
+	simple::array<int, 64> expected {};
+	int expected_size = 0;
+
+	for (int i = 0; i < 64; ++i)
+	{
+		auto offset = (i * 7) % (expected_size + 1);
+
+		auto it = my_list.begin();
+		for (int j = 0; j < offset; ++j)
+			++it;
+
+		my_list.insert(it, string(1, static_cast<char>('A' + i % 26)));
+
+		for (int j = expected_size; j > offset; --j)
+			expected[static_cast<std::size_t>(j)] = expected[static_cast<std::size_t>(j - 1)];
+
+		expected[static_cast<std::size_t>(offset)] = 'A' + i % 26;
+		++expected_size;
+	}
+
+	for (int i = 0; i < 40; ++i)
+	{
+		auto offset = (i * 5) % expected_size;
+
+		auto it = my_list.begin();
+		for (int j = 0; j < offset; ++j)
+			++it;
+
+		my_list.erase(it);
+
+		for (int j = offset; j < expected_size - 1; ++j)
+			expected[static_cast<std::size_t>(j)] = expected[static_cast<std::size_t>(j + 1)];
+
+		--expected_size;
+	}
+
+	REQUIRE(my_list.size() == static_cast<std::size_t>(expected_size));
+
+	auto it = my_list.begin();
+	for (int i = 0; i < expected_size; ++i, ++it)
+		REQUIRE((*it)[0] == expected[static_cast<std::size_t>(i)]);
+
+	REQUIRE(it == my_list.end());
+}
+
+TEST_CASE("Move unrolled list.", "[move_unrolled_list]")
+{
+	unrolled_list<string> my_list;
+
+	my_list.push_back("1");
+	my_list.push_back("2");
+
+	unrolled_list<string> other_list(std::move(my_list));
+
+	REQUIRE(my_list.empty());
+	check_unrolled_list(other_list, "1", "2");
+}
+
+TEST_CASE("Insert elements of the same unrolled list.", "[unrolled_list_self_insert]")
+{
+	// Longer than the inline capacity of a string, so that a moved-from
+	// element would read as empty.
+	const string first("the first element, stored on the heap");
+	const string last("the last element, stored on the heap too");
+
+	unrolled_list<string, 4> my_list;
+	my_list.push_back(first);
+	my_list.push_back(last);
+
+	my_list.push_front(my_list.front());
+	check_unrolled_list(my_list, first, first, last);
+
+	my_list.insert(my_list.begin(), my_list.back());
+	check_unrolled_list(my_list, last, first, first, last);
+
+	// The node is full now, so this insert splits it.
+	my_list.insert(++my_list.begin(), my_list.back());
+	check_unrolled_list(my_list, last, last, first, first, last);
+}
+
+namespace
+{
+
+struct throwing_item
+{
+	explicit throwing_item(int t_value) : value(t_value)
+	{
+		if (t_value < 0)
+			throw std::invalid_argument("negative");
+	}
+
+	int value;
+};
+
+} // namespace
+
+TEST_CASE("Throwing constructor leaves the unrolled list unchanged.", "[unrolled_list_throw]")
+{
+	unrolled_list<throwing_item, 2> my_list;
+
+	REQUIRE_THROWS_AS(my_list.emplace_back(-1), std::invalid_argument);
+	REQUIRE(my_list.empty());
+	REQUIRE(my_list.begin() == my_list.end());
+
+	my_list.emplace_back(1);
+	my_list.emplace_back(3);
+
+	REQUIRE_THROWS_AS(my_list.emplace_back(-1), std::invalid_argument);
+	REQUIRE_THROWS_AS(my_list.emplace_front(-1), std::invalid_argument);
+	REQUIRE_THROWS_AS(my_list.emplace(++my_list.begin(), -1), std::invalid_argument);
+
+	my_list.emplace(++my_list.begin(), 2);
+	REQUIRE(my_list.size() == 3);
+
+	int expected = 1;
+	for (const throwing_item& item : my_list)
+		REQUIRE(item.value == expected++);
+}
@@ -0,0 +1,172 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/array.h"
+#include "../src/list.h"
+#include "../src/my_string.h"
+#include "../src/util.h"
+#include "../src/vector.h"
+
+#include <cstdint>
+
+using simple::string;
+using simple::vector;
+
+namespace
+{
+
+enum class color : std::uint16_t
+{
+	red,
+	green,
+	blue
+};
+
+// Fills a vector long enough to cover full vectors and a scalar tail.
+template <class T>
+vector<T> make_sequence(std::size_t size)
+{
+	vector<T> result;
+
+	for (std::size_t i = 0; i < size; ++i)
+		result.push_back(static_cast<T>(i % 100));
+
+	return result;
+}
+
+template <class T>
+void check_find_at_every_position()
+{
+	const std::size_t sizes[] = {0, 1, 15, 16, 17, 31, 32, 33, 70};
+
+	for (std::size_t size : sizes)
+	{
+		vector<T> vec(size, T(1));
+
+		REQUIRE(simple::find(vec.begin(), vec.end(), T(2)) == vec.end());
+		REQUIRE(simple::count(vec.begin(), vec.end(), T(1)) == size);
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			vec[i] = T(2);
+			REQUIRE(simple::find(vec.begin(), vec.end(), T(2)) == vec.begin() + i);
+			REQUIRE(simple::count(vec.begin(), vec.end(), T(2)) == 1);
+			REQUIRE(simple::contains(vec.cbegin(), vec.cend(), T(2)));
+			vec[i] = T(1);
+		}
+	}
+}
+
+} // namespace
+
+TEST_CASE("Find elements of every size", "[find_vectorized]")
+{
+	check_find_at_every_position<std::int8_t>();
+	check_find_at_every_position<std::uint16_t>();
+	check_find_at_every_position<int>();
+	check_find_at_every_position<std::int64_t>();
+}
+
+TEST_CASE("Find with a value of another type", "[find_converted_value]")
+{
+	auto ints = make_sequence<int>(50);
+
+	REQUIRE(simple::find(ints.begin(), ints.end(), 42L) == ints.begin() + 42);
+	REQUIRE(simple::find(ints.begin(), ints.end(), short(42)) == ints.begin() + 42);
+	REQUIRE(simple::find(ints.begin(), ints.end(), 1L << 40) == ints.end());
+
+	vector<unsigned long> longs(40, 7UL);
+	longs.push_back(1UL << 40);
+	REQUIRE(simple::find(longs.begin(), longs.end(), 7U) == longs.begin());
+	REQUIRE(simple::find(longs.begin(), longs.end(), 1UL << 40) == longs.begin() + 40);
+
+	vector<std::uint8_t> bytes(40, 1);
+	REQUIRE(simple::find(bytes.begin(), bytes.end(), 257) == bytes.end());
+
+	vector<double> doubles(20, 0.5);
+	doubles.push_back(-0.0);
+	REQUIRE(simple::find(doubles.begin(), doubles.end(), 0.0) == doubles.begin() + 20);
+}
+
+TEST_CASE("Find in strings, arrays and lists", "[find_containers]")
+{
+	string str("the quick brown fox jumps over the lazy dog");
+	REQUIRE(simple::find(str.begin(), str.end(), 'z') == str.begin() + 37);
+	REQUIRE(simple::count(str.begin(), str.end(), 'o') == 4);
+	REQUIRE_FALSE(simple::contains(str.begin(), str.end(), '!'));
+
+	simple::array<color, 20> colors {};
+	colors[17] = color::blue;
+	REQUIRE(simple::find(colors.begin(), colors.end(), color::blue) == colors.begin() + 17);
+	REQUIRE(simple::count(colors.begin(), colors.end(), color::red) == 19);
+
+	int a = 1;
+	int b = 2;
+	vector<int*> pointers(30, &a);
+	pointers[29] = &b;
+	REQUIRE(simple::find(pointers.begin(), pointers.end(), &b) == pointers.begin() + 29);
+
+	simple::list<int> list;
+	for (int i = 0; i < 5; ++i)
+		list.push_back(i);
+
+	REQUIRE(*simple::find(list.begin(), list.end(), 3) == 3);
+	REQUIRE(simple::count(list.begin(), list.end(), 3) == 1);
+}
+
+TEST_CASE("Mismatch and equal ranges", "[mismatch_equal]")
+{
+	const std::size_t sizes[] = {1, 8, 16, 33, 100};
+
+	for (std::size_t size : sizes)
+	{
+		auto first = make_sequence<std::int64_t>(size);
+		auto second = first;
+
+		auto result = simple::mismatch(first.begin(), first.end(), second.begin());
+		REQUIRE(result.first == first.end());
+		REQUIRE(simple::equal(first.begin(), first.end(), second.begin()));
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			// Only the highest byte differs.
+			second[i] += std::int64_t(1) << 56;
+
+			result = simple::mismatch(first.begin(), first.end(), second.begin());
+			REQUIRE(result.first == first.begin() + i);
+			REQUIRE(result.second == second.begin() + i);
+			REQUIRE_FALSE(simple::equal(first.begin(), first.end(), second.begin()));
+
+			second[i] = first[i];
+		}
+	}
+
+	string lhs("abcdef");
+	string rhs("abcxef");
+	REQUIRE(simple::mismatch(lhs.begin(), lhs.end(), rhs.begin()).first == lhs.begin() + 3);
+
+	vector<string> words;
+	words.emplace_back("a");
+	words.emplace_back("b");
+	vector<string> same_words = words;
+	REQUIRE(simple::equal(words.begin(), words.end(), same_words.begin()));
+
+	vector<int> empty;
+	REQUIRE(simple::equal(empty.begin(), empty.end(), empty.begin()));
+	REQUIRE(simple::mismatch(empty.begin(), empty.end(), empty.begin()).first == empty.end());
+}
+
+TEST_CASE("Algorithms run in constant expressions", "[util_constexpr]")
+{
+	constexpr static int numbers[] = {1, 2, 3, 2};
+	constexpr static int same[] = {1, 2, 3, 2};
+	constexpr static int other[] = {1, 2, 4, 2};
+
+	static_assert(simple::find(numbers, numbers + 4, 2) == numbers + 1);
+	static_assert(simple::find(numbers, numbers + 4, 5) == numbers + 4);
+	static_assert(simple::count(numbers, numbers + 4, 2) == 2);
+	static_assert(simple::contains(numbers, numbers + 4, 3));
+	static_assert(simple::mismatch(numbers, numbers + 4, other).first == numbers + 2);
+	static_assert(simple::equal(numbers, numbers + 4, same));
+	static_assert(!simple::equal(numbers, numbers + 4, other));
+
+	REQUIRE(simple::find(numbers, numbers + 4, 3) == numbers + 2);
+}
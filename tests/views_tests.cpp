@@ -0,0 +1,221 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/list.h"
+#include "../src/my_string.h"
+#include "../src/unordered_map.h"
+#include "../src/vector.h"
+#include "../src/views.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <numeric>
+#include <type_traits>
+
+using simple::size_type;
+using simple::vector;
+
+namespace views = simple::views;
+
+namespace
+{
+
+vector<int> iota_vector(int count)
+{
+	vector<int> values(static_cast<size_type>(count));
+	std::iota(values.begin(), values.end(), 0);
+	return values;
+}
+
+template <class T>
+vector<T> vector_of(std::initializer_list<T> items)
+{
+	vector<T> values;
+
+	for (const T& item : items)
+		values.push_back(item);
+
+	return values;
+}
+
+bool is_even(int value) { return value % 2 == 0; }
+
+} // namespace
+
+TEST_CASE("Filter, transform and take fused in one pass", "[views_pipeline]")
+{
+	vector<int> values = iota_vector(100);
+	int predicate_calls = 0;
+	int transform_calls = 0;
+
+	auto pipeline = values | views::filter([&](int value) {
+						++predicate_calls;
+						return is_even(value);
+					}) |
+					views::transform([&](int value) {
+						++transform_calls;
+						return value * value;
+					}) |
+					views::take(3);
+
+	// Nothing runs until the view is iterated.
+	REQUIRE(predicate_calls == 0);
+
+	vector<int> squares = pipeline | simple::to<vector>();
+
+	REQUIRE(squares.size() == 3);
+	REQUIRE(squares[0] == 0);
+	REQUIRE(squares[1] == 4);
+	REQUIRE(squares[2] == 16);
+	REQUIRE(transform_calls == 3);
+	// Only the elements up to the third match were looked at.
+	REQUIRE(predicate_calls == 5);
+}
+
+TEST_CASE("Views refer to lvalues and own rvalues", "[views_ownership]")
+{
+	vector<int> values = iota_vector(5);
+	auto doubled = values | views::transform([](int value) { return value * 2; });
+
+	values[0] = 10;
+	REQUIRE(*doubled.begin() == 20);
+	REQUIRE(doubled.size() == 5);
+
+	auto owned = iota_vector(4) | views::transform([](int value) { return value + 1; });
+	REQUIRE(simple::to<vector<int>>(owned) == vector_of<int>({1, 2, 3, 4}));
+
+	// Transforming to references writes through.
+	for (int& value : values | views::transform([](int& value) -> int& { return value; }))
+		value = -value;
+
+	REQUIRE(values[4] == -4);
+}
+
+TEST_CASE("Adaptors compose before they see a range", "[views_composition]")
+{
+	auto odd_squares = views::filter([](int value) { return !is_even(value); }) |
+					   views::transform([](int value) { return value * value; });
+
+	vector<int> values = iota_vector(8);
+	REQUIRE(simple::to<vector>(values | odd_squares) == vector_of<int>({1, 9, 25, 49}));
+
+	auto tail = views::drop(2) | views::take(3);
+	REQUIRE(simple::to<vector>(values | tail) == vector_of<int>({2, 3, 4}));
+	REQUIRE((values | tail).size() == 3);
+}
+
+TEST_CASE("Take and drop past the end", "[views_take_drop]")
+{
+	vector<int> values = iota_vector(4);
+
+	REQUIRE(simple::to<vector>(values | views::take(10)).size() == 4);
+	REQUIRE((values | views::take(10)).size() == 4);
+	REQUIRE(simple::to<vector>(values | views::take(0)).empty());
+	REQUIRE(simple::to<vector>(values | views::drop(10)).empty());
+	REQUIRE((values | views::drop(10)).size() == 0);
+
+	// Forward iterators are advanced one by one and also stop at the end.
+	simple::list<int> list;
+
+	for (int i = 0; i < 5; ++i)
+		list.push_back(i);
+
+	REQUIRE(simple::to<vector>(list | views::drop(3)) == vector_of<int>({3, 4}));
+	REQUIRE(simple::to<vector>(list | views::drop(7)).empty());
+
+	simple::list<int> copied = list | views::take(2) | simple::to<simple::list>();
+	REQUIRE(copied.size() == 2);
+	REQUIRE(copied.back() == 1);
+}
+
+TEST_CASE("Enumerate pairs elements with their index", "[views_enumerate]")
+{
+	vector<char> letters;
+
+	for (char c : {'a', 'b', 'c'})
+		letters.push_back(c);
+
+	size_type expected_index = 0;
+
+	for (auto [index, letter] : letters | views::enumerate)
+	{
+		REQUIRE(index == expected_index);
+		REQUIRE(letter == 'a' + static_cast<int>(index));
+		++expected_index;
+	}
+
+	REQUIRE(expected_index == 3);
+
+	for (auto [index, letter] : letters | views::enumerate)
+		letter = static_cast<char>(letter + static_cast<int>(index));
+
+	REQUIRE(letters[2] == 'e');
+	REQUIRE(simple::to<vector>(letters | views::enumerate | views::keys) ==
+			vector_of<size_type>({0, 1, 2}));
+}
+
+TEST_CASE("Zip stops at the shorter range", "[views_zip]")
+{
+	vector<int> numbers = iota_vector(5);
+	vector<simple::string> names;
+	names.push_back(simple::string("zero"));
+	names.push_back(simple::string("one"));
+	names.push_back(simple::string("two"));
+
+	auto zipped = views::zip(numbers, names);
+	REQUIRE(zipped.size() == 3);
+
+	size_type count = 0;
+
+	for (auto [number, name] : zipped)
+	{
+		REQUIRE(&name == &names[static_cast<size_type>(number)]);
+		++count;
+	}
+
+	REQUIRE(count == 3);
+
+	auto lengths = views::zip(numbers, names) | views::values |
+				   views::transform([](const simple::string& name) { return name.size(); });
+	REQUIRE(simple::to<vector>(lengths) == vector_of<size_type>({4, 3, 3}));
+}
+
+TEST_CASE("Chunk splits into fixed size subranges", "[views_chunk]")
+{
+	vector<int> values = iota_vector(7);
+	auto chunks = values | views::chunk(3);
+
+	REQUIRE(chunks.size() == 3);
+
+	vector<int> sums;
+
+	for (auto chunk : chunks)
+		sums.push_back(std::accumulate(chunk.begin(), chunk.end(), 0));
+
+	REQUIRE(sums == vector_of<int>({3, 12, 6}));
+
+	REQUIRE((iota_vector(6) | views::chunk(3)).size() == 2);
+	auto no_chunks = vector<int>() | views::chunk(3);
+	REQUIRE(no_chunks.begin() == no_chunks.end());
+}
+
+TEST_CASE("Keys and values of an unordered_map", "[views_keys_values]")
+{
+	simple::unordered_map<int, simple::string> map(8);
+	map.try_emplace(1, "one");
+	map.try_emplace(2, "two");
+	map.try_emplace(3, "three");
+
+	vector<int> keys = map | views::keys | simple::to<vector>();
+	std::sort(keys.begin(), keys.end());
+	REQUIRE(keys == vector_of<int>({1, 2, 3}));
+
+	static_assert(std::is_same_v<decltype(*(map | views::values).begin()), simple::string&>);
+
+	for (simple::string& value : map | views::values)
+		value = simple::string("x");
+
+	REQUIRE(*map[2] == "x");
+
+	auto long_keys = map | views::filter([](const auto& item) { return item.first > 1; }) |
+					 views::keys | simple::to<vector>();
+	REQUIRE(long_keys.size() == 2);
+}
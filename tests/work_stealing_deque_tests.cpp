@@ -0,0 +1,100 @@
+#include "../lib/include/catch2/catch.hpp"
+#include "../src/vector.h"
+#include "../src/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using simple::work_stealing_deque;
+
+TEST_CASE("Owner pops and thieves steal from opposite ends", "[work_stealing_deque_ends]")
+{
+	work_stealing_deque<int> deque;
+	REQUIRE(deque.empty());
+
+	for (int i = 0; i < 5; ++i)
+		deque.push(i);
+
+	int value = -1;
+
+	REQUIRE(deque.pop(value));
+	REQUIRE(value == 4);
+
+	REQUIRE(deque.steal(value));
+	REQUIRE(value == 0);
+
+	REQUIRE(deque.pop(value));
+	REQUIRE(value == 3);
+
+	REQUIRE(deque.steal(value));
+	REQUIRE(value == 1);
+
+	REQUIRE(deque.pop(value));
+	REQUIRE(value == 2);
+
+	REQUIRE_FALSE(deque.pop(value));
+	REQUIRE_FALSE(deque.steal(value));
+	REQUIRE(deque.empty());
+}
+
+TEST_CASE("Work stealing deque grows", "[work_stealing_deque_grow]")
+{
+	work_stealing_deque<int> deque;
+
+	int count = static_cast<int>(work_stealing_deque<int>::INITIAL_CAPACITY) * 5;
+	for (int i = 0; i < count; ++i)
+		deque.push(i);
+
+	REQUIRE(deque.capacity() >= static_cast<std::size_t>(count));
+
+	int value = -1;
+	for (int i = 0; i < count; ++i)
+	{
+		REQUIRE(deque.steal(value));
+		REQUIRE(value == i);
+	}
+}
+
+TEST_CASE("Every element is taken exactly once under contention", "[work_stealing_deque_race]")
+{
+	constexpr int ITEMS = 200000;
+	constexpr int THIEVES = 3;
+
+	work_stealing_deque<int> deque;
+	std::vector<std::atomic<int>> taken(ITEMS);
+	std::atomic<bool> done {false};
+
+	simple::vector<std::thread> thieves;
+	for (int i = 0; i < THIEVES; ++i)
+	{
+		thieves.emplace_back([&]() noexcept {
+			int value = 0;
+
+			while (!done.load())
+			{
+				if (deque.steal(value))
+					taken[static_cast<std::size_t>(value)].fetch_add(1);
+			}
+		});
+	}
+
+	int value = 0;
+	for (int i = 0; i < ITEMS; ++i)
+	{
+		deque.push(i);
+
+		if (i % 3 == 0 && deque.pop(value))
+			taken[static_cast<std::size_t>(value)].fetch_add(1);
+	}
+
+	while (deque.pop(value))
+		taken[static_cast<std::size_t>(value)].fetch_add(1);
+
+	done = true;
+	for (auto& thief : thieves)
+		thief.join();
+
+	for (std::size_t i = 0; i < ITEMS; ++i)
+		REQUIRE(taken[i].load() == 1);
+}